@@ -0,0 +1,63 @@
+/*
+ * Copyright 2021 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkImage.h"
+#include "include/utils/SkAnimCodecPlayer.h"
+#include "src/utils/SkOSPath.h"
+#include "tools/Resources.h"
+
+// Decodes every frame of an animated resource image with SkAnimCodecPlayer::DecodeFrames, with
+// runs of dependent frames spread across a pool of 1 (i.e. sequential) or 4 threads.
+class AnimCodecDecodeBench : public Benchmark {
+public:
+    AnimCodecDecodeBench(const char* path, int threads) : fPath(path), fThreads(threads) {
+        SkString name = SkOSPath::Basename(path);
+        fName.printf("anim_decode_frames_%s_%dthreads", name.c_str(), threads);
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+
+    void onDelayedSetup() override {
+        fData = GetResourceAsData(fPath);
+        // No borrowing, so the waiting thread doesn't add to the pool's parallelism.
+        fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads, false);
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        if (!fData) {
+            return;
+        }
+        for (int i = 0; i < loops; ++i) {
+            SkAnimCodecPlayer::DecodeFrames(fData, [](int, sk_sp<SkImage>) {}, fExecutor.get());
+        }
+    }
+
+private:
+    const char*                 fPath;
+    const int                   fThreads;
+    SkString                    fName;
+    sk_sp<SkData>               fData;
+    std::unique_ptr<SkExecutor> fExecutor;
+
+    using INHERITED = Benchmark;
+};
+
+#define DEF_ANIM_DECODE_BENCH(path)                                 \
+    DEF_BENCH(return new AnimCodecDecodeBench(path, 1);)            \
+    DEF_BENCH(return new AnimCodecDecodeBench(path, 4);)
+
+DEF_ANIM_DECODE_BENCH("images/alphabetAnim.gif")
+DEF_ANIM_DECODE_BENCH("images/flightAnim.gif")
+DEF_ANIM_DECODE_BENCH("images/test640x479.gif")
+DEF_ANIM_DECODE_BENCH("images/required.webp")
+DEF_ANIM_DECODE_BENCH("images/stoplight.webp")
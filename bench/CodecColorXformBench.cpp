@@ -0,0 +1,81 @@
+/*
+ * Copyright 2021 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/codec/SkCodec.h"
+#include "include/core/SkBitmap.h"
+#include "include/core/SkColorSpace.h"
+#include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
+#include "tools/Resources.h"
+
+// Decodes images with embedded (mostly wide-gamut) ICC profiles to sRGB, so every row goes
+// through the codec's color transform. "_xform_thread" hands those transforms to a second
+// thread while the codec decodes the next rows.
+class CodecColorXformBench : public Benchmark {
+public:
+    CodecColorXformBench(const char* name, const char* path, SkColorType colorType,
+                         bool xformThread)
+            : fPath(path), fColorType(colorType), fXformThread(xformThread) {
+        fName.printf("codec_color_xform_%s_%s%s", name,
+                     colorType == kRGBA_F16_SkColorType ? "f16" : "8888",
+                     xformThread ? "_xform_thread" : "");
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+
+    void onDelayedSetup() override {
+        fData = GetResourceAsData(fPath);
+        if (fXformThread) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool(1);
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        if (!fData) {
+            return;
+        }
+        SkCodec::Options options;
+        options.fColorXformExecutor = fExecutor.get();
+        for (int i = 0; i < loops; ++i) {
+            std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(fData);
+            SkImageInfo info = codec->getInfo().makeColorType(fColorType)
+                                               .makeAlphaType(kPremul_SkAlphaType)
+                                               .makeColorSpace(SkColorSpace::MakeSRGB());
+            if (fPixels.info() != info) {
+                fPixels.allocPixels(info);
+            }
+            codec->getPixels(info, fPixels.getPixels(), fPixels.rowBytes(), &options);
+        }
+    }
+
+private:
+    const char*                 fPath;
+    const SkColorType           fColorType;
+    const bool                  fXformThread;
+    SkString                    fName;
+    sk_sp<SkData>               fData;
+    std::unique_ptr<SkExecutor> fExecutor;
+    SkBitmap                    fPixels;
+
+    using INHERITED = Benchmark;
+};
+
+#define DEF_CODEC_COLOR_XFORM_BENCH(name, path)                                            \
+    DEF_BENCH(return new CodecColorXformBench(#name, path, kN32_SkColorType, false);)      \
+    DEF_BENCH(return new CodecColorXformBench(#name, path, kN32_SkColorType, true);)       \
+    DEF_BENCH(return new CodecColorXformBench(#name, path, kRGBA_F16_SkColorType, false);) \
+    DEF_BENCH(return new CodecColorXformBench(#name, path, kRGBA_F16_SkColorType, true);)
+
+DEF_CODEC_COLOR_XFORM_BENCH(webp_lossy,    "images/webp-color-profile-lossy.webp")
+DEF_CODEC_COLOR_XFORM_BENCH(webp_lossless, "images/webp-color-profile-lossless.webp")
+DEF_CODEC_COLOR_XFORM_BENCH(jpeg_gbr,      "images/icc-v2-gbr.jpg")
+DEF_CODEC_COLOR_XFORM_BENCH(jpeg_wide,     "images/wide_gamut_yellow_224_224_64.jpeg")
+DEF_CODEC_COLOR_XFORM_BENCH(png_wide,      "images/wide-gamut.png")
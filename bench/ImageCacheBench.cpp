@@ -6,7 +6,10 @@
  */
 
 #include "bench/Benchmark.h"
+#include "include/core/SkExecutor.h"
+#include "include/private/SkMutex.h"
 #include "src/core/SkResourceCache.h"
+#include "src/core/SkTaskGroup.h"
 
 namespace {
 static void* gGlobalAddress;
@@ -72,6 +75,75 @@ private:
     using INHERITED = Benchmark;
 };
 
+// Several threads at once looking up keys that hit, as raster threads do when drawing the same
+// images. "sharded" goes through the global cache; "mutex" puts a single SkResourceCache behind
+// a single lock, which is how the global cache used to work.
+class ImageCacheThreadsBench : public Benchmark {
+    enum {
+        CACHE_COUNT = 500
+    };
+
+    const int  fThreads;
+    const bool fSharded;
+    SkString   fName;
+
+    SkResourceCache             fCache;
+    SkMutex                     fMutex;
+    std::unique_ptr<SkExecutor> fExecutor;
+
+public:
+    ImageCacheThreadsBench(int threads, bool sharded)
+        : fThreads(threads), fSharded(sharded), fCache(CACHE_COUNT * 100) {
+        fName.printf("imagecache_%dthreads_%s", threads, sharded ? "sharded" : "mutex");
+    }
+
+protected:
+    bool isSuitableFor(Backend backend) override {
+        return kNonRendering_Backend == backend;
+    }
+
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads);
+    }
+
+    void onPreDraw(SkCanvas*) override {
+        // Other benches may have purged the global cache since the last run.
+        for (int i = 0; i < CACHE_COUNT; ++i) {
+            if (fSharded) {
+                SkResourceCache::Add(new TestRec(TestKey(i), i));
+            } else {
+                fCache.add(new TestRec(TestKey(i), i));
+            }
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkTaskGroup(*fExecutor).batch(fThreads, [&](int thread) {
+            for (int i = 0; i < loops; ++i) {
+                TestKey key((thread * 97 + i) % CACHE_COUNT);
+                if (fSharded) {
+                    SkResourceCache::Find(key, TestRec::Visitor, nullptr);
+                } else {
+                    SkAutoMutexExclusive lock(fMutex);
+                    fCache.find(key, TestRec::Visitor, nullptr);
+                }
+            }
+        });
+    }
+
+private:
+    using INHERITED = Benchmark;
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 
 DEF_BENCH( return new ImageCacheBench(); )
+
+DEF_BENCH( return new ImageCacheThreadsBench(1, false); )
+DEF_BENCH( return new ImageCacheThreadsBench(1, true); )
+DEF_BENCH( return new ImageCacheThreadsBench(4, false); )
+DEF_BENCH( return new ImageCacheThreadsBench(4, true); )
+DEF_BENCH( return new ImageCacheThreadsBench(8, false); )
+DEF_BENCH( return new ImageCacheThreadsBench(8, true); )
@@ -8,7 +8,12 @@
 #include "bench/Benchmark.h"
 #include "include/core/SkData.h"
 #include "include/core/SkStream.h"
+#include "include/core/SkString.h"
+#include "include/utils/SkRandom.h"
 #include "src/utils/SkJSON.h"
+#include "tools/ProcStats.h"
+
+#include <memory>
 
 #if defined(SK_BUILD_FOR_ANDROID)
 static constexpr const char* kBenchFile = "/data/local/tmp/bench.json";
@@ -55,6 +60,145 @@ private:
 
 DEF_BENCH( return new JsonBench; )
 
+namespace {
+
+// Synthesizes a large Lottie-like document: lots of small keyframe records, plus a few
+// embedded (b64 data URI) image payloads -- the bulk of the size for many real-world files.
+sk_sp<SkData> make_large_json() {
+    static constexpr int kLayerCount    = 2000,
+                         kKeyframeCount = 32,
+                         kAssetCount    = 8;
+    static constexpr size_t kAssetSize  = 512 * 1024;
+
+    static constexpr char kB64Chars[] =
+            "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    SkRandom rand;
+    SkDynamicMemoryWStream stream;
+
+    stream.writeText(R"({"v":"5.5.2","fr":60,"ip":0,"op":600,"w":1024,"h":1024,"assets":[)");
+    for (int i = 0; i < kAssetCount; ++i) {
+        stream.writeText(SkStringPrintf(R"(%s{"id":"image_%d","w":512,"h":512,"u":"",)"
+                                        R"("p":"data:image/png;base64,)",
+                                        i ? "," : "", i).c_str());
+        for (size_t j = 0; j < kAssetSize; ++j) {
+            stream.write8(kB64Chars[rand.nextULessThan(64)]);
+        }
+        stream.writeText(R"("})");
+    }
+    stream.writeText(R"(],"layers":[)");
+    for (int i = 0; i < kLayerCount; ++i) {
+        stream.writeText(SkStringPrintf(R"(%s{"ty":4,"nm":"Layer %d","ip":0,"op":600,"st":0,)"
+                                        R"("ks":{"p":{"a":1,"k":[)",
+                                        i ? "," : "", i).c_str());
+        for (int k = 0; k < kKeyframeCount; ++k) {
+            stream.writeText(SkStringPrintf(R"(%s{"t":%d,"s":[%.3f,%.3f],)"
+                                            R"("i":{"x":[0.667],"y":[1]},"o":{"x":[0.333],"y":[0]}})",
+                                            k ? "," : "", k * 10,
+                                            rand.nextRangeF(0, 1024),
+                                            rand.nextRangeF(0, 1024)).c_str());
+        }
+        stream.writeText("]}}}");
+    }
+    stream.writeText("]}");
+
+    return stream.detachAsData();
+}
+
+// Counts values without retaining anything.
+class CountingVisitor final : public skjson::Visitor {
+public:
+    size_t count() const { return fCount; }
+
+private:
+    void onBeginObject()                override { fCount++; }
+    void onBeginArray()                 override { fCount++; }
+    void onString(const char[], size_t) override { fCount++; }
+    void onInt32(int32_t)               override { fCount++; }
+    void onFloat(float)                 override { fCount++; }
+    void onBool(bool)                   override { fCount++; }
+    void onNull()                       override { fCount++; }
+
+    size_t fCount = 0;
+};
+
+} // namespace
+
+// Parses a large synthetic document, either into a DOM or via the streaming Visitor interface.
+// After timing, also reports (once per bench) how much resident memory one parse holds.
+class JsonLargeBench : public Benchmark {
+public:
+    explicit JsonLargeBench(bool streaming)
+        : fStreaming(streaming)
+        , fName(streaming ? "json_skjson_large_visitor" : "json_skjson_large_dom") {}
+
+protected:
+    const char* onGetName() override { return fName; }
+
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+
+    void onDelayedSetup() override {
+        fData = make_large_json();
+    }
+
+    void onPerCanvasPostDraw(SkCanvas*) override {
+        if (fReportedMemory) {
+            return;
+        }
+        fReportedMemory = true;
+
+        // The DOM must stay alive while sampling RSS.
+        const auto rss_before = sk_tools::getCurrResidentSetSizeBytes();
+        std::unique_ptr<skjson::DOM> dom;
+        if (fStreaming) {
+            this->parseStreaming();
+        } else {
+            dom = std::make_unique<skjson::DOM>(static_cast<const char*>(fData->data()),
+                                                fData->size());
+        }
+        const auto rss_after = sk_tools::getCurrResidentSetSizeBytes();
+
+        if (rss_before >= 0 && rss_after >= 0) {
+            SkDebugf("%s: input %zu KB, parse memory %lld KB\n",
+                     fName, fData->size() >> 10,
+                     static_cast<long long>(rss_after - rss_before) >> 10);
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; i++) {
+            if (fStreaming) {
+                if (!this->parseStreaming()) {
+                    SkDebugf("!! Parsing failed.\n");
+                    return;
+                }
+            } else {
+                skjson::DOM dom(static_cast<const char*>(fData->data()), fData->size());
+                if (dom.root().is<skjson::NullValue>()) {
+                    SkDebugf("!! Parsing failed.\n");
+                    return;
+                }
+            }
+        }
+    }
+
+private:
+    bool parseStreaming() const {
+        CountingVisitor visitor;
+        return skjson::Parse(static_cast<const char*>(fData->data()), fData->size(), &visitor);
+    }
+
+    const bool        fStreaming;
+    const char*       fName;
+    sk_sp<SkData>     fData;
+    bool              fReportedMemory = false;
+
+    using INHERITED = Benchmark;
+};
+
+DEF_BENCH( return new JsonLargeBench(false); )
+DEF_BENCH( return new JsonLargeBench(true);  )
+
 #if (0)
 
 #include "rapidjson/document.h"
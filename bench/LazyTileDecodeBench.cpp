@@ -0,0 +1,82 @@
+/*
+ * Copyright 2021 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkData.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkImageEncoder.h"
+#include "include/core/SkShader.h"
+#include "include/effects/SkGradientShader.h"
+
+// Pans a small viewport across part of a large encoded image, starting from a cold cache each
+// time. With tiled decoding, only the tiles under the viewport are decoded; "_full" decodes the
+// whole image up front, as every lazy image draw used to.
+class LazyTileDecodeBench : public Benchmark {
+public:
+    LazyTileDecodeBench(SkEncodedImageFormat format, bool tiled)
+            : fFormat(format), fTiled(tiled) {
+        fName.printf("lazy_tile_decode_%s%s",
+                     format == SkEncodedImageFormat::kJPEG ? "jpeg" : "png",
+                     tiled ? "" : "_full");
+    }
+
+protected:
+    static constexpr int kImageSize = 4096;
+    static constexpr int kViewSize  = 256;
+    static constexpr int kSteps     = 8;
+
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override { return backend == kRaster_Backend; }
+
+    SkIPoint onGetSize() override { return {kViewSize, kViewSize}; }
+
+    void onDelayedSetup() override {
+        SkBitmap bitmap;
+        bitmap.allocN32Pixels(kImageSize, kImageSize, true);
+        SkCanvas canvas(bitmap);
+        const SkPoint pts[] = {{0, 0}, {kImageSize, kImageSize}};
+        const SkColor colors[] = {SK_ColorRED, SK_ColorGREEN, SK_ColorBLUE};
+        SkPaint paint;
+        paint.setShader(SkGradientShader::MakeLinear(pts, colors, nullptr, SK_ARRAY_COUNT(colors),
+                                                     SkTileMode::kMirror));
+        canvas.drawPaint(paint);
+        fEncoded = SkEncodeBitmap(bitmap, fFormat, 90);
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        const SkSamplingOptions sampling(SkFilterMode::kLinear);
+        for (int i = 0; i < loops; ++i) {
+            // A fresh image has a fresh unique ID, so nothing is found in the cache.
+            sk_sp<SkImage> image = SkImage::MakeFromEncoded(fEncoded);
+            if (!fTiled) {
+                image = image->makeRasterImage();
+            }
+            for (int step = 0; step < kSteps; ++step) {
+                SkRect src = SkRect::MakeXYWH(kImageSize / 2 + step * kViewSize / 2,
+                                              kImageSize / 2, kViewSize, kViewSize);
+                canvas->drawImageRect(image, src, SkRect::MakeWH(kViewSize, kViewSize), sampling,
+                                      nullptr, SkCanvas::kFast_SrcRectConstraint);
+            }
+        }
+    }
+
+private:
+    const SkEncodedImageFormat fFormat;
+    const bool                 fTiled;
+    SkString                   fName;
+    sk_sp<SkData>              fEncoded;
+
+    using INHERITED = Benchmark;
+};
+
+DEF_BENCH(return new LazyTileDecodeBench(SkEncodedImageFormat::kJPEG, true);)
+DEF_BENCH(return new LazyTileDecodeBench(SkEncodedImageFormat::kJPEG, false);)
+DEF_BENCH(return new LazyTileDecodeBench(SkEncodedImageFormat::kPNG, true);)
+DEF_BENCH(return new LazyTileDecodeBench(SkEncodedImageFormat::kPNG, false);)
@@ -0,0 +1,99 @@
+/*
+ * Copyright 2021 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+
+#if !defined(SK_BUILD_FOR_GOOGLE3)  // Google3 doesn't build particles module
+
+#include "include/core/SkCanvas.h"
+#include "modules/particles/include/SkParticleDrawable.h"
+#include "modules/particles/include/SkParticleEffect.h"
+
+namespace {
+
+// A steady-state effect with ~100k live particles: a constant emission rate, randomized lifetimes
+// (so particles die in a scattered order), and per-particle motion and color in the update script.
+static constexpr char kCode[] = R"(
+    void effectSpawn(inout Effect effect) {
+      effect.lifetime = 1000;
+      effect.rate = 50000;
+    }
+
+    void spawn(inout Particle p) {
+      p.lifetime = mix(1, 3, rand(p.seed));
+      float a = radians(rand(p.seed) * 360);
+      p.vel = float2(cos(a), sin(a)) * mix(50, 150, rand(p.seed));
+      p.spin = rand(p.seed) < 0.5 ? 0 : 3.14;
+    }
+
+    void update(inout Particle p) {
+      p.color = float4(1 - p.age, rand(p.seed), p.age, 1 - p.age);
+      p.scale = mix(1, 3, p.age);
+    }
+)";
+
+class ParticleBench : public Benchmark {
+public:
+    ParticleBench(bool draw) : fDraw(draw) {}
+
+protected:
+    const char* onGetName() override {
+        return fDraw ? "particles_draw_100k" : "particles_update_100k";
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return fDraw ? backend != kNonRendering_Backend : backend == kNonRendering_Backend;
+    }
+
+    SkIPoint onGetSize() override { return { 512, 512 }; }
+
+    void onDelayedSetup() override {
+        SkParticleEffect::RegisterParticleTypes();
+
+        auto params = sk_make_sp<SkParticleEffectParams>();
+        params->fMaxCount = 100000;
+        params->fDrawable = SkParticleDrawable::MakeCircle(2);
+        params->fCode = kCode;
+        params->prepare(nullptr);
+
+        fEffect = sk_make_sp<SkParticleEffect>(params);
+        fEffect->start(/*now=*/0.0, /*looping=*/false);
+
+        // Run long enough to reach the particle limit, with particles dying every frame.
+        for (fTime = 0; fTime < 4.0; fTime += kFrameTime) {
+            fEffect->update(fTime);
+        }
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        while (loops-- > 0) {
+            if (fDraw) {
+                canvas->save();
+                canvas->translate(256, 256);
+                fEffect->draw(canvas);
+                canvas->restore();
+            } else {
+                fTime += kFrameTime;
+                fEffect->update(fTime);
+            }
+        }
+    }
+
+private:
+    static constexpr double kFrameTime = 1.0 / 60;
+
+    const bool              fDraw;
+    sk_sp<SkParticleEffect> fEffect;
+    double                  fTime = 0;
+};
+
+}  // namespace
+
+DEF_BENCH(return new ParticleBench(false);)
+DEF_BENCH(return new ParticleBench(true);)
+
+#endif  // !defined(SK_BUILD_FOR_GOOGLE3)
@@ -61,6 +61,61 @@ DEF_BENCH( return new ReadPixBench(kBGRA_8888_SkColorType, kUnpremul_SkAlphaType
 DEF_BENCH( return new ReadPixBench(kBGRA_8888_SkColorType, kPremul_SkAlphaType, SkColorSpace::MakeSRGB()); )
 DEF_BENCH( return new ReadPixBench(kBGRA_8888_SkColorType, kUnpremul_SkAlphaType, SkColorSpace::MakeSRGB()); )
 
+////////////////////////////////////////////////////////////////////////////////
+#include "tools/ToolUtils.h"
+
+// Time SkPixmap::readPixels() between color types, the readback path for non-8888 surfaces.
+// The large size is split into bands by SkConvertPixels() when there is a default executor.
+class ConvertPixelsBench : public Benchmark {
+public:
+    ConvertPixelsBench(SkColorType srcCT, SkColorType dstCT, SkAlphaType at, int w, int h)
+        : fSrcInfo(SkImageInfo::Make(w, h, srcCT, at))
+        , fDstInfo(SkImageInfo::Make(w, h, dstCT, at)) {
+        fName.printf("convertpix_%s_to_%s_%s_%dx%d",
+                     ToolUtils::colortype_name(srcCT), ToolUtils::colortype_name(dstCT),
+                     at == kPremul_SkAlphaType ? "pm" : "um", w, h);
+    }
+
+protected:
+    void onDelayedSetup() override {
+        fSrc.allocPixels(fSrcInfo);
+        fSrc.eraseColor(0x80402010);
+        fDst.allocPixels(fDstInfo);
+    }
+
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; ++i) {
+            fSrc.readPixels(fDst.pixmap());
+        }
+    }
+
+private:
+    SkImageInfo fSrcInfo, fDstInfo;
+    SkBitmap    fSrc, fDst;
+    SkString    fName;
+
+    using INHERITED = Benchmark;
+};
+
+#define CONVERT_PIX_BENCHES(src, dst, at)                                                   \
+    DEF_BENCH( return new ConvertPixelsBench(src, dst, at,  512,  512); )                   \
+    DEF_BENCH( return new ConvertPixelsBench(src, dst, at, 4096, 2048); )
+
+CONVERT_PIX_BENCHES(kRGBA_F16_SkColorType,     kRGBA_8888_SkColorType, kPremul_SkAlphaType)
+CONVERT_PIX_BENCHES(kRGBA_F16_SkColorType,     kBGRA_8888_SkColorType, kUnpremul_SkAlphaType)
+CONVERT_PIX_BENCHES(kRGB_565_SkColorType,      kBGRA_8888_SkColorType, kPremul_SkAlphaType)
+CONVERT_PIX_BENCHES(kRGBA_1010102_SkColorType, kRGBA_8888_SkColorType, kPremul_SkAlphaType)
+
+#undef CONVERT_PIX_BENCHES
+
 ////////////////////////////////////////////////////////////////////////////////
 #include "include/core/SkBitmap.h"
 #include "src/core/SkPixmapPriv.h"
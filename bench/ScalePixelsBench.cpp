@@ -0,0 +1,70 @@
+/*
+ * Copyright 2021 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkBitmap.h"
+#include "include/core/SkPixmap.h"
+#include "include/core/SkSamplingOptions.h"
+#include "include/core/SkString.h"
+
+// Time SkPixmap::scalePixels() downscaling a large photo-sized source by common ratios,
+// as a thumbnailer would.
+class ScalePixelsBench : public Benchmark {
+public:
+    ScalePixelsBench(int divisor, SkSamplingOptions sampling, const char* samplingName)
+        : fDivisor(divisor), fSampling(sampling) {
+        fName.printf("scalepixels_%s_div%d", samplingName, divisor);
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    void onDelayedSetup() override {
+        fSrc.allocPixels(SkImageInfo::MakeN32Premul(4000, 3000));
+        for (int y = 0; y < fSrc.height(); ++y) {
+            for (int x = 0; x < fSrc.width(); ++x) {
+                *fSrc.getAddr32(x, y) = SkPreMultiplyARGB(0xFF, x & 0xFF, y & 0xFF,
+                                                          (x ^ y) & 0xFF);
+            }
+        }
+        fDst.allocPixels(SkImageInfo::MakeN32Premul(fSrc.width()  / fDivisor,
+                                                    fSrc.height() / fDivisor));
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; ++i) {
+            fSrc.pixmap().scalePixels(fDst.pixmap(), fSampling);
+        }
+    }
+
+private:
+    int               fDivisor;
+    SkSamplingOptions fSampling;
+    SkString          fName;
+    SkBitmap          fSrc, fDst;
+
+    using INHERITED = Benchmark;
+};
+
+DEF_BENCH( return new ScalePixelsBench( 2, SkSamplingOptions(SkCubicResampler::Mitchell()),
+                                        "mitchell"); )
+DEF_BENCH( return new ScalePixelsBench( 4, SkSamplingOptions(SkCubicResampler::Mitchell()),
+                                        "mitchell"); )
+DEF_BENCH( return new ScalePixelsBench( 8, SkSamplingOptions(SkCubicResampler::Mitchell()),
+                                        "mitchell"); )
+DEF_BENCH( return new ScalePixelsBench(16, SkSamplingOptions(SkCubicResampler::Mitchell()),
+                                        "mitchell"); )
+DEF_BENCH( return new ScalePixelsBench( 4, SkSamplingOptions(SkCubicResampler::CatmullRom()),
+                                        "catmullrom"); )
+DEF_BENCH( return new ScalePixelsBench( 4, SkSamplingOptions(SkFilterMode::kLinear),
+                                        "linear"); )
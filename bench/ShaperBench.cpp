@@ -5,10 +5,15 @@
 
 #if !defined(SK_BUILD_FOR_ANDROID_FRAMEWORK) && !defined(SK_BUILD_FOR_GOOGLE3)
 
+#include "include/core/SkExecutor.h"
+#include "include/core/SkString.h"
 #include "modules/skshaper/include/SkShaper.h"
+#include "src/core/SkTaskGroup.h"
 #include "tools/Resources.h"
 
 #include <cfloat>
+#include <memory>
+#include <vector>
 
 namespace {
 struct ShaperBench : public Benchmark {
@@ -35,8 +40,56 @@ struct ShaperBench : public Benchmark {
         }
     }
 };
+
+// Shapes the same text on N threads at once, one shaper per thread (shapers are not
+// thread safe, but the HarfBuzz face cache they share is).
+struct ShaperThreadsBench : public Benchmark {
+    ShaperThreadsBench(const char* r, int threads)
+        : fResource(r)
+        , fThreads(threads)
+        , fName(SkStringPrintf("shaper_english_%dthreads", threads)) {}
+
+    const char* onGetName() override { return fName.c_str(); }
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+    void onDelayedSetup() override {
+        fData = GetResourceAsData(fResource);
+        fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads);
+        for (int i = 0; i < fThreads; ++i) {
+            fShapers.push_back(SkShaper::Make());
+        }
+    }
+    void onDraw(int loops, SkCanvas*) override {
+        if (!fData || !fShapers.front()) { return; }
+        const char* text = (const char*)fData->data();
+        size_t len = fData->size();
+
+        SkTaskGroup tg(*fExecutor);
+        while (loops-- > 0) {
+            tg.batch(fThreads, [&](int i) {
+                SkFont font;
+                SkTextBlobBuilderRunHandler rh(text, {0, 0});
+                fShapers[i]->shape(text, len, font, true, FLT_MAX, &rh);
+                (void)rh.makeBlob();
+            });
+            tg.wait();
+        }
+    }
+
+private:
+    const char*                            fResource;
+    const int                              fThreads;
+    const SkString                         fName;
+    sk_sp<SkData>                          fData;
+    std::unique_ptr<SkExecutor>            fExecutor;
+    std::vector<std::unique_ptr<SkShaper>> fShapers;
+};
 }  // namespace
 
+DEF_BENCH(return new ShaperThreadsBench("text/english.txt", 1);)
+DEF_BENCH(return new ShaperThreadsBench("text/english.txt", 2);)
+DEF_BENCH(return new ShaperThreadsBench("text/english.txt", 4);)
+DEF_BENCH(return new ShaperThreadsBench("text/english.txt", 8);)
+
 #define SHAPER_BENCH(X) DEF_BENCH(return new ShaperBench("text/" #X ".txt", "shaper_" #X);)
 SHAPER_BENCH(arabic)
 SHAPER_BENCH(armenian)
@@ -8,6 +8,7 @@
 #include "bench/ResultsWriter.h"
 #include "bench/SkSLBench.h"
 #include "include/core/SkCanvas.h"
+#include "include/effects/SkRuntimeEffect.h"
 #include "src/gpu/GrCaps.h"
 #include "src/gpu/GrRecordingContextPriv.h"
 #include "src/gpu/mock/GrMockCaps.h"
@@ -16,9 +17,50 @@
 #include "src/sksl/SkSLParser.h"
 
 class SkSLCompilerStartupBench : public Benchmark {
+public:
+    SkSLCompilerStartupBench(SkSL::Compiler::ModuleSharing sharing)
+        : fName(sharing == SkSL::Compiler::ModuleSharing::kShared
+                        ? "sksl_compiler_startup"
+                        : "sksl_compiler_startup_private_modules")
+        , fSharing(sharing) {}
+
+protected:
+    const char* onGetName() override {
+        return fName;
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        GrShaderCaps caps(GrContextOptions{});
+        for (int i = 0; i < loops; i++) {
+            SkSL::Compiler compiler(&caps, fSharing);
+        }
+    }
+
+private:
+    const char* fName;
+    SkSL::Compiler::ModuleSharing fSharing;
+};
+
+DEF_BENCH(return new SkSLCompilerStartupBench(SkSL::Compiler::ModuleSharing::kShared);)
+DEF_BENCH(return new SkSLCompilerStartupBench(SkSL::Compiler::ModuleSharing::kPrivate);)
+
+// Measures the latency of the first program compiled by a new Compiler, which is where a Compiler
+// with private modules pays for rehydrating sksl_gpu and sksl_frag.
+class SkSLFirstCompileBench : public Benchmark {
+public:
+    SkSLFirstCompileBench(SkSL::Compiler::ModuleSharing sharing)
+        : fName(sharing == SkSL::Compiler::ModuleSharing::kShared
+                        ? "sksl_first_compile"
+                        : "sksl_first_compile_private_modules")
+        , fSharing(sharing) {}
+
 protected:
     const char* onGetName() override {
-        return "sksl_compiler_startup";
+        return fName;
     }
 
     bool isSuitableFor(Backend backend) override {
@@ -27,13 +69,82 @@ protected:
 
     void onDraw(int loops, SkCanvas*) override {
         GrShaderCaps caps(GrContextOptions{});
+        SkSL::Program::Settings settings;
         for (int i = 0; i < loops; i++) {
-            SkSL::Compiler compiler(&caps);
+            SkSL::Compiler compiler(&caps, fSharing);
+            std::unique_ptr<SkSL::Program> program = compiler.convertProgram(
+                    SkSL::ProgramKind::kFragment,
+                    "void main() { sk_FragColor = half4(1, 0, 0, 1); }",
+                    settings);
+            if (!program) {
+                SK_ABORT("shader compilation failed: %s\n", compiler.errorText().c_str());
+            }
         }
     }
+
+private:
+    const char* fName;
+    SkSL::Compiler::ModuleSharing fSharing;
+};
+
+DEF_BENCH(return new SkSLFirstCompileBench(SkSL::Compiler::ModuleSharing::kShared);)
+DEF_BENCH(return new SkSLFirstCompileBench(SkSL::Compiler::ModuleSharing::kPrivate);)
+
+// Creates 500 distinct runtime effects. "Cold" purges the effect cache first, so every effect is
+// compiled; "warm" finds all of them in the cache.
+class SkRuntimeEffectCacheBench : public Benchmark {
+public:
+    SkRuntimeEffectCacheBench(bool warm)
+        : fName(warm ? "sksl_runtime_effect_cache_warm" : "sksl_runtime_effect_cache_cold")
+        , fWarm(warm) {}
+
+protected:
+    static constexpr int kEffectCount = 500;
+
+    const char* onGetName() override {
+        return fName;
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    void onDelayedSetup() override {
+        for (int i = 0; i < kEffectCount; ++i) {
+            fSources.push_back(SkStringPrintf(
+                    "uniform half4 color;"
+                    "half4 main(float2 p) { return color * half(%d) * half(p.x < %d); }", i, i));
+        }
+        if (fWarm) {
+            this->makeAll();
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; i++) {
+            if (!fWarm) {
+                SkRuntimeEffect::PurgeCache();
+            }
+            this->makeAll();
+        }
+    }
+
+private:
+    void makeAll() {
+        for (const SkString& source : fSources) {
+            if (!SkRuntimeEffect::Make(source).effect) {
+                SK_ABORT("runtime effect failed to compile: %s\n", source.c_str());
+            }
+        }
+    }
+
+    const char* fName;
+    bool fWarm;
+    std::vector<SkString> fSources;
 };
 
-DEF_BENCH(return new SkSLCompilerStartupBench();)
+DEF_BENCH(return new SkRuntimeEffectCacheBench(/*warm=*/false);)
+DEF_BENCH(return new SkRuntimeEffectCacheBench(/*warm=*/true);)
 
 enum class Output {
     kNone,
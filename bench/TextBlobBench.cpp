@@ -91,6 +91,40 @@ class TextBlobFirstTimeBench : public SkTextBlobBench {
 };
 DEF_BENCH( return new TextBlobFirstTimeBench(); )
 
+/*
+ * Draws many distinct SkTextBlobs that all hold the same text. Blobs are built up front, so this
+ * only measures how well the GPU text blob cache copes with text that repeats across blobs (run
+ * with --textBlobContentKeys to key the cache by content).
+ */
+class TextBlobSameContentBench : public SkTextBlobBench {
+    const char* onGetName() override {
+        return "TextBlobSameContentBench";
+    }
+
+    void onDelayedSetup() override {
+        this->INHERITED::onDelayedSetup();
+        for (int i = 0; i < kBlobCount; i++) {
+            fBlobs[i] = this->makeBlob();
+        }
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        SkPaint paint;
+
+        for (int i = 0; i < loops; i++) {
+            for (const sk_sp<SkTextBlob>& blob : fBlobs) {
+                canvas->drawTextBlob(blob, 0, 0, paint);
+            }
+        }
+    }
+
+    static constexpr int kBlobCount = 100;
+    sk_sp<SkTextBlob> fBlobs[kBlobCount];
+
+    using INHERITED = SkTextBlobBench;
+};
+DEF_BENCH( return new TextBlobSameContentBench(); )
+
 class TextBlobMakeBench : public SkTextBlobBench {
     const char* onGetName() override {
         return "TextBlobMakeBench";
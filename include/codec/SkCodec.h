@@ -27,10 +27,12 @@
 class SkAndroidCodec;
 class SkColorSpace;
 class SkData;
+class SkExecutor;
 class SkFrameHolder;
 class SkImage;
 class SkPngChunkReader;
 class SkSampler;
+class SkTaskGroup;
 
 namespace DM {
 class CodecSrc;
@@ -289,6 +291,7 @@ public:
             , fSubset(nullptr)
             , fFrameIndex(0)
             , fPriorFrame(kNoFrame)
+            , fColorXformExecutor(nullptr)
         {}
 
         ZeroInitialized            fZeroInitialized;
@@ -332,6 +335,16 @@ public:
          *  If set to kNoFrame, the codec will decode any necessary required frame(s) first.
          */
         int                        fPriorFrame;
+
+        /**
+         *  If not NULL, and the decode needs a color transform, blocks of decoded rows may be
+         *  color transformed by tasks on this executor while the codec decodes the next rows.
+         *  getPixels() still returns only once every row has been transformed.
+         *
+         *  Currently used by getPixels() for WEBP, and for JPEG when the rows can be
+         *  transformed in place.
+         */
+        SkExecutor*                fColorXformExecutor;
     };
 
     /**
@@ -845,6 +858,11 @@ protected:
     // - WBMP is just Black/White
     virtual bool usesColorXform() const { return true; }
     void applyColorXform(void* dst, const void* src, int count) const;
+    // Color transforms a block of rows. If taskGroup is not null, the block is transformed by a
+    // task in that group, so the caller must keep src and dst alive and untouched until it has
+    // waited on the group.
+    void applyColorXformRows(void* dst, size_t dstRowBytes, const void* src, size_t srcRowBytes,
+                             int width, int rows, SkTaskGroup* taskGroup) const;
 
     bool colorXform() const { return fXformTime != kNo_XformTime; }
     bool xformOnDecode() const { return fXformTime == kDecodeRow_XformTime; }
@@ -87,6 +87,28 @@ public:
         return this->getPixels(pm.info(), pm.writable_addr(), pm.rowBytes());
     }
 
+    /**
+     *  Returns the size closest to desiredScale at which getPixels() can decode natively, e.g.
+     *  using a codec's DCT scaling. Passing that size to getPixels() is then cheaper than a full
+     *  size decode. The result may be smaller than desiredScale asks for.
+     *
+     *  Only downscales are supported: if desiredScale is not in (0, 1), or the generator cannot
+     *  decode at a smaller size, this returns the full dimensions from getInfo().
+     */
+    SkISize getScaledDimensions(float desiredScale) const;
+
+    /**
+     *  Decodes only the pixels in subset, which must be non-empty and inside the bounds of
+     *  getInfo(), into dst, whose dimensions must match subset's.
+     *
+     *  Repeated calls should give the same pixels as the matching region of getPixels() with
+     *  dst's info at full size.
+     *
+     *  @return true on success. Returns false if the arguments are invalid, or if the generator
+     *          cannot decode a region without decoding the whole image.
+     */
+    bool getSubsetPixels(const SkIRect& subset, const SkPixmap& dst);
+
     /**
      *  If decoding to YUV is supported, this returns true. Otherwise, this
      *  returns false and the caller will ignore output parameter yuvaPixmapInfo.
@@ -177,6 +199,10 @@ protected:
     virtual bool onQueryYUVAInfo(const SkYUVAPixmapInfo::SupportedDataTypes&,
                                  SkYUVAPixmapInfo*) const { return false; }
     virtual bool onGetYUVAPlanes(const SkYUVAPixmaps&) { return false; }
+    // Called with desiredScale in (0, 1). The default only decodes at full size.
+    virtual SkISize onGetScaledDimensions(float desiredScale) const { return fInfo.dimensions(); }
+    // Called with a valid subset and a dst of the same size. The default can't decode subsets.
+    virtual bool onGetSubsetPixels(const SkIRect& subset, const SkPixmap& dst) { return false; }
 #if SK_SUPPORT_GPU
     // returns nullptr
     virtual GrSurfaceProxyView onGenerateTexture(GrRecordingContext*, const SkImageInfo&,
@@ -87,6 +87,14 @@ public:
     // https://bugs.llvm.org/show_bug.cgi?id=36684
     static Result Make(SkString sksl) { return Make(std::move(sksl), Options{}); }
 
+    // Make() caches the effects it creates (keyed by source and options), so making the same
+    // effect again is cheap. The cache is budgeted by the approximate memory held by its effects.
+    // SetCacheByteLimit returns the previous limit, and purges down to a lower limit immediately.
+    static size_t GetCacheByteLimit();
+    static size_t SetCacheByteLimit(size_t newLimit);
+    static size_t GetCacheBytesUsed();
+    static void PurgeCache();
+
     sk_sp<SkShader> makeShader(sk_sp<SkData> uniforms,
                                sk_sp<SkShader> children[],
                                size_t childCount,
@@ -154,6 +154,15 @@ struct SK_API GrContextOptions {
      */
     size_t fGlyphCacheTextureMaximumBytes = 2048 * 1024 * 4;
 
+    /**
+     * If true, the text blob cache is keyed by the content of the text (fonts, glyphs and
+     * positions) instead of by SkTextBlob identity. Identical text drawn from different
+     * SkTextBlobs, or drawn without an SkTextBlob at all, then shares cached sub-runs. This costs
+     * a hash of the glyph data on every text draw, so it only pays off for workloads that draw
+     * the same text repeatedly from freshly built blobs.
+     */
+    bool fTextBlobCacheUsesContentKeys = false;
+
     /**
      * Below this threshold size in device space distance field fonts won't be used. Distance field
      * fonts don't support hinting which is more important at smaller sizes.
@@ -234,7 +243,8 @@ struct SK_API GrContextOptions {
 
     /**
      * If present, use this object to report shader compilation failures. If not, report failures
-     * via SkDebugf and assert.
+     * via SkDebugf and assert. It is only called on the context's thread: failures found while
+     * precompiling shaders on fExecutor are reported when the context finishes those shaders.
      */
     ShaderErrorHandler* fShaderErrorHandler = nullptr;
 
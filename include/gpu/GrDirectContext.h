@@ -31,6 +31,7 @@ class GrResourceCache;
 class GrSmallPathAtlasMgr;
 class GrSurfaceDrawContext;
 class GrResourceProvider;
+class GrShaderPrecompiler;
 class GrStrikeCache;
 class GrSurfaceProxy;
 class GrSwizzle;
@@ -786,6 +787,26 @@ public:
     // Using cached shader blobs on a different device or driver are undefined.
     bool precompileShader(const SkData& key, const SkData& data);
 
+    // Asynchronous variant of precompileShader. The SkSL in 'data' is parsed and translated on
+    // GrContextOptions::fExecutor (or immediately, if there is no executor), and any work that
+    // needs the 3D API (e.g. linking a GL program) is deferred until finishPrecompiledShaders is
+    // called on the context's thread. Backends that can't split precompilation simply do all of
+    // the work in finishPrecompiledShaders.
+    void precompileShaderAsync(sk_sp<SkData> key, sk_sp<SkData> data);
+
+    // Completes any asynchronous precompiles whose translation has finished, optionally blocking
+    // until all outstanding translations are done. Returns the number that succeeded in this call.
+    int finishPrecompiledShaders(bool waitForAll = false);
+
+    struct PrecompileStats {
+        int fPending = 0;    // submitted but not yet completed by finishPrecompiledShaders
+        int fSucceeded = 0;
+        int fFailed = 0;
+    };
+
+    // Progress of precompileShaderAsync requests made so far.
+    PrecompileStats precompileStats() const;
+
 #ifdef SK_ENABLE_DUMP_GPU
     /** Returns a string with detailed information about the context & GPU, in JSON format. */
     SkString dump() const;
@@ -841,6 +862,10 @@ private:
 
     std::unique_ptr<GrSmallPathAtlasMgr> fSmallPathAtlasMgr;
 
+    // Created on the first call to precompileShaderAsync. It runs translations on fTaskGroup, and
+    // since they use fGpu, it waits for them in its destructor.
+    std::unique_ptr<GrShaderPrecompiler> fShaderPrecompiler;
+
     friend class GrDirectContextPriv;
 
     using INHERITED = GrRecordingContext;
@@ -10,6 +10,10 @@
 
 #include "include/codec/SkCodec.h"
 
+#include <functional>
+
+class SkData;
+class SkExecutor;
 class SkImage;
 
 class SkAnimCodecPlayer {
@@ -44,6 +48,22 @@ public:
      */
     bool seek(uint32_t msec);
 
+    using FrameProc = std::function<void(int frameIndex, sk_sp<SkImage> frame)>;
+
+    /**
+     *  Decodes every frame of the encoded image in data (one frame for a static image), e.g. to
+     *  transcode an animation in bulk. Frames are split into runs, each starting at a frame that
+     *  does not depend on any earlier one. Within a run, frames are decoded in order. Separate
+     *  runs are decoded concurrently on executor (or the default executor, if null), each with
+     *  its own SkCodec. A run only keeps the frames that later frames in it still require.
+     *
+     *  proc is called with each frame as it is decoded. It is called in order within a run, but
+     *  may be called concurrently, from different threads, for different runs.
+     *
+     *  Returns false if data could not be decoded or any frame failed to decode.
+     */
+    static bool DecodeFrames(sk_sp<SkData> data, const FrameProc& proc,
+                             SkExecutor* executor = nullptr);
 
 private:
     std::unique_ptr<SkCodec>        fCodec;
@@ -188,6 +188,8 @@ private:
 
     // Helpers to break down update
     void advanceTime(double now);
+    void advanceParticleAges(float deltaTime);
+    void integrateParticles(float deltaTime);
 
     enum class EntryPoint {
         kSpawn,
@@ -227,6 +229,7 @@ private:
 
     SkParticles          fParticles;
     SkAutoTMalloc<float> fStableRandoms;
+    SkAutoTMalloc<int>   fLiveIndices;  // Scratch space for compacting dead particles
 
     // Cached
     int fCapacity = 0;
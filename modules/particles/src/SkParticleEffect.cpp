@@ -10,6 +10,7 @@
 #include "include/core/SkPaint.h"
 #include "include/private/SkOnce.h"
 #include "include/private/SkTPin.h"
+#include "include/private/SkVx.h"
 #include "modules/particles/include/SkParticleBinding.h"
 #include "modules/particles/include/SkParticleDrawable.h"
 #include "modules/particles/include/SkReflected.h"
@@ -381,19 +382,7 @@ void SkParticleEffect::advanceTime(double now) {
     }
 
     // Advance age for existing particles, and remove any that have reached their end of life
-    for (int i = 0; i < fCount; ++i) {
-        fParticles.fData[SkParticles::kAge][i] +=
-                fParticles.fData[SkParticles::kLifetime][i] * deltaTime;
-        if (fParticles.fData[SkParticles::kAge][i] > 1.0f) {
-            // NOTE: This is fast, but doesn't preserve drawing order. Could be a problem...
-            for (int j = 0; j < SkParticles::kNumChannels; ++j) {
-                fParticles.fData[j][i] = fParticles.fData[j][fCount - 1];
-            }
-            fStableRandoms[i] = fStableRandoms[fCount - 1];
-            --i;
-            --fCount;
-        }
-    }
+    this->advanceParticleAges(deltaTime);
 
     // Run 'effectUpdate' to adjust emitter properties
     this->runEffectScript(EntryPoint::kUpdate);
@@ -417,27 +406,33 @@ void SkParticleEffect::advanceTime(double now) {
     if (numToSpawn) {
         const int spawnBase = fCount;
 
-        for (int i = 0; i < numToSpawn; ++i) {
+        // New particles start with the effect's current values
+        auto fill = [&](int channel, float value) {
+            std::fill_n(fParticles.fData[channel].get() + spawnBase, numToSpawn, value);
+        };
+        fill(SkParticles::kAge            , 0.0f);
+        fill(SkParticles::kLifetime       , 0.0f);
+        fill(SkParticles::kPositionX      , fState.fPosition.fX);
+        fill(SkParticles::kPositionY      , fState.fPosition.fY);
+        fill(SkParticles::kHeadingX       , fState.fHeading.fX);
+        fill(SkParticles::kHeadingY       , fState.fHeading.fY);
+        fill(SkParticles::kScale          , fState.fScale);
+        fill(SkParticles::kVelocityX      , fState.fVelocity.fX);
+        fill(SkParticles::kVelocityY      , fState.fVelocity.fY);
+        fill(SkParticles::kVelocityAngular, fState.fSpin);
+        fill(SkParticles::kColorR         , fState.fColor.fR);
+        fill(SkParticles::kColorG         , fState.fColor.fG);
+        fill(SkParticles::kColorB         , fState.fColor.fB);
+        fill(SkParticles::kColorA         , fState.fColor.fA);
+        fill(SkParticles::kSpriteFrame    , fState.fFrame);
+
+        float* random = fParticles.fData[SkParticles::kRandom].get();
+        for (int i = spawnBase; i < spawnBase + numToSpawn; ++i) {
             // Mutate our random seed so each particle definitely gets a different generator
             fState.fRandom = advance_seed(fState.fRandom);
-            fParticles.fData[SkParticles::kAge            ][fCount] = 0.0f;
-            fParticles.fData[SkParticles::kLifetime       ][fCount] = 0.0f;
-            fParticles.fData[SkParticles::kPositionX      ][fCount] = fState.fPosition.fX;
-            fParticles.fData[SkParticles::kPositionY      ][fCount] = fState.fPosition.fY;
-            fParticles.fData[SkParticles::kHeadingX       ][fCount] = fState.fHeading.fX;
-            fParticles.fData[SkParticles::kHeadingY       ][fCount] = fState.fHeading.fY;
-            fParticles.fData[SkParticles::kScale          ][fCount] = fState.fScale;
-            fParticles.fData[SkParticles::kVelocityX      ][fCount] = fState.fVelocity.fX;
-            fParticles.fData[SkParticles::kVelocityY      ][fCount] = fState.fVelocity.fY;
-            fParticles.fData[SkParticles::kVelocityAngular][fCount] = fState.fSpin;
-            fParticles.fData[SkParticles::kColorR         ][fCount] = fState.fColor.fR;
-            fParticles.fData[SkParticles::kColorG         ][fCount] = fState.fColor.fG;
-            fParticles.fData[SkParticles::kColorB         ][fCount] = fState.fColor.fB;
-            fParticles.fData[SkParticles::kColorA         ][fCount] = fState.fColor.fA;
-            fParticles.fData[SkParticles::kSpriteFrame    ][fCount] = fState.fFrame;
-            fParticles.fData[SkParticles::kRandom         ][fCount] = fState.fRandom;
-            fCount++;
+            random[i] = fState.fRandom;
         }
+        fCount += numToSpawn;
 
         // Run the spawn script
         this->runParticleScript(EntryPoint::kSpawn, spawnBase, numToSpawn);
@@ -452,27 +447,94 @@ void SkParticleEffect::advanceTime(double now) {
     }
 
     // Restore all stable random seeds so update scripts get consistent behavior each frame
-    for (int i = 0; i < fCount; ++i) {
-        fParticles.fData[SkParticles::kRandom][i] = fStableRandoms[i];
-    }
+    std::copy_n(fStableRandoms.get(), fCount, fParticles.fData[SkParticles::kRandom].get());
 
     // Run the update script
     this->runParticleScript(EntryPoint::kUpdate, 0, fCount);
 
     // Do fixed-function update work (integration of position and orientation)
-    for (int i = 0; i < fCount; ++i) {
-        fParticles.fData[SkParticles::kPositionX][i] +=
-                fParticles.fData[SkParticles::kVelocityX][i] * deltaTime;
-        fParticles.fData[SkParticles::kPositionY][i] +=
-                fParticles.fData[SkParticles::kVelocityY][i] * deltaTime;
-
-        float spin = fParticles.fData[SkParticles::kVelocityAngular][i];
-        float s = sk_float_sin(spin * deltaTime),
-              c = sk_float_cos(spin * deltaTime);
-        float oldHeadingX = fParticles.fData[SkParticles::kHeadingX][i],
-              oldHeadingY = fParticles.fData[SkParticles::kHeadingY][i];
-        fParticles.fData[SkParticles::kHeadingX][i] = oldHeadingX * c - oldHeadingY * s;
-        fParticles.fData[SkParticles::kHeadingY][i] = oldHeadingX * s + oldHeadingY * c;
+    this->integrateParticles(deltaTime);
+}
+
+void SkParticleEffect::advanceParticleAges(float deltaTime) {
+    using F = skvx::Vec<8, float>;
+
+    float*       age     = fParticles.fData[SkParticles::kAge].get();
+    const float* invLife = fParticles.fData[SkParticles::kLifetime].get();
+
+    // Age everything, noting the first particle that died (if any)
+    int firstDead = fCount;
+    int i = 0;
+    for (; i + 8 <= fCount; i += 8) {
+        F a = F::Load(age + i) + F::Load(invLife + i) * deltaTime;
+        a.store(age + i);
+        if (firstDead == fCount && any(a > 1.0f)) {
+            firstDead = i;
+        }
+    }
+    for (; i < fCount; ++i) {
+        age[i] += invLife[i] * deltaTime;
+        if (firstDead == fCount && age[i] > 1.0f) {
+            firstDead = i;
+        }
+    }
+    if (firstDead == fCount) {
+        return;
+    }
+
+    // Compact the survivors, preserving their (drawing) order. Survivor indices are never less
+    // than their destination, so each channel can be compacted in place.
+    int* live = fLiveIndices.get();
+    int liveCount = firstDead;
+    for (i = firstDead; i < fCount; ++i) {
+        live[liveCount] = i;
+        liveCount += !(age[i] > 1.0f);
+    }
+
+    auto compact = [&](float* channel) {
+        for (int j = firstDead; j < liveCount; ++j) {
+            channel[j] = channel[live[j]];
+        }
+    };
+    for (int j = 0; j < SkParticles::kNumChannels; ++j) {
+        compact(fParticles.fData[j].get());
+    }
+    compact(fStableRandoms.get());
+    fCount = liveCount;
+}
+
+void SkParticleEffect::integrateParticles(float deltaTime) {
+    using F = skvx::Vec<8, float>;
+
+    float*       posX = fParticles.fData[SkParticles::kPositionX].get();
+    float*       posY = fParticles.fData[SkParticles::kPositionY].get();
+    const float* velX = fParticles.fData[SkParticles::kVelocityX].get();
+    const float* velY = fParticles.fData[SkParticles::kVelocityY].get();
+
+    int i = 0;
+    for (; i + 8 <= fCount; i += 8) {
+        (F::Load(posX + i) + F::Load(velX + i) * deltaTime).store(posX + i);
+        (F::Load(posY + i) + F::Load(velY + i) * deltaTime).store(posY + i);
+    }
+    for (; i < fCount; ++i) {
+        posX[i] += velX[i] * deltaTime;
+        posY[i] += velY[i] * deltaTime;
+    }
+
+    float*       headingX = fParticles.fData[SkParticles::kHeadingX].get();
+    float*       headingY = fParticles.fData[SkParticles::kHeadingY].get();
+    const float* spin     = fParticles.fData[SkParticles::kVelocityAngular].get();
+    for (i = 0; i < fCount; ++i) {
+        if (spin[i] == 0) {
+            // Rotating by zero is a no-op; skip the trig.
+            continue;
+        }
+        float s = sk_float_sin(spin[i] * deltaTime),
+              c = sk_float_cos(spin[i] * deltaTime);
+        float oldHeadingX = headingX[i],
+              oldHeadingY = headingY[i];
+        headingX[i] = oldHeadingX * c - oldHeadingY * s;
+        headingY[i] = oldHeadingX * s + oldHeadingY * c;
     }
 }
 
@@ -495,6 +557,7 @@ void SkParticleEffect::setCapacity(int capacity) {
         fParticles.fData[i].realloc(capacity);
     }
     fStableRandoms.realloc(capacity);
+    fLiveIndices.realloc(capacity);
 
     fCapacity = capacity;
     fCount = std::min(fCount, fCapacity);
@@ -0,0 +1,90 @@
+/*
+ * Copyright 2021 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkRSXform.h"
+#include "include/utils/SkNoDrawCanvas.h"
+#include "modules/particles/include/SkParticleDrawable.h"
+#include "modules/particles/include/SkParticleEffect.h"
+#include "tests/Test.h"
+
+#include <vector>
+
+namespace {
+
+// Records the translations of every drawAtlas sprite, in drawing order.
+class AtlasRecorder final : public SkNoDrawCanvas {
+public:
+    AtlasRecorder() : SkNoDrawCanvas(100, 100) {}
+
+    std::vector<SkPoint> fPositions;
+
+private:
+    void onDrawAtlas2(const SkImage*, const SkRSXform xforms[], const SkRect[], const SkColor[],
+                      int count, SkBlendMode, const SkSamplingOptions&, const SkRect*,
+                      const SkPaint*) override {
+        for (int i = 0; i < count; ++i) {
+            fPositions.push_back({ xforms[i].fTx, xforms[i].fTy });
+        }
+    }
+};
+
+// Spawns particles at increasing x (the effect's age at spawn time), with y mirroring x. About
+// half of them die within a few frames, scattered through the particle arrays.
+static constexpr char kCode[] = R"(
+    void effectSpawn(inout Effect effect) {
+      effect.lifetime = 100;
+      effect.rate = 120;
+    }
+
+    void spawn(inout Particle p) {
+      p.lifetime = rand(p.seed) < 0.5 ? 0.05 : 100;
+      p.pos = float2(effect.age * 1000, -effect.age * 1000);
+    }
+
+    void update(inout Particle p) {}
+)";
+
+}  // namespace
+
+DEF_TEST(ParticleEffect_RemoveDeadKeepsOrder, r) {
+    SkParticleEffect::RegisterParticleTypes();
+
+    auto params = sk_make_sp<SkParticleEffectParams>();
+    params->fMaxCount = 1000;
+    params->fDrawable = SkParticleDrawable::MakeCircle(1);
+    params->fCode = kCode;
+    params->prepare(nullptr);
+
+    auto effect = sk_make_sp<SkParticleEffect>(params);
+    effect->start(/*now=*/0.0, /*looping=*/false);
+
+    // Two seconds at 120 particles per second: ~240 spawned, about half of them dead by now.
+    for (int frame = 1; frame <= 120; ++frame) {
+        effect->update(frame / 60.0);
+    }
+    REPORTER_ASSERT(r, effect->getCount() > 0 && effect->getCount() < 200,
+                    "count: %d", effect->getCount());
+
+    AtlasRecorder canvas;
+    effect->draw(&canvas);
+    const auto& pos = canvas.fPositions;
+    REPORTER_ASSERT(r, (int)pos.size() == effect->getCount());
+
+    // The circle drawable centers its 2x2 sprite on the particle position.
+    for (size_t i = 0; i < pos.size(); ++i) {
+        const float x = pos[i].fX + 1,
+                    y = pos[i].fY + 1;
+        // Every channel was compacted the same way...
+        REPORTER_ASSERT(r, SkScalarNearlyEqual(y, -x, 1e-3f), "particle %zu: (%g, %g)", i, x, y);
+        // ... and survivors are still in spawn order.
+        if (i > 0) {
+            REPORTER_ASSERT(r, pos[i - 1].fX <= pos[i].fX,
+                            "particle %zu drawn out of order: %g after %g",
+                            i, pos[i].fX, pos[i - 1].fX);
+        }
+    }
+}
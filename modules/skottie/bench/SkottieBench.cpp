@@ -0,0 +1,216 @@
+/*
+ * Copyright 2021 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkSurface.h"
+#include "modules/skottie/include/Skottie.h"
+#include "modules/skottie/utils/SkottieUtils.h"
+#include "modules/sksg/include/SkSGInvalidationController.h"
+#include "tools/Resources.h"
+
+#include <memory>
+#include <vector>
+
+namespace {
+
+// Frame rendering throughput: renders a fixed number of frames, evenly spread over the animation
+// duration, into per-frame raster surfaces.  The serial variant uses a synchronous executor, and
+// the threaded variant a thread pool sized to the number of cores.
+class SkottieFramesBench final : public Benchmark {
+public:
+    SkottieFramesBench(const char* resource, bool threaded)
+        : fResource(resource)
+        , fThreaded(threaded) {
+        fName.printf("skottie_frames_%s_%s", resource, threaded ? "threaded" : "serial");
+    }
+
+private:
+    static constexpr int kFrameCount = 32,
+                         kFrameSize  = 256;
+
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+
+    void onDelayedSetup() override {
+        auto data = GetResourceAsData(SkStringPrintf("skottie/%s.json", fResource).c_str());
+        if (!data) {
+            return;
+        }
+
+        auto animation = skottie::Animation::Builder(skottie::Animation::Builder::kEnableInstancing)
+                .make(static_cast<const char*>(data->data()), data->size());
+        if (!animation) {
+            return;
+        }
+
+        const auto frame_span = animation->outPoint() - animation->inPoint();
+        for (int i = 0; i < kFrameCount; ++i) {
+            fRequests.push_back({animation, frame_span * i / kFrameCount});
+            fSurfaces.push_back(SkSurface::MakeRasterN32Premul(kFrameSize, kFrameSize));
+        }
+
+        fExecutor = fThreaded ? SkExecutor::MakeFIFOThreadPool() : nullptr;
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        if (fRequests.empty()) {
+            return;
+        }
+
+        const auto dst = SkRect::MakeIWH(kFrameSize, kFrameSize);
+        auto& executor = fExecutor ? *fExecutor : SkExecutor::GetDefault();
+
+        for (int i = 0; i < loops; ++i) {
+            skottie_utils::RenderFrames(executor, fRequests,
+                                        [&](size_t index, const skottie::Animation& instance) {
+                auto* canvas = fSurfaces[index]->getCanvas();
+                canvas->clear(SK_ColorTRANSPARENT);
+                instance.render(canvas, &dst);
+            });
+        }
+    }
+
+    const char*                                fResource;
+    const bool                                 fThreaded;
+    SkString                                   fName;
+    std::unique_ptr<SkExecutor>                fExecutor;
+    std::vector<skottie_utils::FrameRequest>   fRequests;
+    std::vector<sk_sp<SkSurface>>              fSurfaces;
+};
+
+// Animation state update cost: seeks through all frames, without rendering.
+class SkottieSeekBench final : public Benchmark {
+public:
+    explicit SkottieSeekBench(const char* resource)
+        : fResource(resource) {
+        fName.printf("skottie_seek_%s", resource);
+    }
+
+private:
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+
+    void onDelayedSetup() override {
+        auto data = GetResourceAsData(SkStringPrintf("skottie/%s.json", fResource).c_str());
+        if (data) {
+            fAnimation = skottie::Animation::Make(static_cast<const char*>(data->data()),
+                                                  data->size());
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        if (!fAnimation) {
+            return;
+        }
+
+        // Quarter-frame steps, to exercise keyframe interpolation.
+        const auto frame_span = fAnimation->outPoint() - fAnimation->inPoint();
+        for (int i = 0; i < loops; ++i) {
+            for (double f = 0; f < frame_span; f += 0.25) {
+                fAnimation->seekFrame(f);
+            }
+        }
+    }
+
+    const char*               fResource;
+    SkString                  fName;
+    sk_sp<skottie::Animation> fAnimation;
+};
+
+// Full vs. damage-driven (partial) re-rendering of sequential frames into a retained surface.
+class SkottieDamageBench final : public Benchmark {
+public:
+    SkottieDamageBench(const char* resource, bool partial)
+        : fResource(resource)
+        , fPartial(partial) {
+        fName.printf("skottie_render_%s_%s", resource, partial ? "damage" : "full");
+    }
+
+private:
+    static constexpr int kSurfaceSize = 1024;
+
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+
+    void onDelayedSetup() override {
+        auto data = GetResourceAsData(SkStringPrintf("skottie/%s.json", fResource).c_str());
+        if (data) {
+            fAnimation = skottie::Animation::Make(static_cast<const char*>(data->data()),
+                                                  data->size());
+        }
+        fSurface = SkSurface::MakeRasterN32Premul(kSurfaceSize, kSurfaceSize);
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        if (!fAnimation || !fSurface) {
+            return;
+        }
+
+        auto* canvas = fSurface->getCanvas();
+        const auto dst = SkRect::MakeIWH(kSurfaceSize, kSurfaceSize);
+
+        canvas->clear(SK_ColorTRANSPARENT);
+        fAnimation->seekFrame(0);
+        fAnimation->render(canvas, &dst);
+
+        const auto frame_span = fAnimation->outPoint() - fAnimation->inPoint();
+        for (int i = 0; i < loops; ++i) {
+            for (double f = 1; f < frame_span; f += 1) {
+                if (fPartial) {
+                    sksg::InvalidationController ic;
+                    fAnimation->seekFrame(f, &ic);
+                    fAnimation->renderDamage(canvas, ic, &dst);
+                } else {
+                    fAnimation->seekFrame(f);
+                    canvas->clear(SK_ColorTRANSPARENT);
+                    fAnimation->render(canvas, &dst);
+                }
+            }
+        }
+    }
+
+    const char*               fResource;
+    const bool                fPartial;
+    SkString                  fName;
+    sk_sp<skottie::Animation> fAnimation;
+    sk_sp<SkSurface>          fSurface;
+};
+
+} // namespace
+
+#define SKOTTIE_FRAMES_BENCH(res)                                       \
+    DEF_BENCH(return new SkottieFramesBench(res, /*threaded=*/false);)  \
+    DEF_BENCH(return new SkottieFramesBench(res, /*threaded=*/true);)
+
+SKOTTIE_FRAMES_BENCH("skottie_sample_2")
+SKOTTIE_FRAMES_BENCH("skottie_sample_multiframe")
+SKOTTIE_FRAMES_BENCH("skottie_sample_search")
+SKOTTIE_FRAMES_BENCH("skottie-chained-mattes")
+SKOTTIE_FRAMES_BENCH("skottie-text-animator-1")
+
+#undef SKOTTIE_FRAMES_BENCH
+
+DEF_BENCH(return new SkottieSeekBench("skottie_sample_2");)
+DEF_BENCH(return new SkottieSeekBench("skottie_sample_multiframe");)
+DEF_BENCH(return new SkottieSeekBench("skottie_sample_search");)
+DEF_BENCH(return new SkottieSeekBench("skottie-text-animator-1");)
+DEF_BENCH(return new SkottieSeekBench("skottie-transform-effect");)
+
+#define SKOTTIE_DAMAGE_BENCH(res)                                       \
+    DEF_BENCH(return new SkottieDamageBench(res, /*partial=*/false);)   \
+    DEF_BENCH(return new SkottieDamageBench(res, /*partial=*/true);)
+
+SKOTTIE_DAMAGE_BENCH("skottie_sample_search")
+SKOTTIE_DAMAGE_BENCH("skottie-text-animator-1")
+SKOTTIE_DAMAGE_BENCH("skottie-repeater")
+
+#undef SKOTTIE_DAMAGE_BENCH
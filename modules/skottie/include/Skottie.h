@@ -10,6 +10,7 @@
 
 #include "include/core/SkFontMgr.h"
 #include "include/core/SkRefCnt.h"
+#include "include/core/SkRegion.h"
 #include "include/core/SkSize.h"
 #include "include/core/SkString.h"
 #include "include/core/SkTypes.h"
@@ -35,7 +36,12 @@ class Scene;
 
 namespace skottie {
 
-namespace internal { class Animator; }
+namespace internal {
+
+class AnimationSource;
+class Animator;
+
+} // namespace internal
 
 using ImageAsset = skresources::ImageAsset;
 using ResourceProvider = skresources::ResourceProvider;
@@ -72,6 +78,8 @@ public:
                                          // frames are only resolved when needed, at seek() time.
             kPreferEmbeddedFonts = 0x02, // Attempt to use the embedded fonts (glyph paths,
                                          // normally used as fallback) over native Skia typefaces.
+            kEnableInstancing    = 0x04, // Retain the parsed JSON and build-time resources, such
+                                         // that Animation::makeInstance() can be used.
         };
 
         explicit Builder(uint32_t flags = 0);
@@ -181,6 +189,26 @@ public:
     void render(SkCanvas* canvas, const SkRect* dst = nullptr) const;
     void render(SkCanvas* canvas, const SkRect* dst, RenderFlags) const;
 
+    /**
+     * Updates a previously rendered frame, by only redrawing the areas damaged since.
+     *
+     * |ic| holds the damage accumulated by seek*() calls since the previous frame was rendered,
+     * and |canvas| is expected to retain the previous frame pixels (e.g. a persistent raster
+     * surface), rendered with the same matrix, |dst| and flags.
+     *
+     * Damaged areas are snapped to a device space tile grid, cleared to transparent and
+     * re-rendered.  Scene nodes which don't intersect the damaged tiles are culled.
+     *
+     * @param canvas   destination canvas, holding the previous frame
+     * @param ic       damage since the previous frame
+     * @param dst      optional destination rect
+     * @param flags    optional RenderFlags
+     *
+     * @return the updated device space region (empty if there was no visible damage).
+     */
+    SkRegion renderDamage(SkCanvas* canvas, const sksg::InvalidationController& ic,
+                          const SkRect* dst = nullptr, RenderFlags flags = 0) const;
+
     /**
      * [Deprecated: use one of the other versions.]
      *
@@ -234,6 +262,24 @@ public:
     const SkString& version() const { return fVersion; }
     const SkSize&      size() const { return fSize;    }
 
+    /**
+     * Creates a new, independent instance of this animation.
+     *
+     * Instances share the parsed JSON and the build-time resources (resource provider, font
+     * manager, precomp interceptor), but own their scene graph and animation state: each instance
+     * can be seeked and rendered on a different thread, concurrently with the other instances.
+     *
+     * Property and marker observers are not notified for instances, and instance build warnings
+     * are not logged (they would duplicate the original ones).
+     *
+     * This method is thread safe, but the resource provider may be called concurrently when
+     * instantiating on multiple threads.
+     *
+     * @return a new animation instance, or nullptr if this animation was not built with
+     *         Builder::kEnableInstancing.
+     */
+    sk_sp<Animation> makeInstance() const;
+
 private:
     enum Flags : uint32_t {
         kRequiresTopLevelIsolation = 1 << 0, // Needs to draw into a layer due to layer blending.
@@ -242,7 +288,10 @@ private:
     Animation(std::unique_ptr<sksg::Scene>,
               std::vector<sk_sp<internal::Animator>>&&,
               SkString ver, const SkSize& size,
-              double inPoint, double outPoint, double duration, double fps, uint32_t flags);
+              double inPoint, double outPoint, double duration, double fps, uint32_t flags,
+              sk_sp<internal::AnimationSource>);
+
+    void renderImpl(SkCanvas*, const SkRect* dst, RenderFlags, bool cull_to_clip) const;
 
     const std::unique_ptr<sksg::Scene>           fScene;
     const std::vector<sk_sp<internal::Animator>> fAnimators;
@@ -253,6 +302,7 @@ private:
                                                  fDuration,
                                                  fFPS;
     const uint32_t                               fFlags;
+    const sk_sp<internal::AnimationSource>       fSource; // only set with kEnableInstancing
 
     using INHERITED = SkNVRefCnt<Animation>;
 };
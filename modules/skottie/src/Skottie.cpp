@@ -297,6 +297,17 @@ void AnimationBuilder::AutoPropertyTracker::updateContext(PropertyObserver* obse
     fBuilder->fPropertyObserverContext = name ? name->begin() : nullptr;
 }
 
+AnimationSource::AnimationSource(std::unique_ptr<skjson::DOM> dom, sk_sp<ResourceProvider> rp,
+                                 sk_sp<SkFontMgr> fontmgr, sk_sp<PrecompInterceptor> pi,
+                                 uint32_t flags)
+    : fDOM(std::move(dom))
+    , fResourceProvider(std::move(rp))
+    , fFontMgr(std::move(fontmgr))
+    , fPrecompInterceptor(std::move(pi))
+    , fFlags(flags) {}
+
+AnimationSource::~AnimationSource() = default;
+
 } // namespace internal
 
 void Logger::log(Level, const char[], const char*) {}
@@ -369,15 +380,15 @@ sk_sp<Animation> Animation::Builder::make(const char* data, size_t data_len) {
     fStats.fJsonSize = data_len;
     const auto t0 = std::chrono::steady_clock::now();
 
-    const skjson::DOM dom(data, data_len);
-    if (!dom.root().is<skjson::ObjectValue>()) {
+    auto dom = std::make_unique<skjson::DOM>(data, data_len);
+    if (!dom->root().is<skjson::ObjectValue>()) {
         // TODO: more error info.
         if (fLogger) {
             fLogger->log(Logger::Level::kError, "Failed to parse JSON input.\n");
         }
         return nullptr;
     }
-    const auto& json = dom.root().as<skjson::ObjectValue>();
+    const auto& json = dom->root().as<skjson::ObjectValue>();
 
     const auto t1 = std::chrono::steady_clock::now();
     fStats.fJsonParseTimeMS = std::chrono::duration<float, std::milli>{t1-t0}.count();
@@ -403,6 +414,12 @@ sk_sp<Animation> Animation::Builder::make(const char* data, size_t data_len) {
     }
 
     SkASSERT(resolvedProvider);
+    sk_sp<internal::AnimationSource> source;
+    if (fFlags & kEnableInstancing) {
+        source = sk_make_sp<internal::AnimationSource>(std::move(dom), resolvedProvider, fFontMgr,
+                                                       fPrecompInterceptor, fFlags);
+    }
+
     internal::AnimationBuilder builder(std::move(resolvedProvider), fFontMgr,
                                        std::move(fPropertyObserver),
                                        std::move(fLogger),
@@ -432,7 +449,8 @@ sk_sp<Animation> Animation::Builder::make(const char* data, size_t data_len) {
                                           outPoint,
                                           duration,
                                           fps,
-                                          flags));
+                                          flags,
+                                          std::move(source)));
 }
 
 sk_sp<Animation> Animation::Builder::makeFromFile(const char path[]) {
@@ -445,7 +463,8 @@ sk_sp<Animation> Animation::Builder::makeFromFile(const char path[]) {
 Animation::Animation(std::unique_ptr<sksg::Scene> scene,
                      std::vector<sk_sp<internal::Animator>>&& animators,
                      SkString version, const SkSize& size,
-                     double inPoint, double outPoint, double duration, double fps, uint32_t flags)
+                     double inPoint, double outPoint, double duration, double fps, uint32_t flags,
+                     sk_sp<internal::AnimationSource> source)
     : fScene(std::move(scene))
     , fAnimators(std::move(animators))
     , fVersion(std::move(version))
@@ -454,10 +473,40 @@ Animation::Animation(std::unique_ptr<sksg::Scene> scene,
     , fOutPoint(outPoint)
     , fDuration(duration)
     , fFPS(fps)
-    , fFlags(flags) {}
+    , fFlags(flags)
+    , fSource(std::move(source)) {}
 
 Animation::~Animation() = default;
 
+sk_sp<Animation> Animation::makeInstance() const {
+    TRACE_EVENT0("skottie", TRACE_FUNC);
+
+    if (!fSource) {
+        return nullptr;
+    }
+
+    // The source DOM is immutable, so instances can be built concurrently.  Build-time
+    // observers and the logger are not retained: they have already been notified for the
+    // original animation.
+    Builder::Stats stats;
+    internal::AnimationBuilder builder(fSource->fResourceProvider, fSource->fFontMgr,
+                                       nullptr, nullptr, nullptr,
+                                       fSource->fPrecompInterceptor,
+                                       &stats, fSize, fDuration, fFPS, fSource->fFlags);
+    auto ainfo = builder.parse(fSource->fDOM->root().as<skjson::ObjectValue>());
+
+    return sk_sp<Animation>(new Animation(std::move(ainfo.fScene),
+                                          std::move(ainfo.fAnimators),
+                                          fVersion,
+                                          fSize,
+                                          fInPoint,
+                                          fOutPoint,
+                                          fDuration,
+                                          fFPS,
+                                          fFlags,
+                                          fSource));
+}
+
 void Animation::render(SkCanvas* canvas, const SkRect* dstR) const {
     this->render(canvas, dstR, 0);
 }
@@ -465,6 +514,11 @@ void Animation::render(SkCanvas* canvas, const SkRect* dstR) const {
 void Animation::render(SkCanvas* canvas, const SkRect* dstR, RenderFlags renderFlags) const {
     TRACE_EVENT0("skottie", TRACE_FUNC);
 
+    this->renderImpl(canvas, dstR, renderFlags, false);
+}
+
+void Animation::renderImpl(SkCanvas* canvas, const SkRect* dstR, RenderFlags renderFlags,
+                           bool cull_to_clip) const {
     if (!fScene)
         return;
 
@@ -486,7 +540,62 @@ void Animation::render(SkCanvas* canvas, const SkRect* dstR, RenderFlags renderF
         canvas->saveLayer(srcR, nullptr);
     }
 
-    fScene->render(canvas);
+    if (cull_to_clip) {
+        fScene->renderCulled(canvas);
+    } else {
+        fScene->render(canvas);
+    }
+}
+
+SkRegion Animation::renderDamage(SkCanvas* canvas, const sksg::InvalidationController& ic,
+                                 const SkRect* dstR, RenderFlags renderFlags) const {
+    TRACE_EVENT0("skottie", TRACE_FUNC);
+
+    SkRegion damage;
+    if (!fScene) {
+        return damage;
+    }
+
+    // Damage is tracked in animation coordinates.
+    const SkRect srcR = SkRect::MakeSize(this->size());
+    auto ctm = canvas->getTotalMatrix();
+    if (dstR) {
+        ctm.preConcat(SkMatrix::RectToRect(srcR, *dstR, SkMatrix::kCenter_ScaleToFit));
+    }
+
+    auto clip = canvas->getDeviceClipBounds();
+    if (!(renderFlags & RenderFlag::kDisableTopLevelClipping) &&
+        !clip.intersect(ctm.mapRect(srcR).roundOut())) {
+        return damage;
+    }
+
+    // Coarse tiles keep the region simple, and cover small sub-pixel/AA overshoots.
+    static constexpr int kTileSize = 32;
+    const auto snap_down = [](int v) {
+        return (v >= 0 ? v / kTileSize : -((kTileSize - 1 - v) / kTileSize)) * kTileSize;
+    };
+    const auto snap_up = [&](int v) { return -snap_down(-v); };
+
+    for (const auto& r : ic) {
+        auto ir = ctm.mapRect(r).roundOut().makeOutset(1, 1);
+        ir.setLTRB(snap_down(ir.left()), snap_down(ir.top()),
+                   snap_up(ir.right()),  snap_up(ir.bottom()));
+
+        if (ir.intersect(clip)) {
+            damage.op(ir, SkRegion::kUnion_Op);
+        }
+    }
+
+    if (!damage.isEmpty()) {
+        SkAutoCanvasRestore acr(canvas, true);
+        canvas->clipRegion(damage);
+        canvas->clear(SK_ColorTRANSPARENT);
+
+        // Only the damaged tiles are redrawn, so it pays off to skip undamaged sub-DAGs.
+        this->renderImpl(canvas, dstR, renderFlags, true);
+    }
+
+    return damage;
 }
 
 void Animation::seekFrame(double t, sksg::InvalidationController* ic) {
@@ -17,6 +17,7 @@
 #include "include/utils/SkCustomTypeface.h"
 #include "modules/skottie/include/SkottieProperty.h"
 #include "modules/skottie/src/animator/Animator.h"
+#include "modules/skottie/src/animator/KeyframeAnimator.h"
 #include "modules/sksg/include/SkSGScene.h"
 #include "src/utils/SkUTF.h"
 
@@ -26,6 +27,7 @@ class SkFontMgr;
 
 namespace skjson {
 class ArrayValue;
+class DOM;
 class ObjectValue;
 class Value;
 } // namespace skjson
@@ -77,6 +79,9 @@ public:
 
     void log(Logger::Level, const skjson::Value*, const char fmt[], ...) const;
 
+    // Cubic easing functions shared by all keyframe animators.
+    const sk_sp<EasingTable>& easingTable() const { return fEasingTable; }
+
     sk_sp<sksg::Transform> attachMatrix2D(const skjson::ObjectValue&, sk_sp<sksg::Transform>,
                                           bool auto_orient = false) const;
     sk_sp<sksg::Transform> attachMatrix3D(const skjson::ObjectValue&, sk_sp<sksg::Transform>,
@@ -236,6 +241,7 @@ private:
     sk_sp<Logger>              fLogger;
     sk_sp<MarkerObserver>      fMarkerObserver;
     sk_sp<PrecompInterceptor>  fPrecompInterceptor;
+    const sk_sp<EasingTable>   fEasingTable = sk_make_sp<EasingTable>();
     Animation::Builder::Stats* fStats;
     const SkSize               fCompSize;
     const float                fDuration,
@@ -286,6 +292,21 @@ private:
     using INHERITED = SkNoncopyable;
 };
 
+// Immutable build-time state retained by Animation::Builder::kEnableInstancing animations, and
+// shared by all their instances.
+class AnimationSource final : public SkNVRefCnt<AnimationSource> {
+public:
+    AnimationSource(std::unique_ptr<skjson::DOM>, sk_sp<ResourceProvider>, sk_sp<SkFontMgr>,
+                    sk_sp<PrecompInterceptor>, uint32_t flags);
+    ~AnimationSource();
+
+    const std::unique_ptr<skjson::DOM> fDOM;
+    const sk_sp<ResourceProvider>      fResourceProvider;
+    const sk_sp<SkFontMgr>             fFontMgr;
+    const sk_sp<PrecompInterceptor>    fPrecompInterceptor;
+    const uint32_t                     fFlags;
+};
+
 } // namespace internal
 } // namespace skottie
 
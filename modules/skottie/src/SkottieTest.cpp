@@ -5,6 +5,8 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
 #include "include/core/SkFontMgr.h"
 #include "include/core/SkMatrix.h"
 #include "include/core/SkStream.h"
@@ -13,6 +15,7 @@
 #include "modules/skottie/include/Skottie.h"
 #include "modules/skottie/include/SkottieProperty.h"
 #include "modules/skottie/src/text/SkottieShaper.h"
+#include "modules/sksg/include/SkSGInvalidationController.h"
 #include "src/core/SkFontDescriptor.h"
 #include "src/core/SkTextBlobPriv.h"
 #include "tests/Test.h"
@@ -859,3 +862,190 @@ DEF_TEST(Skottie_Image_Loading, reporter) {
         REPORTER_ASSERT(reporter, SkScalarNearlyEqual(multi_asset->requestedFrames()[1], 2));
     }
 }
+
+DEF_TEST(Skottie_Instancing, reporter) {
+    static constexpr char json[] = R"({
+                                     "v": "5.2.1",
+                                     "w": 100,
+                                     "h": 100,
+                                     "fr": 10,
+                                     "ip": 0,
+                                     "op": 10,
+                                     "layers": [
+                                       {
+                                         "ty": 1,
+                                         "sw": 100,
+                                         "sh": 100,
+                                         "sc": "#ff0000",
+                                         "ip": 0,
+                                         "op": 10,
+                                         "ks": {
+                                           "o": {
+                                             "a": 1,
+                                             "k": [
+                                               { "t":  0, "s": 0   },
+                                               { "t": 10, "s": 100 }
+                                             ]
+                                           }
+                                         }
+                                       }
+                                     ]
+                                   })";
+
+    class CountingObserver final : public PropertyObserver {
+    public:
+        void onOpacityProperty(const char[],
+                               const LazyHandle<OpacityPropertyHandle>&) override {
+            fCount++;
+        }
+
+        int fCount = 0;
+    };
+
+    auto alpha_at_center = [](const Animation& animation) {
+        SkBitmap bm;
+        bm.allocN32Pixels(10, 10);
+        bm.eraseColor(SK_ColorTRANSPARENT);
+
+        SkCanvas canvas(bm);
+        const auto dst = SkRect::MakeWH(10, 10);
+        animation.render(&canvas, &dst);
+
+        return SkColorGetA(bm.getColor(5, 5));
+    };
+
+    // Instancing is opt-in.
+    auto plain = Animation::Make(json, strlen(json));
+    REPORTER_ASSERT(reporter, plain);
+    REPORTER_ASSERT(reporter, plain && !plain->makeInstance());
+
+    auto observer = sk_make_sp<CountingObserver>();
+    auto animation = Animation::Builder(Animation::Builder::kEnableInstancing)
+                         .setPropertyObserver(observer)
+                         .make(json, strlen(json));
+    REPORTER_ASSERT(reporter, animation);
+    if (!animation) {
+        return;
+    }
+
+    const auto observed = observer->fCount;
+    REPORTER_ASSERT(reporter, observed > 0);
+
+    auto instance = animation->makeInstance();
+    REPORTER_ASSERT(reporter, instance);
+    if (!instance) {
+        return;
+    }
+
+    // Instances don't notify build-time observers.
+    REPORTER_ASSERT(reporter, observer->fCount == observed);
+
+    REPORTER_ASSERT(reporter, instance->size()     == animation->size());
+    REPORTER_ASSERT(reporter, instance->duration() == animation->duration());
+    REPORTER_ASSERT(reporter, instance->fps()      == animation->fps());
+    REPORTER_ASSERT(reporter, instance->version()  == animation->version());
+
+    // Instances have independent animation state.
+    animation->seekFrame(2);
+    instance->seekFrame(8);
+    const auto a2 = alpha_at_center(*animation),
+               a8 = alpha_at_center(*instance);
+    REPORTER_ASSERT(reporter, a2 < a8);
+
+    // ... and render the same content as the original, for a given frame.
+    animation->seekFrame(8);
+    REPORTER_ASSERT(reporter, alpha_at_center(*animation) == a8);
+
+    // Instances of instances are supported.
+    auto nested = instance->makeInstance();
+    REPORTER_ASSERT(reporter, nested);
+    if (nested) {
+        nested->seekFrame(2);
+        REPORTER_ASSERT(reporter, alpha_at_center(*nested) == a2);
+    }
+}
+
+DEF_TEST(Skottie_RenderDamage, reporter) {
+    // A small moving square and a static one, in a large canvas.
+    static constexpr char json[] = R"({
+                                     "v": "5.2.1",
+                                     "w": 400,
+                                     "h": 400,
+                                     "fr": 10,
+                                     "ip": 0,
+                                     "op": 10,
+                                     "layers": [
+                                       {
+                                         "ty": 1,
+                                         "sw": 20,
+                                         "sh": 20,
+                                         "sc": "#ff0000",
+                                         "ip": 0,
+                                         "op": 10,
+                                         "ks": {
+                                           "p": {
+                                             "a": 1,
+                                             "k": [
+                                               { "t":  0, "s": [ 20.5, 20.5 ] },
+                                               { "t": 10, "s": [ 80.5, 60.5 ] }
+                                             ]
+                                           }
+                                         }
+                                       },
+                                       {
+                                         "ty": 1,
+                                         "sw": 20,
+                                         "sh": 20,
+                                         "sc": "#0000ff",
+                                         "ip": 0,
+                                         "op": 10,
+                                         "ks": { "p": { "a": 0, "k": [ 300, 300 ] } }
+                                       }
+                                     ]
+                                   })";
+
+    auto animation = Animation::Make(json, strlen(json));
+    REPORTER_ASSERT(reporter, animation);
+    if (!animation) {
+        return;
+    }
+
+    const auto info = SkImageInfo::MakeN32Premul(200, 200);
+    const auto dst  = SkRect::MakeWH(200, 200);
+
+    SkBitmap incremental, full;
+    incremental.allocPixels(info);
+    full.allocPixels(info);
+
+    SkCanvas incremental_canvas(incremental),
+             full_canvas(full);
+
+    incremental.eraseColor(SK_ColorTRANSPARENT);
+    animation->seekFrame(0);
+    animation->render(&incremental_canvas, &dst);
+
+    for (double frame : { 0.0, 2.5, 3.0, 7.25, 9.0, 9.0 }) {
+        sksg::InvalidationController ic;
+        animation->seekFrame(frame, &ic);
+
+        const auto updated = animation->renderDamage(&incremental_canvas, ic, &dst);
+
+        // Static content is never redrawn.
+        REPORTER_ASSERT(reporter, !updated.intersects(SkIRect::MakeLTRB(150, 150, 160, 160)));
+
+        full.eraseColor(SK_ColorTRANSPARENT);
+        animation->render(&full_canvas, &dst);
+
+        bool match = true;
+        for (int y = 0; y < info.height() && match; ++y) {
+            match = !memcmp(incremental.getAddr32(0, y), full.getAddr32(0, y),
+                            info.minRowBytes());
+        }
+        REPORTER_ASSERT(reporter, match, "frame: %f", frame);
+    }
+
+    // Seeking to the current frame yields no damage.
+    sksg::InvalidationController ic;
+    animation->seekFrame(9, &ic);
+    REPORTER_ASSERT(reporter, animation->renderDamage(&incremental_canvas, ic, &dst).isEmpty());
+}
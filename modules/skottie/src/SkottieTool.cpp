@@ -277,12 +277,14 @@ int main(int argc, char** argv) {
         return 1;
     }
 
-    // Instantiate an animation on the main thread for two reasons:
+    // Instantiate an animation on the main thread for three reasons:
     //   - we need to know its duration upfront
     //   - we want to only report parsing errors once
-    auto anim = skottie::Animation::Builder()
+    //   - worker threads can create their own instances without reparsing the JSON
+    auto anim = skottie::Animation::Builder(skottie::Animation::Builder::kEnableInstancing)
             .setLogger(logger)
             .setResourceProvider(rp)
+            .setPrecompInterceptor(precomp_interceptor)
             .make(static_cast<const char*>(data->data()), data->size());
     if (!anim) {
         SkDebugf("Could not parse animation: '%s'.\n", FLAGS_input[0]);
@@ -338,24 +340,16 @@ int main(int argc, char** argv) {
         const auto start = std::chrono::steady_clock::now();
 #if defined(SK_BUILD_FOR_IOS)
         // iOS doesn't support thread_local on versions less than 9.0.
-        auto anim = skottie::Animation::Builder()
-                            .setResourceProvider(rp)
-                            .setPrecompInterceptor(precomp_interceptor)
-                            .make(static_cast<const char*>(data->data()), data->size());
+        auto instance = anim->makeInstance();
         auto sink = MakeSink(FLAGS_format[0], scale_matrix);
 #else
-        thread_local static auto* anim =
-                skottie::Animation::Builder()
-                    .setResourceProvider(rp)
-                    .setPrecompInterceptor(precomp_interceptor)
-                    .make(static_cast<const char*>(data->data()), data->size())
-                    .release();
+        thread_local static auto* instance = anim->makeInstance().release();
         thread_local static auto* sink = MakeSink(FLAGS_format[0], scale_matrix).release();
 #endif
 
-        if (sink && anim) {
-            anim->seekFrame(frame0 + i * fps_scale);
-            anim->render(sink->beginFrame(i));
+        if (sink && instance) {
+            instance->seekFrame(frame0 + i * fps_scale);
+            instance->render(sink->beginFrame(i));
             sink->endFrame(i);
         }
 
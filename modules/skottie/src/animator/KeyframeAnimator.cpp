@@ -8,79 +8,153 @@
 #include "modules/skottie/src/animator/KeyframeAnimator.h"
 
 #include "modules/skottie/src/SkottieJson.h"
+#include "modules/skottie/src/SkottiePriv.h"
+
+#include <cmath>
 
 #define DUMP_KF_RECORDS 0
 
 namespace skottie::internal {
 
+uint32_t EasingTable::findOrAdd(const SkPoint& c0, const SkPoint& c1) {
+    return this->findOrAdd({ c0, c1, 0 });
+}
+
+uint32_t EasingTable::refineForRange(uint32_t index, float valueRange) {
+    SkASSERT(index < fEntries.size());
+
+    // LUT weight errors show up scaled by the eased value range: keep them under 1/64 of a
+    // unit (pixel, degree, ...) on screen.
+    static constexpr float kMaxValueError = 1.0f / 64;
+
+    if (fEntries[index].fLUTOffset < 0 ||
+        fEntries[index].fLUTError * valueRange <= kMaxValueError) {
+        return index;
+    }
+
+    auto key = fEntries[index].fKey;
+    key.exact = 1;
+    return this->findOrAdd(key);
+}
+
+uint32_t EasingTable::findOrAdd(const Key& key) {
+    if (const auto* index = fIndex.find(key)) {
+        return *index;
+    }
+
+    Entry entry = { key, SkCubicMap(key.c0, key.c1), -1, 0 };
+    const auto index = SkToU32(fEntries.size());
+
+    if (key.exact) {
+        fEntries.push_back(entry);
+        fIndex.set(key, index);
+        return index;
+    }
+    entry.fLUTOffset = SkToInt(fLUTs.size());
+
+    // Sample the curve, and validate the LUT against the exact midpoint values: steep curves
+    // (near-vertical tangents) are not well approximated by linear segments.
+    static constexpr float kMaxError = 1.0f / 4096;
+
+    const auto lut_offset = fLUTs.size();
+    fLUTs.resize(lut_offset + kLUTSegments + 1);
+    auto* lut = fLUTs.data() + lut_offset;
+
+    for (int i = 0; i <= kLUTSegments; ++i) {
+        lut[i] = entry.fMap.computeYFromX(static_cast<float>(i) / kLUTSegments);
+    }
+
+    for (int i = 0; i < kLUTSegments; ++i) {
+        const auto mid_exact = entry.fMap.computeYFromX((i + 0.5f) / kLUTSegments),
+                   mid_lerp  = (lut[i] + lut[i + 1]) * 0.5f;
+        entry.fLUTError = std::max(entry.fLUTError, std::abs(mid_exact - mid_lerp));
+        if (entry.fLUTError > kMaxError) {
+            fLUTs.resize(lut_offset);
+            entry.fLUTOffset = -1;
+            break;
+        }
+    }
+
+    fEntries.push_back(entry);
+    fIndex.set(key, index);
+
+    return index;
+}
+
+KeyframeAnimator::KeyframeAnimator(std::vector<Keyframe> kfs, sk_sp<const EasingTable> easing)
+    : fEasing(std::move(easing)) {
+    fTimes.reserve(kfs.size());
+    fRecs.reserve(kfs.size());
+
+    for (const auto& kf : kfs) {
+        SkASSERT(kf.mapping < Keyframe::kCubicIndexOffset ||
+                 (fEasing && kf.mapping - Keyframe::kCubicIndexOffset < fEasing->count()));
+        fTimes.push_back(kf.t);
+        fRecs.push_back({kf.v, kf.mapping});
+    }
+}
+
 KeyframeAnimator::~KeyframeAnimator() = default;
 
 KeyframeAnimator::LERPInfo KeyframeAnimator::getLERPInfo(float t) const {
-    SkASSERT(!fKFs.empty());
+    SkASSERT(!fTimes.empty());
 
-    if (t <= fKFs.front().t) {
+    if (t <= fTimes.front()) {
         // Constant/clamped segment.
-        return { 0, fKFs.front().v, fKFs.front().v };
+        return { 0, fRecs.front().v, fRecs.front().v };
     }
-    if (t >= fKFs.back().t) {
+    if (t >= fTimes.back()) {
         // Constant/clamped segment.
-        return { 0, fKFs.back().v, fKFs.back().v };
+        return { 0, fRecs.back().v, fRecs.back().v };
     }
 
     // Cache the current segment (most queries have good locality).
-    if (!fCurrentSegment.contains(t)) {
-        fCurrentSegment = this->find_segment(t);
+    if (!this->segment_contains(fCurrentSegment, t)) {
+        // Sequential playback typically moves to the next segment.
+        const auto next = fCurrentSegment + 1;
+        fCurrentSegment = next + 1 < fTimes.size() && this->segment_contains(next, t)
+                ? next
+                : this->find_segment(t);
     }
-    SkASSERT(fCurrentSegment.contains(t));
+    SkASSERT(this->segment_contains(fCurrentSegment, t));
 
-    if (fCurrentSegment.kf0->mapping == Keyframe::kConstantMapping) {
+    const auto& rec0 = fRecs[fCurrentSegment];
+    if (rec0.mapping == Keyframe::kConstantMapping) {
         // Constant/hold segment.
-        return { 0, fCurrentSegment.kf0->v, fCurrentSegment.kf0->v };
+        return { 0, rec0.v, rec0.v };
     }
 
     return {
         this->compute_weight(fCurrentSegment, t),
-        fCurrentSegment.kf0->v,
-        fCurrentSegment.kf1->v,
+        rec0.v,
+        fRecs[fCurrentSegment + 1].v,
     };
 }
 
-KeyframeAnimator::KFSegment KeyframeAnimator::find_segment(float t) const {
-    SkASSERT(fKFs.size() > 1);
-    SkASSERT(t > fKFs.front().t);
-    SkASSERT(t < fKFs.back().t);
+size_t KeyframeAnimator::find_segment(float t) const {
+    SkASSERT(fTimes.size() > 1);
+    SkASSERT(t > fTimes.front());
+    SkASSERT(t < fTimes.back());
 
-    auto kf0 = &fKFs.front(),
-         kf1 = &fKFs.back();
+    // First keyframe with a time strictly greater than |t| => end of the segment.
+    const auto it = std::upper_bound(fTimes.cbegin(), fTimes.cend(), t);
+    SkASSERT(it != fTimes.cbegin() && it != fTimes.cend());
 
-    // Binary-search, until we reduce to sequential keyframes.
-    while (kf0 + 1 != kf1) {
-        SkASSERT(kf0 < kf1);
-        SkASSERT(kf0->t <= t && t < kf1->t);
-
-        const auto mid_kf = kf0 + (kf1 - kf0) / 2;
-
-        if (t >= mid_kf->t) {
-            kf0 = mid_kf;
-        } else {
-            kf1 = mid_kf;
-        }
-    }
-
-    return {kf0, kf1};
+    return SkToSizeT(it - fTimes.cbegin()) - 1;
 }
 
-float KeyframeAnimator::compute_weight(const KFSegment &seg, float t) const {
-    SkASSERT(seg.contains(t));
+float KeyframeAnimator::compute_weight(size_t seg, float t) const {
+    SkASSERT(this->segment_contains(seg, t));
 
     // Linear weight.
-    auto w = (t - seg.kf0->t) / (seg.kf1->t - seg.kf0->t);
+    auto w = (t - fTimes[seg]) / (fTimes[seg + 1] - fTimes[seg]);
 
     // Optional cubic mapper.
-    if (seg.kf0->mapping >= Keyframe::kCubicIndexOffset) {
-        SkASSERT(seg.kf0->v != seg.kf1->v);
-        const auto mapper_index = SkToSizeT(seg.kf0->mapping - Keyframe::kCubicIndexOffset);
-        w = fCMs[mapper_index].computeYFromX(w);
+    const auto mapping = fRecs[seg].mapping;
+    if (mapping >= Keyframe::kCubicIndexOffset) {
+        SkASSERT(fRecs[seg].v != fRecs[seg + 1].v);
+        SkASSERT(fEasing);
+        w = fEasing->eval(mapping - Keyframe::kCubicIndexOffset, w);
     }
 
     return w;
@@ -172,13 +246,12 @@ bool KeyframeAnimatorBuilder::parseKeyframes(const AnimationBuilder& abuilder,
             }
         }
 
-        fKFs.push_back({t, v, this->parseMapping(*jkf)});
+        fKFs.push_back({t, v, this->parseMapping(abuilder, *jkf)});
 
         constant_value = constant_value && (v == fKFs.front().v);
     }
 
     SkASSERT(fKFs.size() == jkfs.size());
-    fCMs.shrink_to_fit();
 
     if (constant_value) {
         // When all keyframes hold the same value, we can discard all but one
@@ -186,6 +259,18 @@ bool KeyframeAnimatorBuilder::parseKeyframes(const AnimationBuilder& abuilder,
         fKFs.resize(1);
     }
 
+    // Now that all values are known, make sure LUT easing is accurate enough for the value range
+    // of each cubic segment.
+    for (size_t i = 0; i + 1 < fKFs.size(); ++i) {
+        auto& kf = fKFs[i];
+        if (kf.mapping >= Keyframe::kCubicIndexOffset) {
+            const auto index = abuilder.easingTable()->refineForRange(
+                    kf.mapping - Keyframe::kCubicIndexOffset,
+                    this->valueRange(kf.v, fKFs[i + 1].v));
+            kf.mapping = index + Keyframe::kCubicIndexOffset;
+        }
+    }
+
 #if(DUMP_KF_RECORDS)
     SkDEBUGF("Animator[%p], values: %lu, KF records: %zu\n",
              this, fKFs.back().v_idx + 1, fKFs.size());
@@ -196,7 +281,8 @@ bool KeyframeAnimatorBuilder::parseKeyframes(const AnimationBuilder& abuilder,
     return true;
 }
 
-uint32_t KeyframeAnimatorBuilder::parseMapping(const skjson::ObjectValue& jkf) {
+uint32_t KeyframeAnimatorBuilder::parseMapping(const AnimationBuilder& abuilder,
+                                               const skjson::ObjectValue& jkf) {
     if (ParseDefault(jkf["h"], false)) {
         return Keyframe::kConstantMapping;
     }
@@ -208,15 +294,11 @@ uint32_t KeyframeAnimatorBuilder::parseMapping(const skjson::ObjectValue& jkf) {
         return Keyframe::kLinearMapping;
     }
 
-    // De-dupe sequential cubic mappers.
-    if (c0 != prev_c0 || c1 != prev_c1 || fCMs.empty()) {
-        fCMs.emplace_back(c0, c1);
-        prev_c0 = c0;
-        prev_c1 = c1;
-    }
+    // Cubic mappers are deduped at the animation level.
+    const auto& easing = abuilder.easingTable();
+    fEasing = easing;
 
-    SkASSERT(!fCMs.empty());
-    return SkToU32(fCMs.size()) - 1 + Keyframe::kCubicIndexOffset;
+    return easing->findOrAdd(c0, c1) + Keyframe::kCubicIndexOffset;
 }
 
 } // namespace skottie::internal
@@ -10,9 +10,13 @@
 
 #include "include/core/SkCubicMap.h"
 #include "include/core/SkPoint.h"
+#include "include/core/SkRefCnt.h"
 #include "include/private/SkNoncopyable.h"
+#include "include/private/SkTHash.h"
+#include "include/private/SkTPin.h"
 #include "modules/skottie/src/animator/Animator.h"
 
+#include <algorithm>
 #include <vector>
 
 namespace skjson {
@@ -46,28 +50,87 @@ struct Keyframe {
     uint32_t mapping; // Encodes the value interpolation in [KFRec_n .. KFRec_n+1):
                       //   0 -> constant
                       //   1 -> linear
-                      //   n -> cubic: cubic_mappers[n-2]
+                      //   n -> cubic: EasingTable entry n-2
 
     static constexpr uint32_t kConstantMapping  = 0;
     static constexpr uint32_t kLinearMapping    = 1;
     static constexpr uint32_t kCubicIndexOffset = 2;
 };
 
+// Cubic (Bezier) easing functions, shared by all keyframe animators of an animation.
+//
+// Evaluating an SkCubicMap requires solving the cubic on every call.  Since most animations only
+// use a handful of distinct easing curves, we dedupe them here and sample each one into a LUT
+// at build time -- seeking then reduces to a linear LUT interpolation.
+//
+// Curves which cannot be approximated accurately by a LUT (e.g. with near-vertical tangents)
+// are evaluated analytically.  So are curves easing a large enough value range for the LUT error,
+// which scales with that range, to become visible (see refineForRange()).
+class EasingTable final : public SkNVRefCnt<EasingTable> {
+public:
+    // Returns the index for the given control points, adding a new entry as needed.
+    uint32_t findOrAdd(const SkPoint& c0, const SkPoint& c1);
+
+    // Returns |index| if its LUT is accurate enough for easing values valueRange apart, or else
+    // the index of an (analytically evaluated) entry for the same curve.
+    uint32_t refineForRange(uint32_t index, float valueRange);
+
+    size_t count() const { return fEntries.size(); }
+
+    float eval(uint32_t index, float x) const {
+        SkASSERT(index < fEntries.size());
+        const auto& entry = fEntries[index];
+
+        if (entry.fLUTOffset < 0) {
+            return entry.fMap.computeYFromX(x);
+        }
+
+        const auto pos = SkTPin(x, 0.0f, 1.0f) * kLUTSegments;
+        const auto   i = std::min(static_cast<int>(pos), kLUTSegments - 1);
+        const auto* lut = fLUTs.data() + entry.fLUTOffset + i;
+
+        return lut[0] + (lut[1] - lut[0]) * (pos - i);
+    }
+
+    static constexpr int kLUTSegments = 256;
+
+private:
+    struct Key {
+        SkPoint  c0, c1;
+        uint32_t exact; // non-zero to skip the LUT
+
+        bool operator==(const Key& other) const {
+            return c0 == other.c0 && c1 == other.c1 && exact == other.exact;
+        }
+    };
+
+    uint32_t findOrAdd(const Key&);
+
+    struct Entry {
+        Key        fKey;
+        SkCubicMap fMap;
+        int        fLUTOffset; // offset into fLUTs, or -1 for analytical evaluation
+        float      fLUTError;  // max (sampled) LUT weight error
+    };
+
+    std::vector<Entry>        fEntries;
+    std::vector<float>        fLUTs;    // kLUTSegments + 1 samples per LUT entry
+    SkTHashMap<Key, uint32_t> fIndex;
+};
+
 class KeyframeAnimator : public Animator {
 public:
     ~KeyframeAnimator() override;
 
     bool isConstant() const {
-        SkASSERT(!fKFs.empty());
+        SkASSERT(!fTimes.empty());
 
         // parseKeyFrames() ensures we only keep a single frame for constant properties.
-        return fKFs.size() == 1;
+        return fTimes.size() == 1;
     }
 
 protected:
-    KeyframeAnimator(std::vector<Keyframe> kfs, std::vector<SkCubicMap> cms)
-        : fKFs(std::move(kfs))
-        , fCMs(std::move(cms)) {}
+    KeyframeAnimator(std::vector<Keyframe> kfs, sk_sp<const EasingTable> easing);
 
     struct LERPInfo {
         float           weight; // vrec0/vrec1 weight [0..1]
@@ -80,28 +143,30 @@ protected:
     LERPInfo getLERPInfo(float t) const;
 
 private:
-    // Two sequential KFRecs determine how the value varies within [kf0 .. kf1)
-    struct KFSegment {
-        const Keyframe* kf0;
-        const Keyframe* kf1;
+    // Keyframe records minus the time, which is stored separately: segment lookups only need to
+    // scan the (dense) keyframe times.
+    struct KFRec {
+        Keyframe::Value v;
+        uint32_t        mapping;
+    };
 
-        bool contains(float t) const {
-            SkASSERT(!!kf0 == !!kf1);
-            SkASSERT(!kf0 || kf1 == kf0 + 1);
+    // Two sequential keyframes determine how the value varies within [t_n .. t_n+1).
+    bool segment_contains(size_t seg, float t) const {
+        SkASSERT(seg + 1 < fTimes.size());
 
-            return kf0 && kf0->t <= t && t < kf1->t;
-        }
-    };
+        return fTimes[seg] <= t && t < fTimes[seg + 1];
+    }
 
-    // Find the KFSegment containing |t|.
-    KFSegment find_segment(float t) const;
+    // Find the segment containing |t|.
+    size_t find_segment(float t) const;
 
-    // Given a |t| and a containing KFSegment, compute the local interpolation weight.
-    float compute_weight(const KFSegment& seg, float t) const;
+    // Given a |t| and a containing segment, compute the local interpolation weight.
+    float compute_weight(size_t seg, float t) const;
 
-    const std::vector<Keyframe>   fKFs; // Keyframe records, one per AE/Lottie keyframe.
-    const std::vector<SkCubicMap> fCMs; // Optional cubic mappers (Bezier interpolation).
-    mutable KFSegment             fCurrentSegment = { nullptr, nullptr }; // Cached segment.
+    std::vector<float>             fTimes;   // Keyframe times, one per AE/Lottie keyframe.
+    std::vector<KFRec>             fRecs;    // Keyframe value and mapping, parallel to fTimes.
+    const sk_sp<const EasingTable> fEasing;  // Optional cubic mappers (Bezier interpolation).
+    mutable size_t                 fCurrentSegment = 0; // Cached segment (index into fTimes).
 };
 
 class KeyframeAnimatorBuilder : public SkNoncopyable {
@@ -120,15 +185,15 @@ protected:
 
     bool parseKeyframes(const AnimationBuilder&, const skjson::ArrayValue&);
 
-    std::vector<Keyframe>   fKFs; // Keyframe records, one per AE/Lottie keyframe.
-    std::vector<SkCubicMap> fCMs; // Optional cubic mappers (Bezier interpolation).
+    // The largest component difference between two parsed keyframe values, used to bound the
+    // visible error of LUT easing.  Builders for non-numeric values can keep the default.
+    virtual float valueRange(const Keyframe::Value&, const Keyframe::Value&) const { return 0; }
 
-private:
-    uint32_t parseMapping(const skjson::ObjectValue&);
+    std::vector<Keyframe>    fKFs;    // Keyframe records, one per AE/Lottie keyframe.
+    sk_sp<const EasingTable> fEasing; // Cubic mappers, shared at the animation level.
 
-    // Track previous cubic map parameters (for deduping).
-    SkPoint prev_c0 = { 0, 0 },
-            prev_c1 = { 0, 0 };
+private:
+    uint32_t parseMapping(const AnimationBuilder&, const skjson::ObjectValue&);
 };
 
 template <typename T>
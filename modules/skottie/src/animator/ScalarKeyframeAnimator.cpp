@@ -10,6 +10,8 @@
 #include "modules/skottie/src/animator/Animator.h"
 #include "modules/skottie/src/animator/KeyframeAnimator.h"
 
+#include <cmath>
+
 namespace skottie::internal {
 
 namespace  {
@@ -29,7 +31,7 @@ public:
             }
 
             return sk_sp<ScalarKeyframeAnimator>(
-                        new ScalarKeyframeAnimator(std::move(fKFs), std::move(fCMs), fTarget));
+                        new ScalarKeyframeAnimator(std::move(fKFs), std::move(fEasing), fTarget));
         }
 
         bool parseValue(const AnimationBuilder&, const skjson::Value& jv) const override {
@@ -44,14 +46,18 @@ public:
             return Parse(jv, &v->flt);
         }
 
+        float valueRange(const Keyframe::Value& v0, const Keyframe::Value& v1) const override {
+            return std::abs(v1.flt - v0.flt);
+        }
+
         ScalarValue* fTarget;
     };
 
 private:
     ScalarKeyframeAnimator(std::vector<Keyframe> kfs,
-                           std::vector<SkCubicMap> cms,
+                           sk_sp<const EasingTable> easing,
                            ScalarValue* target_value)
-        : INHERITED(std::move(kfs), std::move(cms))
+        : INHERITED(std::move(kfs), std::move(easing))
         , fTarget(target_value) {}
 
     StateChanged onSeek(float t) override {
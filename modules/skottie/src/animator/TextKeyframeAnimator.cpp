@@ -32,7 +32,7 @@ public:
 
             return sk_sp<TextKeyframeAnimator>(
                         new TextKeyframeAnimator(std::move(fKFs),
-                                                 std::move(fCMs),
+                                                 std::move(fEasing),
                                                  std::move(fValues),
                                                  fTarget));
         }
@@ -66,9 +66,9 @@ public:
     };
 
 private:
-    TextKeyframeAnimator(std::vector<Keyframe> kfs, std::vector<SkCubicMap> cms,
+    TextKeyframeAnimator(std::vector<Keyframe> kfs, sk_sp<const EasingTable> easing,
                          std::vector<TextValue> vs, TextValue* target_value)
-        : INHERITED(std::move(kfs), std::move(cms))
+        : INHERITED(std::move(kfs), std::move(easing))
         , fValues(std::move(vs))
         , fTarget(target_value) {}
 
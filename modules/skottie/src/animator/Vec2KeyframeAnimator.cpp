@@ -44,7 +44,7 @@ public:
 
             return sk_sp<Vec2KeyframeAnimator>(
                         new Vec2KeyframeAnimator(std::move(fKFs),
-                                                 std::move(fCMs),
+                                                 std::move(fEasing),
                                                  std::move(fValues),
                                                  fVecTarget,
                                                  fRotTarget));
@@ -124,6 +124,17 @@ public:
             return true;
         }
 
+        float valueRange(const Keyframe::Value& kfv0, const Keyframe::Value& kfv1) const override {
+            const auto& v0 = fValues[kfv0.idx];
+            const auto& v1 = fValues[kfv1.idx];
+
+            // Spatial keyframes ease the distance along their path.
+            if (v0.cmeasure) {
+                return v0.cmeasure->length();
+            }
+            return std::max(std::abs(v1.v2.x - v0.v2.x), std::abs(v1.v2.y - v0.v2.y));
+        }
+
         std::vector<SpatialValue> fValues;
         Vec2Value*                fVecTarget; // required
         float*                    fRotTarget; // optional
@@ -133,9 +144,9 @@ public:
     };
 
 private:
-    Vec2KeyframeAnimator(std::vector<Keyframe> kfs, std::vector<SkCubicMap> cms,
+    Vec2KeyframeAnimator(std::vector<Keyframe> kfs, sk_sp<const EasingTable> easing,
                          std::vector<SpatialValue> vs, Vec2Value* vec_target, float* rot_target)
-        : INHERITED(std::move(kfs), std::move(cms))
+        : INHERITED(std::move(kfs), std::move(easing))
         , fValues(std::move(vs))
         , fVecTarget(vec_target)
         , fRotTarget(rot_target) {}
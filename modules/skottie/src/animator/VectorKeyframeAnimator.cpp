@@ -16,6 +16,7 @@
 #include "src/core/SkSafeMath.h"
 
 #include <algorithm>
+#include <cmath>
 #include <cstring>
 
 namespace skottie {
@@ -73,11 +74,11 @@ namespace {
 class VectorKeyframeAnimator final : public KeyframeAnimator {
 public:
     VectorKeyframeAnimator(std::vector<Keyframe> kfs,
-                           std::vector<SkCubicMap> cms,
+                           sk_sp<const EasingTable> easing,
                            std::vector<float> storage,
                            size_t vec_len,
                            std::vector<float>* target_value)
-        : INHERITED(std::move(kfs), std::move(cms))
+        : INHERITED(std::move(kfs), std::move(easing))
         , fStorage(std::move(storage))
         , fVecLen(vec_len)
         , fTarget(target_value) {
@@ -180,7 +181,7 @@ sk_sp<KeyframeAnimator> VectorKeyframeAnimatorBuilder::make(const AnimationBuild
 
     return sk_sp<VectorKeyframeAnimator>(
                 new VectorKeyframeAnimator(std::move(fKFs),
-                                           std::move(fCMs),
+                                           std::move(fEasing),
                                            std::move(fStorage),
                                            fVecLen,
                                            fTarget));
@@ -226,6 +227,21 @@ bool VectorKeyframeAnimatorBuilder::parseKFValue(const AnimationBuilder&,
     return true;
 }
 
+float VectorKeyframeAnimatorBuilder::valueRange(const Keyframe::Value& kfv0,
+                                                const Keyframe::Value& kfv1) const {
+    SkASSERT(kfv0.idx + fVecLen <= fStorage.size());
+    SkASSERT(kfv1.idx + fVecLen <= fStorage.size());
+
+    const auto* v0 = fStorage.data() + kfv0.idx;
+    const auto* v1 = fStorage.data() + kfv1.idx;
+
+    float range = 0;
+    for (size_t i = 0; i < fVecLen; ++i) {
+        range = std::max(range, std::abs(v1[i] - v0[i]));
+    }
+    return range;
+}
+
 template <>
 bool AnimatablePropertyContainer::bind<VectorValue>(const AnimationBuilder& abuilder,
                                                     const skjson::ObjectValue* jprop,
@@ -26,6 +26,8 @@ public:
 private:
     bool parseValue(const AnimationBuilder&, const skjson::Value&) const override;
 
+    float valueRange(const Keyframe::Value&, const Keyframe::Value&) const override;
+
     bool parseKFValue(const AnimationBuilder&,
                       const skjson::ObjectValue&,
                       const skjson::Value&,
@@ -20,10 +20,97 @@
 #include "modules/sksg/include/SkSGRenderEffect.h"
 #include "modules/sksg/include/SkSGText.h"
 #include "modules/sksg/include/SkSGTransform.h"
+#include "src/core/SkLRUCache.h"
+#include "src/core/SkOpts.h"
 
 namespace skottie {
 namespace internal {
 
+// LRU cache of shaping results, keyed on the shaping-relevant text properties only:
+// paint properties (colors, stroke width, paint order) do not affect shaping.
+class TextAdapter::ShapeCache final {
+public:
+    const Shaper::Result* find(const TextValue& txt) {
+        return fCache.find(Key(txt));
+    }
+
+    const Shaper::Result& insert(const TextValue& txt, Shaper::Result&& result) {
+        return *fCache.insert(Key(txt), std::move(result));
+    }
+
+private:
+    struct Key {
+        explicit Key(const TextValue& txt)
+            : fTypeface(txt.fTypeface)
+            , fText(txt.fText)
+            , fTextSize(txt.fTextSize)
+            , fLineHeight(txt.fLineHeight)
+            , fLineShift(txt.fLineShift)
+            , fAscent(txt.fAscent)
+            , fBox(txt.fBox)
+            , fHAlign(txt.fHAlign)
+            , fVAlign(txt.fVAlign)
+            , fResize(txt.fResize)
+            , fLineBreak(txt.fLineBreak)
+            , fDirection(txt.fDirection) {}
+
+        bool operator==(const Key& other) const {
+            return fTypeface   == other.fTypeface
+                && fText       == other.fText
+                && fTextSize   == other.fTextSize
+                && fLineHeight == other.fLineHeight
+                && fLineShift  == other.fLineShift
+                && fAscent     == other.fAscent
+                && fBox        == other.fBox
+                && fHAlign     == other.fHAlign
+                && fVAlign     == other.fVAlign
+                && fResize     == other.fResize
+                && fLineBreak  == other.fLineBreak
+                && fDirection  == other.fDirection;
+        }
+
+        sk_sp<SkTypeface>       fTypeface;
+        SkString                fText;
+        float                   fTextSize,
+                                fLineHeight,
+                                fLineShift,
+                                fAscent;
+        SkRect                  fBox;
+        SkTextUtils::Align      fHAlign;
+        Shaper::VAlign          fVAlign;
+        Shaper::ResizePolicy    fResize;
+        Shaper::LinebreakPolicy fLineBreak;
+        Shaper::Direction       fDirection;
+    };
+
+    struct KeyHash {
+        uint32_t operator()(const Key& k) const {
+            const float metrics[] = {
+                k.fTextSize, k.fLineHeight, k.fLineShift, k.fAscent,
+                k.fBox.fLeft, k.fBox.fTop, k.fBox.fRight, k.fBox.fBottom,
+            };
+            const uint8_t policies[] = {
+                static_cast<uint8_t>(k.fHAlign),
+                static_cast<uint8_t>(k.fVAlign),
+                static_cast<uint8_t>(k.fResize),
+                static_cast<uint8_t>(k.fLineBreak),
+                static_cast<uint8_t>(k.fDirection),
+            };
+
+            auto hash = SkOpts::hash(k.fText.c_str(), k.fText.size(),
+                                     k.fTypeface ? k.fTypeface->uniqueID() : 0);
+            hash = SkOpts::hash(metrics, sizeof(metrics), hash);
+            return SkOpts::hash(policies, sizeof(policies), hash);
+        }
+    };
+
+    // Shaping results hold one blob per fragment, and fragments are per-glyph when animated:
+    // keep the cache small.
+    static constexpr int kMaxEntries = 16;
+
+    SkLRUCache<Key, Shaper::Result, KeyHash> fCache{kMaxEntries};
+};
+
 sk_sp<TextAdapter> TextAdapter::Make(const skjson::ObjectValue& jlayer,
                                      const AnimationBuilder* abuilder,
                                      sk_sp<SkFontMgr> fontmgr, sk_sp<Logger> logger) {
@@ -111,6 +198,7 @@ TextAdapter::TextAdapter(sk_sp<SkFontMgr> fontmgr, sk_sp<Logger> logger, AnchorP
     , fFontMgr(std::move(fontmgr))
     , fLogger(std::move(logger))
     , fAnchorPointGrouping(apg)
+    , fShapeCache(std::make_unique<ShapeCache>())
     , fHasBlurAnimator(false)
     , fRequiresAnchorPoint(false) {}
 
@@ -132,6 +220,7 @@ void TextAdapter::addFragment(const Shaper::Fragment& frag) {
     rec.fOrigin     = frag.fPos;
     rec.fAdvance    = frag.fAdvance;
     rec.fAscent     = frag.fAscent;
+    rec.fBlobNode   = blob_node;
     rec.fMatrixNode = sksg::Matrix<SkM44>::Make(SkM44::Translate(frag.fPos.x(), frag.fPos.y()));
 
     std::vector<sk_sp<sksg::RenderNode>> draws;
@@ -190,6 +279,25 @@ void TextAdapter::addFragment(const Shaper::Fragment& frag) {
     fFragments.push_back(std::move(rec));
 }
 
+void TextAdapter::updateFragment(const Shaper::Fragment& frag, FragmentRec* rec) const {
+    // Only the per-fragment state is refreshed: the SG structure is preserved, and unchanged
+    // values do not trigger invalidations.
+    rec->fOrigin  = frag.fPos;
+    rec->fAdvance = frag.fAdvance;
+    rec->fAscent  = frag.fAscent;
+
+    rec->fBlobNode->setBlob(frag.fBlob);
+    rec->fMatrixNode->setMatrix(SkM44::Translate(frag.fPos.x(), frag.fPos.y()));
+
+    if (rec->fFillColorNode) {
+        rec->fFillColorNode->setColor(fText->fFillColor);
+    }
+    if (rec->fStrokeColorNode) {
+        rec->fStrokeColorNode->setColor(fText->fStrokeColor);
+        rec->fStrokeColorNode->setStrokeWidth(fText->fStrokeWidth);
+    }
+}
+
 void TextAdapter::buildDomainMaps(const Shaper::Result& shape_result) {
     fMaps.fNonWhitespaceMap.clear();
     fMaps.fWordsMap.clear();
@@ -265,25 +373,35 @@ uint32_t TextAdapter::shaperFlags() const {
     return flags;
 }
 
-void TextAdapter::reshape() {
-    const Shaper::TextDesc text_desc = {
-        fText->fTypeface,
-        fText->fTextSize,
-        fText->fLineHeight,
-        fText->fLineShift,
-        fText->fAscent,
-        fText->fHAlign,
-        fText->fVAlign,
-        fText->fResize,
-        fText->fLineBreak,
-        fText->fDirection,
-        this->shaperFlags(),
-    };
-    const auto shape_result = Shaper::Shape(fText->fText, text_desc, fText->fBox, fFontMgr);
+const Shaper::Result& TextAdapter::shape() {
+    const auto* shape_result = fShapeCache->find(fText.fCurrentValue);
 
-    if (fLogger && shape_result.fMissingGlyphCount > 0) {
+    if (shape_result) {
+        fStats.fShapeCacheHits++;
+    } else {
+        const Shaper::TextDesc text_desc = {
+            fText->fTypeface,
+            fText->fTextSize,
+            fText->fLineHeight,
+            fText->fLineShift,
+            fText->fAscent,
+            fText->fHAlign,
+            fText->fVAlign,
+            fText->fResize,
+            fText->fLineBreak,
+            fText->fDirection,
+            this->shaperFlags(),
+        };
+        shape_result = &fShapeCache->insert(fText.fCurrentValue,
+                                            Shaper::Shape(fText->fText, text_desc, fText->fBox,
+                                                          fFontMgr));
+        fStats.fShapeCacheMisses++;
+    }
+
+    // The missing glyph count is cached with the result, so cache hits warn just like misses.
+    if (fLogger && shape_result->fMissingGlyphCount > 0) {
         const auto msg = SkStringPrintf("Missing %zu glyphs for '%s'.",
-                                        shape_result.fMissingGlyphCount,
+                                        shape_result->fMissingGlyphCount,
                                         fText->fText.c_str());
         fLogger->log(Logger::Level::kWarning, msg.c_str());
 
@@ -292,14 +410,38 @@ void TextAdapter::reshape() {
         fLogger = nullptr;
     }
 
-    // Rebuild all fragments.
-    // TODO: we can be smarter here and try to reuse the existing SG structure if needed.
+    return *shape_result;
+}
+
+bool TextAdapter::canReuseFragments(const Shaper::Result& shape_result) const {
+    return !fFragments.empty()
+        && fFragments.size()          == shape_result.fFragments.size()
+        && fFragmentPaint.fPaintOrder == fText->fPaintOrder
+        && fFragmentPaint.fHasFill    == fText->fHasFill
+        && fFragmentPaint.fHasStroke  == fText->fHasStroke;
+}
+
+void TextAdapter::reshape() {
+    const auto& shape_result = this->shape();
+
+    if (this->canReuseFragments(shape_result)) {
+        // Same fragment structure (e.g. paint-only changes, or same-length text):
+        // update the existing SG fragments in place.
+        for (size_t i = 0; i < fFragments.size(); ++i) {
+            this->updateFragment(shape_result.fFragments[i], &fFragments[i]);
+        }
+    } else {
+        // Rebuild all fragments.
+        fStats.fFragmentRebuilds++;
+        fRoot->clear();
+        fFragments.clear();
+        fFragments.reserve(shape_result.fFragments.size());
 
-    fRoot->clear();
-    fFragments.clear();
+        fFragmentPaint = { fText->fPaintOrder, fText->fHasFill, fText->fHasStroke };
 
-    for (const auto& frag : shape_result.fFragments) {
-        this->addFragment(frag);
+        for (const auto& frag : shape_result.fFragments) {
+            this->addFragment(frag);
+        }
     }
 
     if (!fAnimators.empty()) {
@@ -344,8 +486,8 @@ void TextAdapter::onSync() {
     seed_props.fill_color   = fText->fFillColor;
     seed_props.stroke_color = fText->fStrokeColor;
 
-    TextAnimator::ModulatorBuffer buf;
-    buf.resize(fFragments.size(), { seed_props, 0 });
+    auto& buf = fModulatorBuffer;
+    buf.assign(fFragments.size(), { seed_props, 0 });
 
     // Apply all animators to the modulator buffer.
     for (const auto& animator : fAnimators) {
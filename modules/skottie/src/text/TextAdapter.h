@@ -13,6 +13,7 @@
 #include "modules/skottie/src/text/TextAnimator.h"
 #include "modules/skottie/src/text/TextValue.h"
 
+#include <memory>
 #include <vector>
 
 class SkFontMgr;
@@ -22,6 +23,7 @@ class BlurImageFilter;
 class Group;
 template <typename T>
 class Matrix;
+class TextBlob;
 } // namespace sksg
 
 namespace skottie {
@@ -39,6 +41,14 @@ public:
     const TextValue& getText() const { return fText.fCurrentValue; }
     void setText(const TextValue&);
 
+    // Shaping cache and fragment reuse counters (for tests).
+    struct Stats {
+        size_t fShapeCacheHits   = 0,
+               fShapeCacheMisses = 0,
+               fFragmentRebuilds = 0;
+    };
+    const Stats& stats() const { return fStats; }
+
 protected:
     void onSync() override;
 
@@ -55,6 +65,7 @@ private:
     struct FragmentRec {
         SkPoint                      fOrigin; // fragment position
 
+        sk_sp<sksg::TextBlob>        fBlobNode;
         sk_sp<sksg::Matrix<SkM44>>   fMatrixNode;
         sk_sp<sksg::Color>           fFillColorNode,
                                      fStrokeColorNode;
@@ -64,8 +75,13 @@ private:
                                      fAscent;  // ^
     };
 
+    class ShapeCache;
+
     void reshape();
+    const Shaper::Result& shape();
+    bool canReuseFragments(const Shaper::Result&) const;
     void addFragment(const Shaper::Fragment&);
+    void updateFragment(const Shaper::Fragment&, FragmentRec*) const;
     void buildDomainMaps(const Shaper::Result&);
 
     void pushPropsToFragment(const TextAnimator::ResolvedProps&, const FragmentRec&,
@@ -89,6 +105,22 @@ private:
     std::vector<FragmentRec>         fFragments;
     TextAnimator::DomainMaps         fMaps;
 
+    // Shaping results for recently seen text values (shaping is by far the most expensive part
+    // of a text update, and animated text documents tend to cycle through a few values).
+    std::unique_ptr<ShapeCache>      fShapeCache;
+
+    Stats                            fStats;
+
+    // Scratch buffer, reused across syncs.
+    TextAnimator::ModulatorBuffer    fModulatorBuffer;
+
+    // Paint configuration for the current fragments: changes require a fragment rebuild.
+    struct FragmentPaint {
+        TextPaintOrder fPaintOrder = TextPaintOrder::kFillStroke;
+        bool           fHasFill    = false,
+                       fHasStroke  = false;
+    } fFragmentPaint;
+
     // Helps detect external value changes.
     struct TextValueTracker {
         TextValue fCurrentValue;
@@ -5,6 +5,7 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkCubicMap.h"
 #include "modules/skottie/include/ExternalLayer.h"
 #include "modules/skottie/src/SkottiePriv.h"
 #include "modules/skottie/src/SkottieValue.h"
@@ -134,4 +135,71 @@ DEF_TEST(Skottie_Keyframe, reporter) {
         REPORTER_ASSERT(reporter, SkScalarNearlyEqual(prop(3  ), 4));
         REPORTER_ASSERT(reporter, SkScalarNearlyEqual(prop(4  ), 4));
     }
+    {
+        // Cubic easing, including a steep curve (near-vertical end tangent).
+        MockProperty<ScalarValue> prop(R"({
+                                         "a": 1,
+                                         "k": [
+                                           { "t":  0, "s": 0,
+                                             "o": { "x": 0.42, "y": 0 },
+                                             "i": { "x": 0.58, "y": 1 } },
+                                           { "t":  4, "s": 100,
+                                             "o": { "x": 0.9, "y": 0 },
+                                             "i": { "x": 1, "y": 0 } },
+                                           { "t":  8, "s": 0,
+                                             "o": { "x": 0.42, "y": 0 },
+                                             "i": { "x": 0.58, "y": 1 } },
+                                           { "t": 12, "s": 100 }
+                                         ]
+                                       })");
+        REPORTER_ASSERT(reporter, prop);
+
+        const SkCubicMap ease({0.42f, 0}, {0.58f, 1}),
+                         steep({0.9f, 0}, {1, 0});
+
+        auto check = [&](float t) {
+            float expected;
+            if (t < 4) {
+                expected = 100 * ease.computeYFromX(t / 4);
+            } else if (t < 8) {
+                expected = 100 - 100 * steep.computeYFromX((t - 4) / 4);
+            } else {
+                expected = 100 * ease.computeYFromX((t - 8) / 4);
+            }
+            REPORTER_ASSERT(reporter, SkScalarNearlyEqual(prop(t), expected, 0.05f),
+                            "t: %f, value: %f, expected: %f", t, prop(t), expected);
+        };
+
+        // Sequential, reverse and random access.
+        for (float t = 0; t < 12; t += 0.125f) {
+            check(t);
+        }
+        for (float t = 12; t > 0; t -= 0.375f) {
+            check(t);
+        }
+        for (float t : {11.9f, 0.1f, 6.3f, 2.2f, 7.99f, 4.01f}) {
+            check(t);
+        }
+    }
+    {
+        // Cubic easing over a large value range: LUT errors scale with the range, so this must
+        // still match the exact curve closely.
+        MockProperty<ScalarValue> prop(R"({
+                                         "a": 1,
+                                         "k": [
+                                           { "t":  0, "s": 0,
+                                             "o": { "x": 0.42, "y": 0 },
+                                             "i": { "x": 0.58, "y": 1 } },
+                                           { "t":  4, "s": 100000 }
+                                         ]
+                                       })");
+        REPORTER_ASSERT(reporter, prop);
+
+        const SkCubicMap ease({0.42f, 0}, {0.58f, 1});
+        for (float t = 0; t < 4; t += 0.0625f) {
+            const float expected = 100000 * ease.computeYFromX(t / 4);
+            REPORTER_ASSERT(reporter, SkScalarNearlyEqual(prop(t), expected, 1.0f / 32),
+                            "t: %f, value: %f, expected: %f", t, prop(t), expected);
+        }
+    }
 }
@@ -6,12 +6,19 @@
  */
 
 #include <unordered_map>
+#include <utility>
 
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
 #include "include/core/SkFontMgr.h"
 #include "include/core/SkFontStyle.h"
 #include "modules/skottie/include/Skottie.h"
 #include "modules/skottie/include/SkottieProperty.h"
+#include "modules/skottie/src/SkottiePriv.h"
+#include "modules/skottie/src/text/TextAdapter.h"
+#include "src/utils/SkJSON.h"
 #include "tests/Test.h"
+#include "tools/fonts/TestFontMgr.h"
 
 using namespace skottie;
 
@@ -144,3 +151,91 @@ DEF_TEST(Skottie_Text_Style, r) {
         REPORTER_ASSERT(r, style->slant () == exp.slant );
     }
 }
+
+// Text document keyframes cycling through a few values, including a paint-only change:
+// (cached) reshaping must produce the same results as a fresh shaping pass.
+DEF_TEST(Skottie_Text_DocumentKeyframes, r) {
+    static constexpr char json[] =
+        R"({
+             "v": "5.2.1",
+             "w": 100,
+             "h": 100,
+             "fr": 1,
+             "ip": 0,
+             "op": 3,
+             "fonts": {
+               "list": [
+                 { "fName": "f1", "fFamily": "f1", "fStyle": "Regular" }
+               ]
+             },
+             "layers": [
+               {
+                 "ty": 5,
+                 "ip": 0,
+                 "op": 3,
+                 "ks": { "p": { "a": 0, "k": [10, 60] } },
+                 "t": {
+                   "d": {
+                     "k": [
+                       { "t": 0, "s": { "f": "f1", "s": 40, "t": "AB", "fc": [1, 0, 0] } },
+                       { "t": 1, "s": { "f": "f1", "s": 40, "t": "BA", "fc": [1, 0, 0] } },
+                       { "t": 2, "s": { "f": "f1", "s": 40, "t": "AB", "fc": [0, 0, 1] } }
+                     ]
+                   }
+                 }
+               }
+             ]
+           })";
+
+    SkMemoryStream stream(json, strlen(json));
+    auto anim = Animation::Builder()
+                    .setFontManager(ToolUtils::MakePortableFontMgr())
+                    .make(&stream);
+    REPORTER_ASSERT(r, anim);
+    if (!anim) {
+        return;
+    }
+
+    auto render_frame = [&](double frame) {
+        SkBitmap bm;
+        bm.allocN32Pixels(100, 100);
+        bm.eraseColor(SK_ColorTRANSPARENT);
+
+        SkCanvas canvas(bm);
+        anim->seekFrame(frame);
+        anim->render(&canvas);
+
+        return bm;
+    };
+
+    auto same_pixels = [](const SkBitmap& a, const SkBitmap& b) {
+        return !memcmp(a.getPixels(), b.getPixels(), a.computeByteSize());
+    };
+
+    // Returns the accumulated {red, blue} channel values.
+    auto channel_sums = [](const SkBitmap& bm) {
+        uint64_t red = 0, blue = 0;
+        for (int y = 0; y < bm.height(); ++y) {
+            for (int x = 0; x < bm.width(); ++x) {
+                const auto c = bm.getColor(x, y);
+                red  += SkColorGetR(c);
+                blue += SkColorGetB(c);
+            }
+        }
+        return std::make_pair(red, blue);
+    };
+
+    const auto f0 = render_frame(0),
+               f1 = render_frame(1),
+               f2 = render_frame(2),
+               f3 = render_frame(0);
+
+    REPORTER_ASSERT(r,  same_pixels(f0, f3));
+    REPORTER_ASSERT(r, !same_pixels(f0, f1));
+
+    const auto sums0 = channel_sums(f0),
+               sums2 = channel_sums(f2);
+    REPORTER_ASSERT(r, sums0.first  >  0 && sums0.second == 0);
+    REPORTER_ASSERT(r, sums2.first  == 0 && sums2.second >  0);
+    REPORTER_ASSERT(r, sums0.first  == sums2.second);
+}
@@ -7,6 +7,10 @@
 
 #include "modules/skottie/utils/SkottieUtils.h"
 
+#include "include/private/SkMutex.h"
+#include "include/private/SkTo.h"
+#include "src/core/SkTaskGroup.h"
+
 namespace skottie_utils {
 
 class CustomPropertyManager::PropertyInterceptor final : public skottie::PropertyObserver {
@@ -241,4 +245,74 @@ sk_sp<skottie::ExternalLayer> ExternalAnimationPrecompInterceptor::onLoadPrecomp
                 : nullptr;
 }
 
+namespace {
+
+// Animation instances available for reuse, for a given source animation.
+class InstancePool {
+public:
+    explicit InstancePool(sk_sp<skottie::Animation> instance) {
+        fInstances.push_back(std::move(instance));
+    }
+
+    sk_sp<skottie::Animation> acquire(const skottie::Animation& source) {
+        {
+            SkAutoMutexExclusive lock(fMutex);
+            if (!fInstances.empty()) {
+                auto instance = std::move(fInstances.back());
+                fInstances.pop_back();
+                return instance;
+            }
+        }
+
+        // Instantiate outside the lock, to allow concurrent builds.
+        return source.makeInstance();
+    }
+
+    void release(sk_sp<skottie::Animation> instance) {
+        SkAutoMutexExclusive lock(fMutex);
+        fInstances.push_back(std::move(instance));
+    }
+
+private:
+    SkMutex                                fMutex;
+    std::vector<sk_sp<skottie::Animation>> fInstances SK_GUARDED_BY(fMutex);
+};
+
+} // namespace
+
+bool RenderFrames(SkExecutor& executor, const std::vector<FrameRequest>& requests,
+                  const FrameDrawFunc& draw) {
+    // The pool map is fully populated upfront, and only read by the tasks.
+    std::unordered_map<const skottie::Animation*, std::unique_ptr<InstancePool>> pools;
+    for (const auto& request : requests) {
+        if (!request.fAnimation) {
+            return false;
+        }
+        if (pools.find(request.fAnimation.get()) != pools.end()) {
+            continue;
+        }
+
+        // Seed each pool with one instance, which also validates instancing support.
+        auto instance = request.fAnimation->makeInstance();
+        if (!instance) {
+            return false;
+        }
+        pools.emplace(request.fAnimation.get(), std::make_unique<InstancePool>(std::move(instance)));
+    }
+
+    SkTaskGroup tg(executor);
+    tg.batch(SkToInt(requests.size()), [&](int i) {
+        const auto& request = requests[i];
+        auto* pool = pools.find(request.fAnimation.get())->second.get();
+
+        auto instance = pool->acquire(*request.fAnimation);
+        instance->seekFrame(request.fFrame);
+        draw(i, *instance);
+        pool->release(std::move(instance));
+    });
+    tg.wait();
+
+    return true;
+}
+
 } // namespace skottie_utils
@@ -12,11 +12,14 @@
 #include "modules/skottie/include/Skottie.h"
 #include "modules/skottie/include/SkottieProperty.h"
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+class SkExecutor;
+
 namespace skottie_utils {
 
 /**
@@ -126,6 +129,29 @@ private:
     const SkString                             fPrefix;
 };
 
+struct FrameRequest {
+    sk_sp<skottie::Animation> fAnimation;
+    double                    fFrame;     // frame index, as in Animation::seekFrame()
+};
+
+using FrameDrawFunc = std::function<void(size_t request_index, const skottie::Animation&)>;
+
+/**
+ * Seeks and renders a batch of animation frames concurrently, on the given executor.
+ *
+ * Requests may reference any number of animations, which must have been built with
+ * Animation::Builder::kEnableInstancing.  Each task seeks its own animation instance (see
+ * Animation::makeInstance()), and instances are recycled across the tasks of a batch: the
+ * requested animations themselves are never seeked.
+ *
+ * |draw| is invoked once per request, on an arbitrary thread, with the request index and an
+ * instance already seeked to the requested frame.  It is expected to render the instance
+ * (e.g. via Animation::render()) to a destination owned by that request.
+ *
+ * Blocks until all frames have been drawn.  Returns false (without drawing anything) if any of
+ * the requested animations cannot be instantiated.
+ */
+bool RenderFrames(SkExecutor&, const std::vector<FrameRequest>&, const FrameDrawFunc&);
 
 } // namespace skottie_utils
 
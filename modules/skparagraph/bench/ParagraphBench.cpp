@@ -11,9 +11,12 @@
 #include "modules/skparagraph/src/ParagraphImpl.h"
 #include "tools/Resources.h"
 
+#include <algorithm>
 #include <cfloat>
+#include <vector>
 #include "include/core/SkPictureRecorder.h"
 #include "modules/skparagraph/utils/TestFontCollection.h"
+#include "src/core/SkTaskGroup.h"
 
 using namespace skia::textlayout;
 namespace {
@@ -46,15 +49,232 @@ struct ParagraphBench : public Benchmark {
         SkCanvas* canvas = rec.beginRecording({0,0, 2000,3000});
         while (loops-- > 0) {
             paragraph->layout(fWidth);
-            auto impl = static_cast<ParagraphImpl*>(paragraph.get());
             paragraph->paint(canvas, 0, 0);
             paragraph->markDirty();
-            impl->resetCache();
+            fontCollection->getParagraphCache()->reset();
         }
     }
 };
+
+// Lays out the same set of paragraphs from several threads sharing one FontCollection
+// (and thus one ParagraphCache): after the first pass, every layout should be a cache hit.
+struct ParagraphCacheBench : public Benchmark {
+    ParagraphCacheBench(int threads)
+            : fThreads(threads)
+            , fName(SkStringPrintf("paragraph_cache_shared_%dthreads", threads)) {}
+
+    const char* onGetName() override { return fName.c_str(); }
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+
+    void onDelayedSetup() override {
+        auto data = GetResourceAsData("text/english.txt");
+        if (!data) {
+            return;
+        }
+
+        // One paragraph per non-empty line.
+        const char* text = static_cast<const char*>(data->data());
+        const char* end  = text + data->size();
+        while (text < end) {
+            const char* eol = std::find(text, end, '\n');
+            if (eol > text) {
+                fParagraphs.emplace_back(text, eol - text);
+            }
+            text = eol + 1;
+        }
+
+        fFontCollection = sk_make_sp<FontCollection>();
+        fFontCollection->setDefaultFontManager(SkFontMgr::RefDefault());
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        if (fParagraphs.empty()) {
+            return;
+        }
+
+        ParagraphStyle paragraph_style;
+        paragraph_style.turnHintingOff();
+
+        SkTaskGroup tg;
+        while (loops-- > 0) {
+            tg.batch(fThreads, [&](int thread) {
+                // Stagger the starting point so threads contend for different shards.
+                const size_t count = fParagraphs.size();
+                for (size_t i = 0; i < count; ++i) {
+                    const auto& text = fParagraphs[(i + thread * count / fThreads) % count];
+                    ParagraphBuilderImpl builder(paragraph_style, fFontCollection);
+                    builder.addText(text.c_str(), text.size());
+                    builder.Build()->layout(500);
+                }
+            });
+            tg.wait();
+        }
+    }
+
+private:
+    const int                fThreads;
+    const SkString           fName;
+    std::vector<SkString>    fParagraphs;
+    sk_sp<FontCollection>    fFontCollection;
+};
+
+// ~100KB document built from repeated copies of the english sample text.
+static std::vector<SkString> make_document(size_t minBytes) {
+    std::vector<SkString> lines;
+    auto data = GetResourceAsData("text/english.txt");
+    if (!data) {
+        return lines;
+    }
+
+    const char* start = static_cast<const char*>(data->data());
+    const char* end   = start + data->size();
+    size_t bytes = 0;
+    while (bytes < minBytes) {
+        for (const char* text = start; text < end && bytes < minBytes;) {
+            const char* eol = std::find(text, end, '\n');
+            if (eol > text) {
+                lines.emplace_back(text, eol - text);
+                bytes += eol - text + 1;
+            }
+            text = eol + 1;
+        }
+    }
+    return lines;
+}
+
+static sk_sp<FontCollection> make_uncached_font_collection() {
+    auto fontCollection = sk_make_sp<FontCollection>();
+    fontCollection->setDefaultFontManager(SkFontMgr::RefDefault());
+    // Measure layout itself, not ParagraphCache lookups.
+    fontCollection->getParagraphCache()->turnOn(false);
+    return fontCollection;
+}
+
+// Window resize: lay out the whole document at alternating widths.
+// Incremental mode reuses shaping and clusters; full mode forces reshaping each time.
+struct ParagraphResizeBench : public Benchmark {
+    ParagraphResizeBench(bool incremental)
+            : fIncremental(incremental)
+            , fName(incremental ? "paragraph_resize_100KB" : "paragraph_resize_100KB_full") {}
+
+    const char* onGetName() override { return fName; }
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+
+    void onDelayedSetup() override {
+        auto lines = make_document(100 * 1024);
+        if (lines.empty()) {
+            return;
+        }
+
+        auto fontCollection = make_uncached_font_collection();
+        ParagraphStyle paragraph_style;
+        paragraph_style.turnHintingOff();
+        for (const auto& line : lines) {
+            ParagraphBuilderImpl builder(paragraph_style, fontCollection);
+            builder.addText(line.c_str(), line.size());
+            fParagraphs.push_back(builder.Build());
+            fParagraphs.back()->layout(kWidths[0]);
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; ++i) {
+            const auto width = kWidths[(i + 1) % SK_ARRAY_COUNT(kWidths)];
+            for (auto& paragraph : fParagraphs) {
+                if (!fIncremental) {
+                    paragraph->markDirty();
+                }
+                paragraph->layout(width);
+            }
+        }
+    }
+
+private:
+    static constexpr SkScalar kWidths[] = { 800, 640 };
+
+    const bool                              fIncremental;
+    const char*                             fName;
+    std::vector<std::unique_ptr<Paragraph>> fParagraphs;
+};
+
+constexpr SkScalar ParagraphResizeBench::kWidths[];
+
+// Keystroke latency: insert a character into one paragraph of the document and lay it out again.
+// Incremental mode rebuilds only the edited paragraph; full mode rebuilds the whole document
+// as a single paragraph.
+struct ParagraphKeystrokeBench : public Benchmark {
+    ParagraphKeystrokeBench(bool incremental)
+            : fIncremental(incremental)
+            , fName(incremental ? "paragraph_keystroke_100KB" : "paragraph_keystroke_100KB_full") {}
+
+    const char* onGetName() override { return fName; }
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+
+    void onDelayedSetup() override {
+        fLines = make_document(100 * 1024);
+        fFontCollection = make_uncached_font_collection();
+        fParagraphStyle.turnHintingOff();
+
+        if (fIncremental) {
+            for (const auto& line : fLines) {
+                fParagraphs.push_back(this->build(line));
+                fParagraphs.back()->layout(kWidth);
+            }
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        if (fLines.empty()) {
+            return;
+        }
+
+        for (int i = 0; i < loops; ++i) {
+            // Type in the middle of a line, moving through the document.
+            const size_t index = (i * 7) % fLines.size();
+            auto& line = fLines[index];
+            line.insertUnichar(line.size() / 2, 'a' + i % 26);
+
+            if (fIncremental) {
+                fParagraphs[index] = this->build(line);
+                fParagraphs[index]->layout(kWidth);
+            } else {
+                SkString document;
+                for (const auto& l : fLines) {
+                    document.append(l);
+                    document.append("\n");
+                }
+                this->build(document)->layout(kWidth);
+            }
+        }
+    }
+
+private:
+    std::unique_ptr<Paragraph> build(const SkString& text) {
+        ParagraphBuilderImpl builder(fParagraphStyle, fFontCollection);
+        builder.addText(text.c_str(), text.size());
+        return builder.Build();
+    }
+
+    static constexpr SkScalar kWidth = 800;
+
+    const bool                              fIncremental;
+    const char*                             fName;
+    std::vector<SkString>                   fLines;
+    sk_sp<FontCollection>                   fFontCollection;
+    ParagraphStyle                          fParagraphStyle;
+    std::vector<std::unique_ptr<Paragraph>> fParagraphs;
+};
 }  // namespace
 
+DEF_BENCH(return new ParagraphCacheBench(1);)
+DEF_BENCH(return new ParagraphCacheBench(4);)
+DEF_BENCH(return new ParagraphCacheBench(8);)
+
+DEF_BENCH(return new ParagraphResizeBench(true);)
+DEF_BENCH(return new ParagraphResizeBench(false);)
+DEF_BENCH(return new ParagraphKeystrokeBench(true);)
+DEF_BENCH(return new ParagraphKeystrokeBench(false);)
+
 #define PARAGRAPH_BENCH(X) DEF_BENCH(return new ParagraphBench(50000, "text/" #X ".txt", "paragraph_" #X);)
 //PARAGRAPH_BENCH(arabic)
 //PARAGRAPH_BENCH(emoji)
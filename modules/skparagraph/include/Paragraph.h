@@ -8,6 +8,7 @@
 #include "modules/skparagraph/include/TextStyle.h"
 
 class SkCanvas;
+class SkExecutor;
 
 namespace skia {
 namespace textlayout {
@@ -37,6 +38,12 @@ public:
 
     virtual void layout(SkScalar width) = 0;
 
+    // Lays out all the paragraphs at the given width, concurrently on the executor
+    // (SkExecutor::GetDefault() if null). The paragraphs must be distinct objects,
+    // but they may share a FontCollection.
+    static void Layout(Paragraph* const paragraphs[], size_t count, SkScalar width,
+                       SkExecutor* executor = nullptr);
+
     virtual void paint(SkCanvas* canvas, SkScalar x, SkScalar y) = 0;
 
     // Returns a vector of bounding boxes that enclose all text between
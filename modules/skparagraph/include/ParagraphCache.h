@@ -2,9 +2,12 @@
 #ifndef ParagraphCache_DEFINED
 #define ParagraphCache_DEFINED
 
+#include "include/core/SkString.h"
 #include "include/private/SkMutex.h"
 #include "src/core/SkLRUCache.h"
+#include <atomic>
 #include <functional>  // std::function
+#include <memory>
 
 #define PARAGRAPH_CACHE_STATS
 
@@ -43,34 +46,56 @@ public:
     }
     void printStatistics();
     void turnOn(bool value) { fCacheIsOn = value; }
-    int count() { return fLRUCacheMap.count(); }
+    int count();
+
+    // The cache is budgeted by the (approximate) memory used by the stored shaping results.
+    // The budget is split evenly between independently locked shards, so concurrent layouts
+    // sharing a FontCollection only contend when hitting the same shard.
+    void setByteLimit(size_t bytes);
+    size_t getByteLimit() const { return fByteLimit; }
+    size_t getTotalBytesUsed();
+
+    struct Stats {
+        int    fRequests;  // findParagraph() lookups
+        int    fHits;
+        int    fMisses;
+        int    fEntries;
+        size_t fBytesUsed;
+    };
+    Stats getStats();
 
     bool isPossiblyTextEditing(ParagraphImpl* paragraph);
 
  private:
 
     struct Entry;
-    void updateFrom(const ParagraphImpl* paragraph, Entry* entry);
-    void updateTo(ParagraphImpl* paragraph, const Entry* entry);
+    struct Shard;
+    void updateTo(ParagraphImpl* paragraph, const ParagraphCacheValue* value);
+
+    Shard& shardFor(const ParagraphCacheKey& key);
+    void purgeAsNeeded(Shard* shard) const;
 
-     mutable SkMutex fParagraphMutex;
      std::function<void(ParagraphImpl* impl, const char*, bool)> fChecker;
 
-    static const int kMaxEntries = 128;
+    static constexpr int    kShardCount       = 8;
+    static constexpr size_t kDefaultByteLimit = 16 * 1024 * 1024;
 
     struct KeyHash {
         uint32_t mix(uint32_t hash, uint32_t data) const;
         uint32_t operator()(const ParagraphCacheKey& key) const;
     };
 
-    SkLRUCache<ParagraphCacheKey, std::unique_ptr<Entry>, KeyHash> fLRUCacheMap;
-    bool fCacheIsOn;
-    ParagraphCacheValue* fLastCachedValue;
+    std::unique_ptr<Shard[]> fShards;
+    std::atomic<size_t>      fByteLimit;
+    std::atomic<bool>        fCacheIsOn;
+
+    // The last cached text, for edit detection.
+    SkMutex                  fLastCachedMutex;
+    SkString                 fLastCachedText SK_GUARDED_BY(fLastCachedMutex);
 
 #ifdef PARAGRAPH_CACHE_STATS
-    int fTotalRequests;
-    int fCacheMisses;
-    int fHashMisses; // cache hit but hash table missed
+    std::atomic<int> fTotalRequests;
+    std::atomic<int> fCacheMisses;
 #endif
 };
 
@@ -1,4 +1,5 @@
 // Copyright 2019 Google LLC.
+#include <limits>
 #include <memory>
 
 #include "modules/skparagraph/include/ParagraphCache.h"
@@ -33,7 +34,7 @@ public:
     ParagraphStyle fParagraphStyle;
 };
 
-class ParagraphCacheValue {
+class ParagraphCacheValue : public SkNVRefCnt<ParagraphCacheValue> {
 public:
     ParagraphCacheValue(const ParagraphImpl* paragraph)
         : fKey(ParagraphCacheKey(paragraph))
@@ -44,6 +45,30 @@ public:
         , fUTF8IndexForUTF16Index(paragraph->fUTF8IndexForUTF16Index)
         , fUTF16IndexForUTF8Index(paragraph->fUTF16IndexForUTF8Index) { }
 
+    // Approximate memory footprint, for cache budgeting.
+    size_t memoryUsage() const {
+        // Per-glyph run data: glyph id, position, justification shift, cluster index,
+        // bounds and formatting shift.
+        static constexpr size_t kBytesPerGlyph = sizeof(SkGlyphID) + 2 * sizeof(SkPoint) +
+                                                 sizeof(uint32_t) + sizeof(SkRect) +
+                                                 sizeof(SkScalar);
+
+        size_t bytes = sizeof(ParagraphCacheValue) +
+                       2 * fKey.fText.size() + // key + ParagraphCache lookup key
+                       fKey.fPlaceholders.size() * sizeof(Placeholder) +
+                       fKey.fTextStyles.size() * sizeof(Block);
+        for (const auto& run : fRuns) {
+            bytes += sizeof(Run) + run.size() * kBytesPerGlyph;
+        }
+        bytes += fCodeUnitProperties.size() * sizeof(CodeUnitFlags) +
+                 fWords.size() * sizeof(size_t) +
+                 fBidiRegions.size() * sizeof(SkUnicode::BidiRegion) +
+                 fUTF8IndexForUTF16Index.size() * sizeof(TextIndex) +
+                 fUTF16IndexForUTF8Index.size() * sizeof(size_t);
+
+        return bytes;
+    }
+
     // Input == key
     ParagraphCacheKey fKey;
 
@@ -185,61 +210,123 @@ bool operator==(const ParagraphCacheKey& a, const ParagraphCacheKey& b) {
 
 struct ParagraphCache::Entry {
 
-    Entry(ParagraphCacheValue* value) : fValue(value) {}
-    std::unique_ptr<ParagraphCacheValue> fValue;
+    Entry(sk_sp<ParagraphCacheValue> value, size_t bytes)
+        : fValue(std::move(value)), fBytes(bytes) {}
+    sk_sp<ParagraphCacheValue> fValue;
+    size_t fBytes;
+};
+
+struct ParagraphCache::Shard {
+    // Shards are budgeted by bytes, not entry count.
+    Shard() : fLRUCacheMap(std::numeric_limits<int>::max()) {}
+
+    SkMutex fMutex;
+    SkLRUCache<ParagraphCacheKey, std::unique_ptr<Entry>, KeyHash> fLRUCacheMap
+        SK_GUARDED_BY(fMutex);
+    size_t fBytesUsed SK_GUARDED_BY(fMutex) = 0;
 };
 
 ParagraphCache::ParagraphCache()
     : fChecker([](ParagraphImpl* impl, const char*, bool){ })
-    , fLRUCacheMap(kMaxEntries)
+    , fShards(new Shard[kShardCount])
+    , fByteLimit(kDefaultByteLimit)
     , fCacheIsOn(true)
-    , fLastCachedValue(nullptr)
 #ifdef PARAGRAPH_CACHE_STATS
     , fTotalRequests(0)
     , fCacheMisses(0)
-    , fHashMisses(0)
 #endif
 { }
 
 ParagraphCache::~ParagraphCache() { }
 
-void ParagraphCache::updateTo(ParagraphImpl* paragraph, const Entry* entry) {
+ParagraphCache::Shard& ParagraphCache::shardFor(const ParagraphCacheKey& key) {
+    // The LRU map buckets by the low hash bits: remix to decorrelate the shard selection.
+    return fShards[SkChecksum::Mix(KeyHash()(key)) % kShardCount];
+}
+
+void ParagraphCache::purgeAsNeeded(Shard* shard) const {
+    const auto shardLimit = fByteLimit / kShardCount;
+
+    // Always keep the most recent entry, even if it exceeds the shard budget on its own.
+    while (shard->fBytesUsed > shardLimit && shard->fLRUCacheMap.count() > 1) {
+        const auto entry = shard->fLRUCacheMap.removeLeastRecentlyUsed();
+        SkASSERT(shard->fBytesUsed >= entry->fBytes);
+        shard->fBytesUsed -= entry->fBytes;
+    }
+}
+
+void ParagraphCache::updateTo(ParagraphImpl* paragraph, const ParagraphCacheValue* value) {
 
     paragraph->fRuns.reset();
-    paragraph->fRuns = entry->fValue->fRuns;
-    paragraph->fCodeUnitProperties = entry->fValue->fCodeUnitProperties;
-    paragraph->fWords = entry->fValue->fWords;
-    paragraph->fBidiRegions = entry->fValue->fBidiRegions;
-    paragraph->fUTF8IndexForUTF16Index = entry->fValue->fUTF8IndexForUTF16Index;
-    paragraph->fUTF16IndexForUTF8Index = entry->fValue->fUTF16IndexForUTF8Index;
+    paragraph->fRuns = value->fRuns;
+    paragraph->fCodeUnitProperties = value->fCodeUnitProperties;
+    paragraph->fWords = value->fWords;
+    paragraph->fBidiRegions = value->fBidiRegions;
+    paragraph->fUTF8IndexForUTF16Index = value->fUTF8IndexForUTF16Index;
+    paragraph->fUTF16IndexForUTF8Index = value->fUTF16IndexForUTF8Index;
     for (auto& run : paragraph->fRuns) {
       run.setOwner(paragraph);
     }
 }
 
 void ParagraphCache::printStatistics() {
+    const auto stats = this->getStats();
     SkDebugf("--- Paragraph Cache ---\n");
-    SkDebugf("Total requests: %d\n", fTotalRequests);
-    SkDebugf("Cache misses: %d\n", fCacheMisses);
-    SkDebugf("Cache miss %%: %f\n", (fTotalRequests > 0) ? 100.f * fCacheMisses / fTotalRequests : 0.f);
-    int cacheHits = fTotalRequests - fCacheMisses;
-    SkDebugf("Hash miss %%: %f\n", (cacheHits > 0) ? 100.f * fHashMisses / cacheHits : 0.f);
+    SkDebugf("Total requests: %d\n", stats.fRequests);
+    SkDebugf("Cache misses: %d\n", stats.fMisses);
+    SkDebugf("Cache miss %%: %f\n", (stats.fRequests > 0) ? 100.f * stats.fMisses / stats.fRequests : 0.f);
+    SkDebugf("Entries: %d (%zu bytes, limit %zu)\n", stats.fEntries, stats.fBytesUsed, this->getByteLimit());
     SkDebugf("---------------------\n");
 }
 
+ParagraphCache::Stats ParagraphCache::getStats() {
+    Stats stats = {0, 0, 0, 0, 0};
+#ifdef PARAGRAPH_CACHE_STATS
+    stats.fRequests = fTotalRequests;
+    stats.fMisses   = fCacheMisses;
+    stats.fHits     = stats.fRequests - stats.fMisses;
+#endif
+    for (int i = 0; i < kShardCount; ++i) {
+        SkAutoMutexExclusive lock(fShards[i].fMutex);
+        stats.fEntries   += fShards[i].fLRUCacheMap.count();
+        stats.fBytesUsed += fShards[i].fBytesUsed;
+    }
+    return stats;
+}
+
+int ParagraphCache::count() {
+    return this->getStats().fEntries;
+}
+
+size_t ParagraphCache::getTotalBytesUsed() {
+    return this->getStats().fBytesUsed;
+}
+
+void ParagraphCache::setByteLimit(size_t bytes) {
+    fByteLimit = bytes;
+    for (int i = 0; i < kShardCount; ++i) {
+        SkAutoMutexExclusive lock(fShards[i].fMutex);
+        this->purgeAsNeeded(&fShards[i]);
+    }
+}
+
 void ParagraphCache::abandon() {
     this->reset();
 }
 
 void ParagraphCache::reset() {
-    SkAutoMutexExclusive lock(fParagraphMutex);
 #ifdef PARAGRAPH_CACHE_STATS
     fTotalRequests = 0;
     fCacheMisses = 0;
-    fHashMisses = 0;
 #endif
-    fLRUCacheMap.reset();
-    fLastCachedValue = nullptr;
+    for (int i = 0; i < kShardCount; ++i) {
+        SkAutoMutexExclusive lock(fShards[i].fMutex);
+        fShards[i].fLRUCacheMap.reset();
+        fShards[i].fBytesUsed = 0;
+    }
+
+    SkAutoMutexExclusive lock(fLastCachedMutex);
+    fLastCachedText.reset();
 }
 
 bool ParagraphCache::findParagraph(ParagraphImpl* paragraph) {
@@ -249,11 +336,19 @@ bool ParagraphCache::findParagraph(ParagraphImpl* paragraph) {
 #ifdef PARAGRAPH_CACHE_STATS
     ++fTotalRequests;
 #endif
-    SkAutoMutexExclusive lock(fParagraphMutex);
     ParagraphCacheKey key(paragraph);
-    std::unique_ptr<Entry>* entry = fLRUCacheMap.find(key);
+    auto& shard = this->shardFor(key);
+
+    // Only grab a ref under the lock: the (relatively expensive) copy happens outside.
+    sk_sp<ParagraphCacheValue> value;
+    {
+        SkAutoMutexExclusive lock(shard.fMutex);
+        if (std::unique_ptr<Entry>* entry = shard.fLRUCacheMap.find(key)) {
+            value = (*entry)->fValue;
+        }
+    }
 
-    if (!entry) {
+    if (!value) {
         // We have a cache miss
 #ifdef PARAGRAPH_CACHE_STATS
         ++fCacheMisses;
@@ -261,7 +356,7 @@ bool ParagraphCache::findParagraph(ParagraphImpl* paragraph) {
         fChecker(paragraph, "missingParagraph", true);
         return false;
     }
-    updateTo(paragraph, entry->get());
+    updateTo(paragraph, value.get());
     fChecker(paragraph, "foundParagraph", true);
     return true;
 }
@@ -270,38 +365,49 @@ bool ParagraphCache::updateParagraph(ParagraphImpl* paragraph) {
     if (!fCacheIsOn) {
         return false;
     }
-#ifdef PARAGRAPH_CACHE_STATS
-    ++fTotalRequests;
-#endif
-    SkAutoMutexExclusive lock(fParagraphMutex);
 
     ParagraphCacheKey key(paragraph);
-    std::unique_ptr<Entry>* entry = fLRUCacheMap.find(key);
-    if (!entry) {
-        // isTooMuchMemoryWasted(paragraph) not needed for now
-        if (isPossiblyTextEditing(paragraph)) {
-            // Skip this paragraph
+    auto& shard = this->shardFor(key);
+    {
+        SkAutoMutexExclusive lock(shard.fMutex);
+        if (shard.fLRUCacheMap.find(key)) {
+            // We do not have to update the paragraph
             return false;
         }
-        ParagraphCacheValue* value = new ParagraphCacheValue(paragraph);
-        fLRUCacheMap.insert(key, std::make_unique<Entry>(value));
-        fChecker(paragraph, "addedParagraph", true);
-        fLastCachedValue = value;
-        return true;
-    } else {
-        // We do not have to update the paragraph
+    }
+
+    // isTooMuchMemoryWasted(paragraph) not needed for now
+    if (isPossiblyTextEditing(paragraph)) {
+        // Skip this paragraph
         return false;
     }
+
+    auto value = sk_make_sp<ParagraphCacheValue>(paragraph);
+    const auto bytes = value->memoryUsage();
+    {
+        SkAutoMutexExclusive lock(shard.fMutex);
+        if (shard.fLRUCacheMap.find(key)) {
+            // Added concurrently.
+            return false;
+        }
+        shard.fLRUCacheMap.insert(key, std::make_unique<Entry>(std::move(value), bytes));
+        shard.fBytesUsed += bytes;
+        this->purgeAsNeeded(&shard);
+    }
+    {
+        SkAutoMutexExclusive lock(fLastCachedMutex);
+        fLastCachedText = key.fText;
+    }
+    fChecker(paragraph, "addedParagraph", true);
+    return true;
 }
 
 // Special situation: (very) long paragraph that is close to the last formatted paragraph
 #define NOCACHE_PREFIX_LENGTH 40
 bool ParagraphCache::isPossiblyTextEditing(ParagraphImpl* paragraph) {
-    if (fLastCachedValue == nullptr) {
-        return false;
-    }
+    SkAutoMutexExclusive lock(fLastCachedMutex);
 
-    auto& lastText = fLastCachedValue->fKey.fText;
+    auto& lastText = fLastCachedText;
     auto& text = paragraph->fText;
 
     if ((lastText.size() < NOCACHE_PREFIX_LENGTH) || (text.size() < NOCACHE_PREFIX_LENGTH)) {
@@ -17,6 +17,7 @@
 #include "modules/skparagraph/src/TextLine.h"
 #include "modules/skparagraph/src/TextWrapper.h"
 #include "src/core/SkSpan.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/utils/SkUTF.h"
 #include <math.h>
 #include <algorithm>
@@ -61,6 +62,21 @@ Paragraph::Paragraph(ParagraphStyle style, sk_sp<FontCollection> fonts)
             , fExceededMaxLines(0)
 { }
 
+void Paragraph::Layout(Paragraph* const paragraphs[], size_t count, SkScalar width,
+                       SkExecutor* executor) {
+    if (count == 0) {
+        return;
+    }
+    if (count == 1) {
+        paragraphs[0]->layout(width);
+        return;
+    }
+
+    SkTaskGroup tg(executor ? *executor : SkExecutor::GetDefault());
+    tg.batch(SkToInt(count), [&](int i) { paragraphs[i]->layout(width); });
+    tg.wait();
+}
+
 ParagraphImpl::ParagraphImpl(const SkString& text,
                              ParagraphStyle style,
                              SkTArray<Block, true> blocks,
@@ -122,8 +138,12 @@ void ParagraphImpl::layout(SkScalar rawWidth) {
         fWidth = floorWidth;
         fState = kMarked;
     } else if (fState >= kLineBroken && fOldWidth != floorWidth) {
-        // We can use the results from SkShaper but have to do EVERYTHING ELSE again
-        fState = kShaped;
+        // We can use the results from SkShaper and the cluster table (letter/word spacing
+        // included); only the justification shifts depend on the width
+        for (auto& run : fRuns) {
+            run.resetJustificationShifts();
+        }
+        fState = kMarked;
     } else {
         // Nothing changed case: we can reuse the data from the last layout
     }
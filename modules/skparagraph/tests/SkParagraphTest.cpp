@@ -3,6 +3,7 @@
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
 #include "include/core/SkEncodedImageFormat.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkFontMgr.h"
 #include "include/core/SkFontStyle.h"
 #include "include/core/SkImageEncoder.h"
@@ -4660,6 +4661,100 @@ DEF_TEST_DISABLED(SkParagraph_JSON2, reporter) {
     REPORTER_ASSERT(reporter, cluster <= 2);
 }
 
+DEF_TEST(SkParagraph_RelayoutWidth, reporter) {
+    sk_sp<ResourceFontCollection> fontCollection = sk_make_sp<ResourceFontCollection>();
+    if (!fontCollection->fontsFound()) return;
+    fontCollection->getParagraphCache()->turnOn(false);
+
+    const char* text = "Relaying out a paragraph at a new width reuses the shaped runs and the "
+                       "cluster table; only line breaking and justification are redone.";
+    ParagraphStyle paragraph_style;
+    paragraph_style.turnHintingOff();
+    paragraph_style.setTextAlign(TextAlign::kJustify);
+
+    TextStyle text_style;
+    text_style.setFontFamilies({SkString("Roboto")});
+    text_style.setColor(SK_ColorBLACK);
+    text_style.setFontSize(20);
+    text_style.setLetterSpacing(1);
+    text_style.setWordSpacing(3);
+
+    auto make = [&]() {
+        ParagraphBuilderImpl builder(paragraph_style, fontCollection);
+        builder.pushStyle(text_style);
+        builder.addText(text, strlen(text));
+        builder.pop();
+        return builder.Build();
+    };
+
+    auto relaid = make();
+    for (auto width : { 300.f, 180.f, 450.f, 180.f }) {
+        relaid->layout(width);
+
+        auto fresh = make();
+        fresh->layout(width);
+
+        REPORTER_ASSERT(reporter, relaid->lineNumber() == fresh->lineNumber());
+        REPORTER_ASSERT(reporter, relaid->getHeight() == fresh->getHeight());
+        REPORTER_ASSERT(reporter, relaid->getLongestLine() == fresh->getLongestLine());
+        REPORTER_ASSERT(reporter, relaid->getMinIntrinsicWidth() == fresh->getMinIntrinsicWidth());
+        REPORTER_ASSERT(reporter, relaid->getMaxIntrinsicWidth() == fresh->getMaxIntrinsicWidth());
+
+        auto relaidBoxes = relaid->getRectsForRange(0, strlen(text), RectHeightStyle::kTight,
+                                                    RectWidthStyle::kTight);
+        auto freshBoxes = fresh->getRectsForRange(0, strlen(text), RectHeightStyle::kTight,
+                                                  RectWidthStyle::kTight);
+        REPORTER_ASSERT(reporter, relaidBoxes.size() == freshBoxes.size());
+        for (size_t i = 0; i < std::min(relaidBoxes.size(), freshBoxes.size()); ++i) {
+            REPORTER_ASSERT(reporter, relaidBoxes[i].rect == freshBoxes[i].rect);
+        }
+    }
+}
+
+DEF_TEST(SkParagraph_LayoutConcurrently, reporter) {
+    sk_sp<ResourceFontCollection> fontCollection = sk_make_sp<ResourceFontCollection>();
+    if (!fontCollection->fontsFound()) return;
+
+    ParagraphStyle paragraph_style;
+    paragraph_style.turnHintingOff();
+
+    TextStyle text_style;
+    text_style.setFontFamilies({SkString("Roboto")});
+    text_style.setColor(SK_ColorBLACK);
+
+    auto make = [&](int i) {
+        ParagraphBuilderImpl builder(paragraph_style, fontCollection);
+        builder.pushStyle(text_style);
+        auto text = SkStringPrintf("Paragraph #%d is laid out on some thread, "
+                                   "and has to match the serial layout.", i);
+        builder.addText(text.c_str(), text.size());
+        builder.pop();
+        return builder.Build();
+    };
+
+    static constexpr int kCount = 32;
+    std::vector<std::unique_ptr<Paragraph>> paragraphs;
+    std::vector<Paragraph*> ptrs;
+    for (int i = 0; i < kCount; ++i) {
+        paragraphs.push_back(make(i));
+        ptrs.push_back(paragraphs.back().get());
+    }
+
+    auto executor = SkExecutor::MakeFIFOThreadPool(4);
+    Paragraph::Layout(ptrs.data(), ptrs.size(), 200, executor.get());
+
+    // No cache: the serial layouts have to shape everything themselves.
+    fontCollection->clearCaches();
+    fontCollection->getParagraphCache()->turnOn(false);
+    for (int i = 0; i < kCount; ++i) {
+        auto serial = make(i);
+        serial->layout(200);
+        REPORTER_ASSERT(reporter, paragraphs[i]->lineNumber() == serial->lineNumber());
+        REPORTER_ASSERT(reporter, paragraphs[i]->getHeight() == serial->getHeight());
+        REPORTER_ASSERT(reporter, paragraphs[i]->getLongestLine() == serial->getLongestLine());
+    }
+}
+
 DEF_TEST(SkParagraph_CacheText, reporter) {
     ParagraphCache cache;
     cache.turnOn(true);
@@ -4695,6 +4790,62 @@ DEF_TEST(SkParagraph_CacheText, reporter) {
     test("text3", 2, false);
 }
 
+DEF_TEST(SkParagraph_CacheByteLimit, reporter) {
+    ParagraphCache cache;
+    cache.turnOn(true);
+    sk_sp<ResourceFontCollection> fontCollection = sk_make_sp<ResourceFontCollection>();
+    if (!fontCollection->fontsFound()) return;
+
+    ParagraphStyle paragraph_style;
+    paragraph_style.turnHintingOff();
+
+    TextStyle text_style;
+    text_style.setFontFamilies({SkString("Roboto")});
+    text_style.setColor(SK_ColorBLACK);
+
+    auto make = [&](const SkString& text) {
+        ParagraphBuilderImpl builder(paragraph_style, fontCollection);
+        builder.pushStyle(text_style);
+        builder.addText(text.c_str(), text.size());
+        builder.pop();
+        return builder.Build();
+    };
+
+    static constexpr int kParagraphs = 64;
+    for (int i = 0; i < kParagraphs; ++i) {
+        auto paragraph = make(SkStringPrintf("p%d", i));
+        auto impl = static_cast<ParagraphImpl*>(paragraph.get());
+        REPORTER_ASSERT(reporter, !cache.findParagraph(impl));
+        REPORTER_ASSERT(reporter, cache.updateParagraph(impl));
+    }
+
+    auto stats = cache.getStats();
+    REPORTER_ASSERT(reporter, stats.fEntries == kParagraphs);
+    REPORTER_ASSERT(reporter, stats.fBytesUsed > 0);
+    REPORTER_ASSERT(reporter, stats.fBytesUsed == cache.getTotalBytesUsed());
+    REPORTER_ASSERT(reporter, stats.fRequests == kParagraphs);
+    REPORTER_ASSERT(reporter, stats.fMisses == kParagraphs);
+    REPORTER_ASSERT(reporter, stats.fHits == 0);
+
+    // Shrinking the budget evicts, but never past one entry per shard.
+    cache.setByteLimit(stats.fBytesUsed / 4);
+    auto shrunk = cache.getStats();
+    REPORTER_ASSERT(reporter, shrunk.fEntries < kParagraphs);
+    REPORTER_ASSERT(reporter, shrunk.fEntries > 0);
+    REPORTER_ASSERT(reporter, shrunk.fBytesUsed < stats.fBytesUsed);
+
+    // The most recently added paragraph survives eviction.
+    {
+        auto paragraph = make(SkStringPrintf("p%d", kParagraphs - 1));
+        REPORTER_ASSERT(reporter, cache.findParagraph(static_cast<ParagraphImpl*>(paragraph.get())));
+        REPORTER_ASSERT(reporter, cache.getStats().fHits == 1);
+    }
+
+    cache.reset();
+    stats = cache.getStats();
+    REPORTER_ASSERT(reporter, stats.fEntries == 0 && stats.fBytesUsed == 0 && stats.fRequests == 0);
+}
+
 DEF_TEST(SkParagraph_CacheFonts, reporter) {
     ParagraphCache cache;
     cache.turnOn(true);
@@ -31,6 +31,11 @@ public:
     // Render the node and its descendants to the canvas.
     void render(SkCanvas*, const RenderContext* = nullptr) const;
 
+    // Similar to render(), but skips sub-DAGs which don't intersect the canvas clip.
+    // Image filter isolation resets the render context, so filtered content (which may reach
+    // outside its node bounds) is not culled.
+    void renderCulled(SkCanvas*) const;
+
     // Perform a front-to-back hit-test, and return the RenderNode located at |point|.
     // Normally, hit-testing stops at leaf Draw nodes.
     const RenderNode* nodeAt(const SkPoint& point) const;
@@ -58,6 +63,9 @@ protected:
         float                fOpacity   = 1;
         SkBlendMode          fBlendMode = SkBlendMode::kSrcOver;
 
+        // Skip sub-DAGs outside the canvas clip (see renderCulled()).
+        bool                 fCullToClip = false;
+
         // Returns true if the paint overrides require a layer when applied to non-atomic draws.
         bool requiresIsolation() const;
 
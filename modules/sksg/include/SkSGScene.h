@@ -34,6 +34,8 @@ public:
     Scene& operator=(const Scene&) = delete;
 
     void render(SkCanvas*) const;
+    // Only renders nodes intersecting the canvas clip - e.g. for partial/damage redraws.
+    void renderCulled(SkCanvas*) const;
     void revalidate(InvalidationController* = nullptr);
     const RenderNode* nodeAt(const SkPoint&) const;
 
@@ -31,6 +31,12 @@ void Scene::render(SkCanvas* canvas) const {
     fRoot->render(canvas);
 }
 
+void Scene::renderCulled(SkCanvas* canvas) const {
+    fRoot->revalidate(nullptr, SkMatrix::I());
+
+    fRoot->renderCulled(canvas);
+}
+
 void Scene::revalidate(InvalidationController* ic) {
     fRoot->revalidate(ic, SkMatrix::I());
 }
@@ -290,6 +290,8 @@ HBFace create_hb_face(const SkTypeface& typeface) {
                               nullptr, false);
     )
 
+    // Faces are shared between threads through the face cache.
+    hb_face_make_immutable(face.get());
     return face;
 }
 
@@ -1347,16 +1349,30 @@ ShapedRun ShaperHarfBuzz::shape(char const * const utf8,
     // An HBFont is fairly inexpensive.
     // An HBFace is actually tied to the data, not the typeface.
     // The size of 100 here is completely arbitrary and used to match libtxt.
+    // The cache lock is only held for lookups: faces are immutable and ref counted, so
+    // they are created and used concurrently from any number of shapers.
     HBFont hbFont;
     {
-        HBLockedFaceCache cache = get_hbFace_cache();
         SkFontID dataId = font.currentFont().getTypeface()->uniqueID();
-        HBFace* hbFaceCached = cache.find(dataId);
-        if (!hbFaceCached) {
-            HBFace hbFace(create_hb_face(*font.currentFont().getTypeface()));
-            hbFaceCached = cache.insert(dataId, std::move(hbFace));
+        HBFace hbFace;
+        {
+            HBLockedFaceCache cache = get_hbFace_cache();
+            if (HBFace* hbFaceCached = cache.find(dataId)) {
+                hbFace.reset(hb_face_reference(hbFaceCached->get()));
+            }
+        }
+        if (!hbFace) {
+            hbFace = create_hb_face(*font.currentFont().getTypeface());
+
+            HBLockedFaceCache cache = get_hbFace_cache();
+            if (HBFace* hbFaceCached = cache.find(dataId)) {
+                // Another thread got here first, share its face.
+                hbFace.reset(hb_face_reference(hbFaceCached->get()));
+            } else if (hbFace) {
+                cache.insert(dataId, HBFace(hb_face_reference(hbFace.get())));
+            }
         }
-        hbFont = create_hb_font(font.currentFont(), *hbFaceCached);
+        hbFont = create_hb_font(font.currentFont(), hbFace);
     }
     if (!hbFont) {
         return run;
@@ -32,6 +32,7 @@
 #elif defined(SK_USE_LIBGIFCODEC)
 #include "SkGifCodec.h"
 #endif
+#include "src/core/SkTaskGroup.h"
 
 struct DecoderProc {
     bool (*IsFormat)(const void*, size_t);
@@ -744,6 +745,22 @@ void SkCodec::applyColorXform(void* dst, const void* src, int count) const {
                                    count));
 }
 
+void SkCodec::applyColorXformRows(void* dst, size_t dstRowBytes,
+                                  const void* src, size_t srcRowBytes,
+                                  int width, int rows, SkTaskGroup* taskGroup) const {
+    auto xform = [this, dst, dstRowBytes, src, srcRowBytes, width, rows] {
+        for (int y = 0; y < rows; ++y) {
+            this->applyColorXform(SkTAddOffset<void>(dst, y * dstRowBytes),
+                                  SkTAddOffset<const void>(src, y * srcRowBytes), width);
+        }
+    };
+    if (taskGroup) {
+        taskGroup->add(xform);
+    } else {
+        xform();
+    }
+}
+
 std::vector<SkCodec::FrameInfo> SkCodec::getFrameInfo() {
     const int frameCount = this->getFrameCount();
     SkASSERT(frameCount >= 0);
@@ -7,6 +7,7 @@
 
 #include "src/codec/SkCodecImageGenerator.h"
 
+#include "include/private/SkTemplates.h"
 #include "src/core/SkPixmapPriv.h"
 
 std::unique_ptr<SkImageGenerator> SkCodecImageGenerator::MakeFromEncodedCodec(sk_sp<SkData> data) {
@@ -86,6 +87,48 @@ bool SkCodecImageGenerator::onGetYUVAPlanes(const SkYUVAPixmaps& yuvaPixmaps) {
     }
 }
 
+bool SkCodecImageGenerator::onGetSubsetPixels(const SkIRect& subset, const SkPixmap& dst) {
+    SkASSERT(dst.dimensions() == subset.size());
+    if (fCodec->getOrigin() != kTopLeft_SkEncodedOrigin ||
+        !SkIRect::MakeSize(fCodec->dimensions()).contains(subset)) {
+        return false;
+    }
+
+    auto succeeded = [](SkCodec::Result result) {
+        return result == SkCodec::kSuccess || result == SkCodec::kIncompleteInput ||
+               result == SkCodec::kErrorInInput;
+    };
+
+    // Codecs that can decode a region directly (e.g. WebP) do so if the subset is one they
+    // support as-is.
+    SkIRect validSubset = subset;
+    if (fCodec->getValidSubset(&validSubset) && validSubset == subset) {
+        SkCodec::Options options;
+        options.fSubset = &validSubset;
+        if (succeeded(fCodec->getPixels(dst, &options))) {
+            return true;
+        }
+    }
+
+    // Otherwise, decode only the rows that cover the subset, skipping those above it, and copy
+    // out its columns.
+    const SkImageInfo fullInfo = dst.info().makeDimensions(fCodec->dimensions());
+    if (fCodec->startScanlineDecode(fullInfo) != SkCodec::kSuccess ||
+        fCodec->getScanlineOrder() != SkCodec::kTopDown_SkScanlineOrder ||
+        !fCodec->skipScanlines(subset.top())) {
+        return false;
+    }
+    const size_t bpp = dst.info().bytesPerPixel();
+    SkAutoTMalloc<uint8_t> row(fullInfo.minRowBytes());
+    for (int y = 0; y < subset.height(); ++y) {
+        if (fCodec->getScanlines(row.get(), 1, fullInfo.minRowBytes()) != 1) {
+            return false;
+        }
+        memcpy(dst.writable_addr(0, y), row.get() + subset.left() * bpp, subset.width() * bpp);
+    }
+    return true;
+}
+
 SkISize SkCodecImageGenerator::getScaledDimensions(float desiredScale) const {
     SkISize size = fCodec->getScaledDimensions(desiredScale);
     if (SkEncodedOriginSwapsWidthHeight(fCodec->getOrigin())) {
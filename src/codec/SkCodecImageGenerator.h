@@ -103,6 +103,12 @@ protected:
 
     bool onGetYUVAPlanes(const SkYUVAPixmaps& yuvaPixmaps) override;
 
+    SkISize onGetScaledDimensions(float desiredScale) const override {
+        return this->getScaledDimensions(desiredScale);
+    }
+
+    bool onGetSubsetPixels(const SkIRect& subset, const SkPixmap& dst) override;
+
 private:
     /*
      * Takes ownership of codec
@@ -16,6 +16,8 @@
 #include "src/codec/SkCodecPriv.h"
 #include "src/codec/SkJpegDecoderMgr.h"
 #include "src/codec/SkParseEncodedOrigin.h"
+#include "src/core/SkTLazy.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/pdf/SkJpegInfo.h"
 
 // stdio is needed for libjpeg-turbo
@@ -444,6 +446,14 @@ bool SkJpegCodec::onDimensionsSupported(const SkISize& size) {
 
 int SkJpegCodec::readRows(const SkImageInfo& dstInfo, void* dst, size_t rowBytes, int count,
                           const Options& opts) {
+    // When the rows are color transformed in place in dst, blocks of them can be transformed on
+    // opts.fColorXformExecutor while we decode the next ones. This is declared before setjmp so
+    // that it waits for those tasks however we return.
+    SkTLazy<SkTaskGroup> xformTasks;
+    if (this->colorXform() && !fColorXformSrcRow && opts.fColorXformExecutor && count > 1) {
+        xformTasks.init(*opts.fColorXformExecutor);
+    }
+
     // Set the jump location for libjpeg-turbo errors
     skjpeg_error_mgr::AutoPushJmpBuf jmp(fDecoderMgr->errorMgr());
     if (setjmp(jmp)) {
@@ -480,9 +490,23 @@ int SkJpegCodec::readRows(const SkImageInfo& dstInfo, void* dst, size_t rowBytes
         dstWidth = fSwizzler->swizzleWidth();
     }
 
+    // Rows of dst decoded but not yet handed to xformTasks.
+    static constexpr int kRowsPerXformTask = 16;
+    void* xformBlock = dst;
+    int xformBlockRows = 0;
+    auto flush_xform_block = [&]() {
+        if (xformBlockRows > 0) {
+            this->applyColorXformRows(xformBlock, rowBytes, xformBlock, rowBytes, dstWidth,
+                                      xformBlockRows, xformTasks.get());
+            xformBlock = SkTAddOffset<void>(xformBlock, xformBlockRows * rowBytes);
+            xformBlockRows = 0;
+        }
+    };
+
     for (int y = 0; y < count; y++) {
         uint32_t lines = jpeg_read_scanlines(fDecoderMgr->dinfo(), &decodeDst, 1);
         if (0 == lines) {
+            flush_xform_block();
             return y;
         }
 
@@ -490,7 +514,11 @@ int SkJpegCodec::readRows(const SkImageInfo& dstInfo, void* dst, size_t rowBytes
             fSwizzler->swizzle(swizzleDst, decodeDst);
         }
 
-        if (this->colorXform()) {
+        if (xformTasks.isValid()) {
+            if (++xformBlockRows == kRowsPerXformTask) {
+                flush_xform_block();
+            }
+        } else if (this->colorXform()) {
             this->applyColorXform(dst, swizzleDst, dstWidth);
             dst = SkTAddOffset<void>(dst, rowBytes);
         }
@@ -498,6 +526,7 @@ int SkJpegCodec::readRows(const SkImageInfo& dstInfo, void* dst, size_t rowBytes
         decodeDst = SkTAddOffset<JSAMPLE>(decodeDst, decodeDstRowBytes);
         swizzleDst = SkTAddOffset<uint32_t>(swizzleDst, swizzleDstRowBytes);
     }
+    flush_xform_block();
 
     return count;
 }
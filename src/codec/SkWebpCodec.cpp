@@ -17,6 +17,8 @@
 #include "src/codec/SkSampler.h"
 #include "src/core/SkRasterPipeline.h"
 #include "src/core/SkStreamPriv.h"
+#include "src/core/SkTLazy.h"
+#include "src/core/SkTaskGroup.h"
 
 // A WebP decoder on top of (subset of) libwebp
 // For more information on WebP image format, and libwebp library, see:
@@ -485,66 +487,86 @@ SkCodec::Result SkWebpCodec::onGetPixels(const SkImageInfo& dstInfo, void* dst,
         return kInvalidInput;
     }
 
-    int rowsDecoded = 0;
-    SkCodec::Result result;
-    switch (WebPIUpdate(idec, frame.fragment.bytes, frame.fragment.size)) {
-        case VP8_STATUS_OK:
-            rowsDecoded = scaledHeight;
-            result = kSuccess;
-            break;
-        case VP8_STATUS_SUSPENDED:
-            if (!WebPIDecGetRGB(idec, &rowsDecoded, nullptr, nullptr, nullptr)
-                    || rowsDecoded <= 0) {
-                return kInvalidInput;
-            }
-            *rowsDecodedPtr = rowsDecoded + dstY;
-            result = kIncompleteInput;
-            break;
-        default:
-            return kInvalidInput;
-    }
-
     const size_t dstBpp = dstInfo.bytesPerPixel();
     dst = SkTAddOffset<void>(dst, dstBpp * dstX + rowBytes * dstY);
     const size_t srcRowBytes = config.output.u.RGBA.stride;
-
     const auto dstCT = dstInfo.colorType();
-    if (this->colorXform()) {
-        uint32_t* xformSrc = (uint32_t*) config.output.u.RGBA.rgba;
-        SkBitmap tmp;
-        void* xformDst;
-
-        if (blendWithPrevFrame) {
-            // Xform into temporary bitmap big enough for one row.
-            tmp.allocPixels(dstInfo.makeWH(scaledWidth, 1));
-            xformDst = tmp.getPixels();
-        } else {
-            xformDst = dst;
-        }
 
-        for (int y = 0; y < rowsDecoded; y++) {
-            this->applyColorXform(xformDst, xformSrc, scaledWidth);
-            if (blendWithPrevFrame) {
-                blend_line(dstCT, dst, dstCT, xformDst,
-                        dstInfo.alphaType(), frame.has_alpha, scaledWidth);
-                dst = SkTAddOffset<void>(dst, rowBytes);
-            } else {
-                xformDst = SkTAddOffset<void>(xformDst, rowBytes);
+    // Color transforms, unless we're also blending, can be handed to options.fColorXformExecutor
+    // while we decode the next rows. This waits for them however we return.
+    SkTLazy<SkTaskGroup> xformTasks;
+    if (this->colorXform() && !blendWithPrevFrame && options.fColorXformExecutor) {
+        xformTasks.init(*options.fColorXformExecutor);
+    }
+    SkBitmap blendRow;
+    if (this->colorXform() && blendWithPrevFrame) {
+        // Xform into temporary bitmap big enough for one row.
+        blendRow.allocPixels(dstInfo.makeWH(scaledWidth, 1));
+    }
+
+    // Color transforms and/or blends rows [startY, endY) of the decoded frame into dst.
+    auto finish_rows = [&](int startY, int endY) {
+        if (startY >= endY) {
+            return;
+        }
+        const uint8_t* src = SkTAddOffset<const uint8_t>(config.output.u.RGBA.rgba,
+                                                         startY * srcRowBytes);
+        void* dstRow = SkTAddOffset<void>(dst, startY * rowBytes);
+        if (this->colorXform() && !blendWithPrevFrame) {
+            this->applyColorXformRows(dstRow, rowBytes, src, srcRowBytes, scaledWidth,
+                                      endY - startY, xformTasks.get());
+        } else if (blendWithPrevFrame) {
+            for (int y = startY; y < endY; y++) {
+                if (this->colorXform()) {
+                    this->applyColorXform(blendRow.getPixels(), src, scaledWidth);
+                    blend_line(dstCT, dstRow, dstCT, blendRow.getPixels(),
+                            dstInfo.alphaType(), frame.has_alpha, scaledWidth);
+                } else {
+                    blend_line(dstCT, dstRow, webpDst.colorType(), src,
+                            dstInfo.alphaType(), frame.has_alpha, scaledWidth);
+                }
+                src = SkTAddOffset<const uint8_t>(src, srcRowBytes);
+                dstRow = SkTAddOffset<void>(dstRow, rowBytes);
             }
-            xformSrc = SkTAddOffset<uint32_t>(xformSrc, srcRowBytes);
         }
-    } else if (blendWithPrevFrame) {
-        const uint8_t* src = config.output.u.RGBA.rgba;
-
-        for (int y = 0; y < rowsDecoded; y++) {
-            blend_line(dstCT, dst, webpDst.colorType(), src,
-                    dstInfo.alphaType(), frame.has_alpha, scaledWidth);
-            src = SkTAddOffset<const uint8_t>(src, srcRowBytes);
-            dst = SkTAddOffset<void>(dst, rowBytes);
+    };
+
+    // Rather than decoding the whole frame and then making a second pass over it, feed libwebp
+    // the frame a chunk at a time and finish the rows each chunk produces while they're still
+    // in cache.
+    static constexpr size_t kBytesPerChunk = 32 * 1024;
+    const bool finishAsDecoded = this->colorXform() || blendWithPrevFrame;
+    size_t bytesFed = 0;
+    int rowsFinished = 0;
+    VP8StatusCode status;
+    do {
+        bytesFed = finishAsDecoded ? std::min(frame.fragment.size, bytesFed + kBytesPerChunk)
+                                   : frame.fragment.size;
+        status = WebPIUpdate(idec, frame.fragment.bytes, bytesFed);
+        int rowsDecoded = rowsFinished;
+        if (status == VP8_STATUS_OK) {
+            rowsDecoded = scaledHeight;
+        } else if (status == VP8_STATUS_SUSPENDED) {
+            if (!WebPIDecGetRGB(idec, &rowsDecoded, nullptr, nullptr, nullptr)) {
+                rowsDecoded = rowsFinished;
+            }
         }
-    }
+        finish_rows(rowsFinished, rowsDecoded);
+        rowsFinished = std::max(rowsFinished, rowsDecoded);
+    } while (status == VP8_STATUS_SUSPENDED && bytesFed < frame.fragment.size);
 
-    return result;
+    switch (status) {
+        case VP8_STATUS_OK:
+            return kSuccess;
+        case VP8_STATUS_SUSPENDED:
+            if (rowsFinished <= 0) {
+                return kInvalidInput;
+            }
+            *rowsDecodedPtr = rowsFinished + dstY;
+            return kIncompleteInput;
+        default:
+            return kInvalidInput;
+    }
 }
 
 SkWebpCodec::SkWebpCodec(SkEncodedInfo&& info, std::unique_ptr<SkStream> stream,
@@ -10,7 +10,10 @@
 #include "include/core/SkRect.h"
 #include "src/core/SkBitmapCache.h"
 #include "src/core/SkMipmap.h"
+#include "src/core/SkReadBuffer.h"
 #include "src/core/SkResourceCache.h"
+#include "src/core/SkResourceDiskCache.h"
+#include "src/core/SkWriteBuffer.h"
 #include "src/image/SkImage_Base.h"
 
 /**
@@ -30,7 +33,15 @@ void SkNotifyBitmapGenIDIsStale(uint32_t bitmapGenID) {
 SkBitmapCacheDesc SkBitmapCacheDesc::Make(uint32_t imageID, const SkIRect& subset) {
     SkASSERT(imageID);
     SkASSERT(subset.width() > 0 && subset.height() > 0);
-    return { imageID, subset };
+    return { imageID, subset, subset.size() };
+}
+
+SkBitmapCacheDesc SkBitmapCacheDesc::MakeScaled(uint32_t imageID, const SkIRect& subset,
+                                                SkISize dimensions) {
+    SkBitmapCacheDesc desc = Make(imageID, subset);
+    desc.fDimensions = dimensions;
+    desc.validate();
+    return desc;
 }
 
 SkBitmapCacheDesc SkBitmapCacheDesc::Make(const SkImage* image) {
@@ -50,6 +61,66 @@ public:
 
     const SkBitmapCacheDesc fDesc;
 };
+
+// Keys for SkResourceCache's disk cache. Unique IDs and namespace pointers mean nothing to
+// another process, so these use a tag and the image's content hash instead.
+struct DiskKey {
+    uint32_t fTag;
+    uint32_t fContentHashLo;
+    uint32_t fContentHashHi;
+    SkIRect  fSubset;
+    SkISize  fDimensions;
+};
+static_assert(sizeof(DiskKey) == 9 * sizeof(uint32_t), "DiskKey must not have padding");
+
+static constexpr uint32_t kBitmapDiskTag = SkSetFourByteTag('b', 'm', 'a', 'p');
+static constexpr uint32_t kMipmapDiskTag = SkSetFourByteTag('m', 'i', 'p', 's');
+
+static sk_sp<SkData> make_disk_key(uint32_t tag, const SkBitmapCacheDesc& desc,
+                                   uint64_t contentHash) {
+    const DiskKey key = { tag, (uint32_t)contentHash, (uint32_t)(contentHash >> 32),
+                          desc.fSubset, desc.fDimensions };
+    return SkData::MakeWithCopy(&key, sizeof(key));
+}
+
+static sk_sp<SkData> make_disk_meta(const SkImageInfo& info, int extra) {
+    SkBinaryWriteBuffer buffer;
+    buffer.writeInt(info.width());
+    buffer.writeInt(info.height());
+    buffer.writeUInt(info.colorType());
+    buffer.writeUInt(info.alphaType());
+    buffer.writeInt(extra);
+    buffer.writeDataAsByteArray(info.colorSpace() ? info.colorSpace()->serialize().get()
+                                                  : nullptr);
+    return buffer.snapshotAsData();
+}
+
+static bool read_disk_meta(const SkData& meta, SkImageInfo* info, int* extra) {
+    SkReadBuffer buffer(meta.data(), meta.size());
+    const int width  = buffer.readInt(),
+              height = buffer.readInt();
+    const auto ct = buffer.read32LE(kLastEnum_SkColorType);
+    const auto at = buffer.read32LE(kLastEnum_SkAlphaType);
+    *extra = buffer.readInt();
+    sk_sp<SkData> csData = buffer.readByteArrayAsData();
+    if (!buffer.isValid() || !csData) {
+        return false;
+    }
+    sk_sp<SkColorSpace> cs;
+    if (csData->size() > 0 && !(cs = SkColorSpace::Deserialize(csData->data(), csData->size()))) {
+        return false;
+    }
+    *info = SkImageInfo::Make(width, height, ct, at, std::move(cs));
+    return info->validRowBytes(info->minRowBytes());
+}
+
+// Wraps pixels owned by a ref-counted object (kept alive until the data is released).
+template <typename T>
+static sk_sp<SkData> make_disk_contents(const void* pixels, size_t size, const T* owner) {
+    return SkData::MakeWithProc(pixels, size,
+                                [](const void*, void* ctx) { static_cast<T*>(ctx)->unref(); },
+                                const_cast<T*>(SkRef(owner)));
+}
 }  // namespace
 
 //////////////////////
@@ -87,6 +158,7 @@ public:
     }
 
     const Key& getKey() const override { return fKey; }
+    const SkBitmapCacheDesc& desc() const { return fKey.fDesc; }
     size_t bytesUsed() const override {
         return sizeof(fKey) + fInfo.computeByteSize(fRowBytes);
     }
@@ -175,9 +247,8 @@ void SkBitmapCache::PrivateDeleteRec(Rec* rec) { delete rec; }
 
 SkBitmapCache::RecPtr SkBitmapCache::Alloc(const SkBitmapCacheDesc& desc, const SkImageInfo& info,
                                            SkPixmap* pmap) {
-    // Ensure that the info matches the subset (i.e. the subset is the entire image)
-    SkASSERT(info.width() == desc.fSubset.width());
-    SkASSERT(info.height() == desc.fSubset.height());
+    // Ensure that the info matches the cached size (the subset's, unless scaled down)
+    SkASSERT(info.dimensions() == desc.fDimensions);
 
     const size_t rb = info.minRowBytes();
     size_t size = info.computeByteSize(rb);
@@ -205,11 +276,55 @@ void SkBitmapCache::Add(RecPtr rec, SkBitmap* bitmap) {
     SkResourceCache::Add(rec.release(), bitmap);
 }
 
+void SkBitmapCache::Add(RecPtr rec, SkBitmap* bitmap, uint64_t contentHash) {
+    const SkBitmapCacheDesc desc = rec->desc();
+    Add(std::move(rec), bitmap);
+
+    SkResourceDiskCache* diskCache = SkResourceCache::GetDiskCache();
+    if (contentHash && diskCache && bitmap->getPixels()) {
+        // The pixels can't be purged from memory while the pixel ref is alive, so the write
+        // reads them in place.
+        const SkImageInfo& info = bitmap->info();
+        SkASSERT(bitmap->rowBytes() == info.minRowBytes());
+        diskCache->add(*make_disk_key(kBitmapDiskTag, desc, contentHash),
+                       make_disk_meta(info, 0),
+                       make_disk_contents(bitmap->getPixels(), bitmap->computeByteSize(),
+                                          bitmap->pixelRef()));
+    }
+}
+
 bool SkBitmapCache::Find(const SkBitmapCacheDesc& desc, SkBitmap* result) {
     desc.validate();
     return SkResourceCache::Find(BitmapKey(desc), SkBitmapCache::Rec::Finder, result);
 }
 
+bool SkBitmapCache::Find(const SkBitmapCacheDesc& desc, uint64_t contentHash, SkBitmap* result) {
+    if (Find(desc, result)) {
+        return true;
+    }
+    SkResourceDiskCache* diskCache = SkResourceCache::GetDiskCache();
+    if (!contentHash || !diskCache) {
+        return false;
+    }
+
+    sk_sp<SkData> meta, contents;
+    SkImageInfo info;
+    int unused;
+    if (!diskCache->find(*make_disk_key(kBitmapDiskTag, desc, contentHash), &meta, &contents) ||
+        !read_disk_meta(*meta, &info, &unused) || info.dimensions() != desc.fDimensions ||
+        contents->size() != info.computeMinByteSize()) {
+        return false;
+    }
+    SkPixmap pmap;
+    RecPtr rec = Alloc(desc, info, &pmap);
+    if (!rec) {
+        return false;
+    }
+    memcpy(pmap.writable_addr(), contents->data(), contents->size());
+    Add(std::move(rec), result);
+    return true;
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////////////////
 
@@ -284,17 +399,99 @@ static SkResourceCache::DiscardableFactory get_fact(SkResourceCache* localCache)
                       : SkResourceCache::GetDiscardableFactory();
 }
 
-const SkMipmap* SkMipmapCache::AddAndRef(const SkImage_Base* image, SkResourceCache* localCache) {
-    SkBitmap src;
-    if (!image->getROPixels(nullptr, &src)) {
+// The levels' pixels are contiguous, starting with the first level's, each at minRowBytes.
+static size_t mipmap_pixels_size(const SkMipmap& mipmap, const void** pixels) {
+    size_t size = 0;
+    for (int i = 0; i < mipmap.countLevels(); ++i) {
+        SkMipmap::Level level;
+        if (!mipmap.getLevel(i, &level)) {
+            return 0;
+        }
+        SkASSERT(level.fPixmap.rowBytes() == level.fPixmap.info().minRowBytes());
+        if (i == 0) {
+            *pixels = level.fPixmap.addr();
+        }
+        SkASSERT((const char*)level.fPixmap.addr() == (const char*)*pixels + size);
+        size += level.fPixmap.computeByteSize();
+    }
+    return size;
+}
+
+static SkResourceDiskCache* get_disk_cache(SkResourceCache* localCache) {
+    return localCache ? localCache->diskCache() : SkResourceCache::GetDiskCache();
+}
+
+static SkMipmap* find_on_disk(SkResourceDiskCache* diskCache, const SkBitmapCacheDesc& desc,
+                              uint64_t contentHash, SkResourceCache* localCache) {
+    sk_sp<SkData> meta, contents;
+    SkImageInfo info;
+    int levelCount;
+    if (!diskCache->find(*make_disk_key(kMipmapDiskTag, desc, contentHash), &meta, &contents) ||
+        !read_disk_meta(*meta, &info, &levelCount) || info.dimensions() != desc.fDimensions) {
         return nullptr;
     }
+    // Lay out the levels for the base size, then fill them in from the disk.
+    SkMipmap* mipmap = SkMipmap::Build(SkPixmap(info, nullptr, info.minRowBytes()),
+                                       get_fact(localCache), /*computeContents=*/false);
+    const void* pixels = nullptr;
+    if (!mipmap || mipmap->countLevels() != levelCount ||
+        mipmap_pixels_size(*mipmap, &pixels) != contents->size()) {
+        SkSafeUnref(mipmap);
+        return nullptr;
+    }
+    memcpy(const_cast<void*>(pixels), contents->data(), contents->size());
+    return mipmap;
+}
 
-    SkMipmap* mipmap = SkMipmap::Build(src, get_fact(localCache));
+static const SkMipmap* add_mipmap(const SkImage_Base* image, const SkBitmapCacheDesc& desc,
+                                  SkMipmap* mipmap, SkResourceCache* localCache) {
     if (mipmap) {
-        MipMapRec* rec = new MipMapRec(SkBitmapCacheDesc::Make(image), mipmap);
+        MipMapRec* rec = new MipMapRec(desc, mipmap);
         CHECK_LOCAL(localCache, add, Add, rec);
         image->notifyAddedToRasterCache();
     }
     return mipmap;
 }
+
+const SkMipmap* SkMipmapCache::AddAndRef(const SkImage_Base* image, SkResourceCache* localCache) {
+    const SkBitmapCacheDesc desc = SkBitmapCacheDesc::Make(image);
+    SkResourceDiskCache* diskCache = get_disk_cache(localCache);
+    const uint64_t contentHash = diskCache ? image->contentHash() : 0;
+    if (contentHash) {
+        // Levels from the disk need no base pixels at all, so look before decoding.
+        if (SkMipmap* mipmap = find_on_disk(diskCache, desc, contentHash, localCache)) {
+            return add_mipmap(image, desc, mipmap, localCache);
+        }
+    }
+
+    SkBitmap src;
+    if (!image->getROPixels(nullptr, &src)) {
+        return nullptr;
+    }
+    return AddAndRef(image, desc, src, localCache);
+}
+
+const SkMipmap* SkMipmapCache::AddAndRef(const SkImage_Base* image, const SkBitmapCacheDesc& desc,
+                                         const SkBitmap& src, SkResourceCache* localCache) {
+    SkASSERT(src.dimensions() == desc.fDimensions);
+    SkResourceDiskCache* diskCache = get_disk_cache(localCache);
+    const uint64_t contentHash = diskCache ? image->contentHash() : 0;
+    if (!contentHash) {
+        diskCache = nullptr;
+    }
+    if (diskCache) {
+        if (SkMipmap* mipmap = find_on_disk(diskCache, desc, contentHash, localCache)) {
+            return add_mipmap(image, desc, mipmap, localCache);
+        }
+    }
+
+    SkMipmap* mipmap = SkMipmap::Build(src, get_fact(localCache));
+    const void* pixels = nullptr;
+    size_t size;
+    if (mipmap && diskCache && (size = mipmap_pixels_size(*mipmap, &pixels)) > 0) {
+        diskCache->add(*make_disk_key(kMipmapDiskTag, desc, contentHash),
+                       make_disk_meta(src.info(), mipmap->countLevels()),
+                       make_disk_contents(pixels, size, mipmap));
+    }
+    return add_mipmap(image, desc, mipmap, localCache);
+}
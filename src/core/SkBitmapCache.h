@@ -26,15 +26,20 @@ void SkNotifyBitmapGenIDIsStale(uint32_t bitmapGenID);
 struct SkBitmapCacheDesc {
     uint32_t    fImageID;       // != 0
     SkIRect     fSubset;        // always set to a valid rect (entire or subset)
+    SkISize     fDimensions;    // size of the cached pixels: fSubset's size unless scaled down
 
     void validate() const {
         SkASSERT(fImageID);
         SkASSERT(fSubset.fLeft >= 0 && fSubset.fTop >= 0);
         SkASSERT(fSubset.width() > 0 && fSubset.height() > 0);
+        SkASSERT(fDimensions.width() > 0 && fDimensions.width() <= fSubset.width());
+        SkASSERT(fDimensions.height() > 0 && fDimensions.height() <= fSubset.height());
     }
 
     static SkBitmapCacheDesc Make(const SkImage*);
     static SkBitmapCacheDesc Make(uint32_t genID, const SkIRect& subset);
+    // For a subset decoded directly at a reduced size.
+    static SkBitmapCacheDesc MakeScaled(uint32_t genID, const SkIRect& subset, SkISize dimensions);
 };
 
 class SkBitmapCache {
@@ -44,6 +49,9 @@ public:
      *  result will be set to the matching bitmap with its pixels already locked.
      */
     static bool Find(const SkBitmapCacheDesc&, SkBitmap* result);
+    // Like Find(), but on a miss also looks in SkResourceCache's disk cache (if one is installed
+    // and contentHash isn't 0), moving anything found there into memory.
+    static bool Find(const SkBitmapCacheDesc&, uint64_t contentHash, SkBitmap* result);
 
     class Rec;
     struct RecDeleter { void operator()(Rec* r) { PrivateDeleteRec(r); } };
@@ -51,6 +59,8 @@ public:
 
     static RecPtr Alloc(const SkBitmapCacheDesc&, const SkImageInfo&, SkPixmap*);
     static void Add(RecPtr, SkBitmap*);
+    // Like Add(), but also queues the pixels to be written to the disk cache.
+    static void Add(RecPtr, SkBitmap*, uint64_t contentHash);
 
 private:
     static void PrivateDeleteRec(Rec*);
@@ -62,6 +72,10 @@ public:
                                       SkResourceCache* localCache = nullptr);
     static const SkMipmap* AddAndRef(const SkImage_Base*,
                                      SkResourceCache* localCache = nullptr);
+    // Builds the mips from src, which holds the image's pixels as described by desc (e.g. a
+    // scaled-down decode), and caches them under desc.
+    static const SkMipmap* AddAndRef(const SkImage_Base*, const SkBitmapCacheDesc& desc,
+                                     const SkBitmap& src, SkResourceCache* localCache = nullptr);
 };
 
 #endif
@@ -25,6 +25,8 @@
 #include "src/core/SkTLazy.h"
 #include "src/image/SkImage_Base.h"
 
+#include <algorithm>
+
 struct Bounder {
     SkRect  fBounds;
     bool    fHasBounds;
@@ -429,10 +431,36 @@ void SkBitmapDevice::drawImageRect(const SkImage* image, const SkRect* src, cons
     SkASSERT(dst.isSorted());
 
     SkBitmap bitmap;
-    // TODO: Elevate direct context requirement to public API and remove cheat.
-    auto dContext = as_IB(image)->directContext();
-    if (!as_IB(image)->getROPixels(dContext, &bitmap)) {
-        return;
+    // When drawing downscaled, a lazy image may be able to decode straight to a smaller size
+    // that still covers the draw; when drawing a small part of a large one, it may be able to
+    // decode just that part. In either case, draw from those pixels with src mapped onto them.
+    SkRect bitmapSrc;
+    SkIPoint bitmapOrigin;
+    SkSize drawScale;
+    SkMatrix srcToDevice = SkMatrix::Concat(
+            this->localToDevice(),
+            SkMatrix::RectToRect(src ? *src : SkRect::Make(image->bounds()), dst));
+    if (srcToDevice.decomposeScale(&drawScale, nullptr) &&
+        as_IB(image)->getScaledROPixels(std::max(drawScale.width(), drawScale.height()),
+                                        &bitmap)) {
+        if (src) {
+            bitmapSrc = SkMatrix::Scale(SkIntToScalar(bitmap.width())  / image->width(),
+                                        SkIntToScalar(bitmap.height()) / image->height())
+                                .mapRect(*src);
+            src = &bitmapSrc;
+        }
+    } else if (src &&
+               // Leave room for the filter to reach past src.
+               as_IB(image)->getSubsetROPixels(src->roundOut().makeOutset(2, 2), &bitmap,
+                                               &bitmapOrigin)) {
+        bitmapSrc = src->makeOffset(-bitmapOrigin.x(), -bitmapOrigin.y());
+        src = &bitmapSrc;
+    } else {
+        // TODO: Elevate direct context requirement to public API and remove cheat.
+        auto dContext = as_IB(image)->directContext();
+        if (!as_IB(image)->getROPixels(dContext, &bitmap)) {
+            return;
+        }
     }
 
     SkRect      bitmapBounds, tmpSrc, tmpDst;
@@ -5,14 +5,17 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkExecutor.h"
 #include "include/private/SkColorData.h"
 #include "include/private/SkHalf.h"
 #include "include/private/SkImageInfoPriv.h"
 #include "src/core/SkColorSpacePriv.h"
 #include "src/core/SkColorSpaceXformSteps.h"
 #include "src/core/SkConvertPixels.h"
+#include "src/core/SkExecutorPriv.h"
 #include "src/core/SkOpts.h"
 #include "src/core/SkRasterPipeline.h"
+#include "src/core/SkTaskGroup.h"
 
 static bool rect_memcpy(const SkImageInfo& dstInfo,       void* dstPixels, size_t dstRB,
                         const SkImageInfo& srcInfo, const void* srcPixels, size_t srcRB,
@@ -67,6 +70,54 @@ static bool swizzle_or_premul(const SkImageInfo& dstInfo,       void* dstPixels,
     return true;
 }
 
+static bool convert_to_8888(const SkImageInfo& dstInfo,       void* dstPixels, size_t dstRB,
+                            const SkImageInfo& srcInfo, const void* srcPixels, size_t srcRB,
+                            const SkColorSpaceXformSteps& steps) {
+    // These are the common readback conversions that would otherwise go through the pipeline.
+    // They only narrow or expand channels, so the color space and alpha type can't change.
+    if ((dstInfo.colorType() != kRGBA_8888_SkColorType &&
+         dstInfo.colorType() != kBGRA_8888_SkColorType) ||
+        steps.flags.mask() != 0b00000) {
+        return false;
+    }
+    const bool dstBGRA = dstInfo.colorType() == kBGRA_8888_SkColorType;
+
+    auto convert_rows = [&](auto fn, auto srcType) {
+        using T = decltype(srcType);
+        for (int y = 0; y < dstInfo.height(); y++) {
+            fn((uint32_t*)dstPixels, (const T*)srcPixels, dstInfo.width());
+            dstPixels = SkTAddOffset<void>(dstPixels, dstRB);
+            srcPixels = SkTAddOffset<const void>(srcPixels, srcRB);
+        }
+        return true;
+    };
+
+    switch (srcInfo.colorType()) {
+        case kRGB_565_SkColorType:
+            return convert_rows(dstBGRA ? SkOpts::RGB_565_to_BGR1
+                                        : SkOpts::RGB_565_to_RGB1, uint16_t());
+
+        case kRGBA_1010102_SkColorType:
+        case kBGRA_1010102_SkColorType: {
+            const bool swapRB = dstBGRA != (srcInfo.colorType() == kBGRA_1010102_SkColorType);
+            return convert_rows(swapRB ? SkOpts::RGBA_1010102_to_BGRA
+                                       : SkOpts::RGBA_1010102_to_RGBA, uint32_t());
+        }
+
+        case kRGBA_F16Norm_SkColorType:
+        case kRGBA_F16_SkColorType:
+            if (dstInfo.alphaType() == kPremul_SkAlphaType) {
+                return convert_rows(dstBGRA ? SkOpts::rgbA_F16_to_bgrA
+                                            : SkOpts::rgbA_F16_to_rgbA, uint64_t());
+            }
+            return convert_rows(dstBGRA ? SkOpts::RGBA_F16_to_BGRA
+                                        : SkOpts::RGBA_F16_to_RGBA, uint64_t());
+
+        default:
+            return false;
+    }
+}
+
 static bool convert_to_alpha8(const SkImageInfo& dstInfo,       void* vdst, size_t dstRB,
                               const SkImageInfo& srcInfo, const void*  src, size_t srcRB,
                               const SkColorSpaceXformSteps&) {
@@ -233,11 +284,42 @@ bool SkConvertPixels(const SkImageInfo& dstInfo,       void* dstPixels, size_t d
     SkColorSpaceXformSteps steps{srcInfo.colorSpace(), srcInfo.alphaType(),
                                  dstInfo.colorSpace(), dstInfo.alphaType()};
 
-    for (auto fn : {rect_memcpy, swizzle_or_premul, convert_to_alpha8}) {
-        if (fn(dstInfo, dstPixels, dstRB, srcInfo, srcPixels, srcRB, steps)) {
-            return true;
+    auto convert = [&](int top, int rows) {
+        SkImageInfo dstBand = dstInfo.makeWH(dstInfo.width(), rows),
+                    srcBand = srcInfo.makeWH(srcInfo.width(), rows);
+        void*       dst = SkTAddOffset<void>(dstPixels, dstRB * top);
+        const void* src = SkTAddOffset<const void>(srcPixels, srcRB * top);
+
+        for (auto fn : {rect_memcpy, swizzle_or_premul, convert_to_8888, convert_to_alpha8}) {
+            if (fn(dstBand, dst, dstRB, srcBand, src, srcRB, steps)) {
+                return;
+            }
         }
+        convert_with_pipeline(dstBand, dst, dstStride, srcBand, src, srcStride, steps);
+    };
+
+    // Large conversions are split into bands of rows on the default executor, unless it's the
+    // trivial one, which would just run the bands one after another on this thread.
+    constexpr int64_t kMinPixelsPerBand = 1 << 18;
+    constexpr int     kMaxBands         = 32;
+    SkExecutor& executor = SkExecutor::GetDefault();
+    const int bands = (int)std::min<int64_t>({(int64_t)dstInfo.width() * dstInfo.height()
+                                                      / kMinPixelsPerBand,
+                                              dstInfo.height(),
+                                              kMaxBands});
+    if (bands < 4 || SkExecutorIsTrivial(executor)) {
+        convert(0, dstInfo.height());
+        return true;
     }
-    convert_with_pipeline(dstInfo, dstPixels, dstStride, srcInfo, srcPixels, srcStride, steps);
+
+    const int rowsPerBand = (dstInfo.height() + bands - 1) / bands;
+    SkTaskGroup tg(executor);
+    tg.batch(bands, [&](int band) {
+        int top = band * rowsPerBand;
+        if (top < dstInfo.height()) {
+            convert(top, std::min(rowsPerBand, dstInfo.height() - top));
+        }
+    });
+    tg.wait();
     return true;
 }
@@ -0,0 +1,20 @@
+/*
+ * Copyright 2021 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkExecutorPriv_DEFINED
+#define SkExecutorPriv_DEFINED
+
+class SkExecutor;
+
+/**
+ *  Returns true if the executor is the trivial one that SkExecutor::GetDefault() returns when
+ *  no default has been set. It runs work right away on the calling thread, so splitting work
+ *  up for it only adds overhead.
+ */
+bool SkExecutorIsTrivial(const SkExecutor&);
+
+#endif  // SkExecutorPriv_DEFINED
@@ -30,6 +30,28 @@ bool SkImageGenerator::getPixels(const SkImageInfo& info, void* pixels, size_t r
     return this->onGetPixels(info, pixels, rowBytes, defaultOpts);
 }
 
+SkISize SkImageGenerator::getScaledDimensions(float desiredScale) const {
+    if (!(desiredScale > 0 && desiredScale < 1)) {
+        return fInfo.dimensions();
+    }
+    SkISize dims = this->onGetScaledDimensions(desiredScale);
+    if (dims.isEmpty() || dims.width() > fInfo.width() || dims.height() > fInfo.height()) {
+        return fInfo.dimensions();
+    }
+    return dims;
+}
+
+bool SkImageGenerator::getSubsetPixels(const SkIRect& subset, const SkPixmap& dst) {
+    if (kUnknown_SkColorType == dst.colorType() || nullptr == dst.addr()) {
+        return false;
+    }
+    if (subset.isEmpty() || !SkIRect::MakeSize(fInfo.dimensions()).contains(subset) ||
+        dst.dimensions() != subset.size()) {
+        return false;
+    }
+    return this->onGetSubsetPixels(subset, dst);
+}
+
 bool SkImageGenerator::queryYUVAInfo(const SkYUVAPixmapInfo::SupportedDataTypes& supportedDataTypes,
                                      SkYUVAPixmapInfo* yuvaPixmapInfo) const {
     SkASSERT(yuvaPixmapInfo);
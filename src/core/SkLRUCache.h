@@ -80,6 +80,15 @@ public:
         return fMap.count();
     }
 
+    // Removes the least recently used entry and returns its value. The cache must not be empty.
+    V removeLeastRecentlyUsed() {
+        Entry* tail = fLRU.tail();
+        SkASSERT(tail);
+        V value = std::move(tail->fValue);
+        this->remove(tail->fKey);
+        return value;
+    }
+
     template <typename Fn>  // f(K*, V*)
     void foreach(Fn&& fn) {
         typename SkTInternalLList<Entry>::Iter iter;
@@ -16,6 +16,8 @@
 #include "src/core/SkMathPriv.h"
 #include "src/core/SkMipmap.h"
 #include "src/core/SkMipmapBuilder.h"
+#include "src/core/SkTaskGroup.h"
+#include <memory>
 #include <new>
 
 //
@@ -382,6 +384,143 @@ template <typename F> void downsample_3_3(void* dst, const void* src, size_t src
     }
 }
 
+// Vectorized 2x2 box filters for the most common formats. These produce the same results as the
+// generic downsample_2_2<> templates (the tails are handled by those), just many pixels at a time.
+// They lean on skvx::cast() and skvx::shuffle(), which are only single instructions when built
+// with Clang's vector builtins; elsewhere they'd lose to the per-pixel templates.
+#if !defined(SKNX_NO_SIMD) && defined(__clang__)
+
+static void downsample_2_2_8888(void* dst, const void* src, size_t srcRB, int count) {
+    SkASSERT(count > 0);
+    auto p0 = static_cast<const uint32_t*>(src);
+    auto p1 = (const uint32_t*)((const char*)p0 + srcRB);
+    auto d = static_cast<uint32_t*>(dst);
+
+    // Split each pixel into two 16-bit-per-channel halves (R_B_ and _G_A): summing 4 pixels
+    // (at most 4*255 per channel) never carries into the next channel.
+    using U32 = skvx::Vec<8, uint32_t>;
+    auto evens = [](const skvx::Vec<16, uint32_t>& x) {
+        return skvx::shuffle<0,2,4,6,8,10,12,14>(x);
+    };
+    auto odds = [](const skvx::Vec<16, uint32_t>& x) {
+        return skvx::shuffle<1,3,5,7,9,11,13,15>(x);
+    };
+
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        auto r0 = skvx::Vec<16, uint32_t>::Load(p0),
+             r1 = skvx::Vec<16, uint32_t>::Load(p1);
+        U32 c00 = evens(r0), c01 = odds(r0),
+            c10 = evens(r1), c11 = odds(r1);
+
+        U32 rb = (c00 & 0x00ff00ff) + (c01 & 0x00ff00ff) +
+                 (c10 & 0x00ff00ff) + (c11 & 0x00ff00ff);
+        U32 ga = ((c00 >> 8) & 0x00ff00ff) + ((c01 >> 8) & 0x00ff00ff) +
+                 ((c10 >> 8) & 0x00ff00ff) + ((c11 >> 8) & 0x00ff00ff);
+        U32 c = ((rb >> 2) & 0x00ff00ff) | (((ga >> 2) & 0x00ff00ff) << 8);
+        c.store(d + i);
+        p0 += 16;
+        p1 += 16;
+    }
+    if (i < count) {
+        downsample_2_2<ColorTypeFilter_8888>(d + i, p0, srcRB, count - i);
+    }
+}
+
+static void downsample_2_2_8(void* dst, const void* src, size_t srcRB, int count) {
+    SkASSERT(count > 0);
+    auto p0 = static_cast<const uint8_t*>(src);
+    auto p1 = p0 + srcRB;
+    auto d = static_cast<uint8_t*>(dst);
+
+    // Widen to 16 bits, then view each horizontal pair as one 32-bit lane.
+    using U8x32  = skvx::Vec<32, uint8_t>;
+    using U32x16 = skvx::Vec<16, uint32_t>;
+    auto load = [](const uint8_t* p) {
+        return skvx::bit_pun<U32x16>(skvx::cast<uint16_t>(U8x32::Load(p)));
+    };
+
+    int i = 0;
+    for (; i + 16 <= count; i += 16) {
+        U32x16 c = load(p0) + load(p1);
+        skvx::cast<uint8_t>(((c & 0xffff) + (c >> 16)) >> 2).store(d + i);
+        p0 += 32;
+        p1 += 32;
+    }
+    if (i < count) {
+        downsample_2_2<ColorTypeFilter_8>(d + i, p0, srcRB, count - i);
+    }
+}
+
+// Bit-exact equivalents of SkHalfToFloat_finite_ftz() and SkFloatToHalf_finite_ftz().
+template <int N>
+static skvx::Vec<N, float> skvx_half_to_float(const skvx::Vec<N, uint16_t>& h) {
+#if defined(SK_CPU_ARM64)
+    return skvx::from_half(h);
+#else
+    // Not skvx::from_half_finite_ftz(): that flushes negative denormals (and -0) to +0, while
+    // SkHalfToFloat_finite_ftz() keeps the sign.
+    using I = skvx::Vec<N, int32_t>;
+    I bits     = skvx::cast<int32_t>(h),
+      sign     = bits & 0x00008000,
+      positive = bits ^ sign,
+      is_norm  = skvx::bit_pun<I>(0x03ff < positive);
+    I norm = (positive << 13) + ((127 - 15) << 23);
+    return skvx::bit_pun<skvx::Vec<N, float>>((sign << 16) | (norm & is_norm));
+#endif
+}
+
+template <int N>
+static skvx::Vec<N, uint16_t> skvx_float_to_half(const skvx::Vec<N, float>& f) {
+#if defined(SK_CPU_ARM64)
+    return skvx::to_half(f);
+#else
+    using I = skvx::Vec<N, int32_t>;
+    I bits     = skvx::bit_pun<I>(f),
+      sign     = bits & 0x80000000,
+      positive = bits ^ sign;
+    I will_be_norm = skvx::bit_pun<I>(0x387fdfff < positive);
+    I norm = (positive - ((127 - 15) << 23)) >> 13;
+    return skvx::cast<uint16_t>((sign >> 16) | (will_be_norm & norm));
+#endif
+}
+
+static void downsample_2_2_RGBA_F16(void* dst, const void* src, size_t srcRB, int count) {
+    SkASSERT(count > 0);
+    auto p0 = static_cast<const uint64_t*>(src);
+    auto p1 = (const uint64_t*)((const char*)p0 + srcRB);
+    auto d = static_cast<uint64_t*>(dst);
+
+    // Convert two source pixels (one 2x1 pair) per row at a time; .lo/.hi are the two pixels.
+    using H = skvx::Vec<16, uint16_t>;
+    int i = 0;
+    for (; i + 2 <= count; i += 2) {
+        auto r0 = skvx_half_to_float(H::Load(p0)),
+             r1 = skvx_half_to_float(H::Load(p1));
+        // Same summation order as downsample_2_2<ColorTypeFilter_RGBA_F16>.
+        auto c = skvx::join(r0.lo.lo + r1.lo.lo + r0.lo.hi + r1.lo.hi,
+                            r0.hi.lo + r1.hi.lo + r0.hi.hi + r1.hi.hi);
+        skvx_float_to_half(c * 0.25f).store(d + i);
+        p0 += 4;
+        p1 += 4;
+    }
+    if (i < count) {
+        downsample_2_2<ColorTypeFilter_RGBA_F16>(d + i, p0, srcRB, count - i);
+    }
+}
+
+#else
+static void downsample_2_2_8888(void* dst, const void* src, size_t srcRB, int count) {
+    downsample_2_2<ColorTypeFilter_8888>(dst, src, srcRB, count);
+}
+static void downsample_2_2_8(void* dst, const void* src, size_t srcRB, int count) {
+    downsample_2_2<ColorTypeFilter_8>(dst, src, srcRB, count);
+}
+static void downsample_2_2_RGBA_F16(void* dst, const void* src, size_t srcRB, int count) {
+    downsample_2_2<ColorTypeFilter_RGBA_F16>(dst, src, srcRB, count);
+}
+#endif
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
 size_t SkMipmap::AllocLevelsSize(int levelCount, size_t pixelSize) {
@@ -396,7 +535,7 @@ size_t SkMipmap::AllocLevelsSize(int levelCount, size_t pixelSize) {
 }
 
 SkMipmap* SkMipmap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact,
-                          bool computeContents) {
+                          bool computeContents, SkExecutor* executor) {
     typedef void FilterProc(void*, const void* srcPtr, size_t srcRB, int count);
 
     FilterProc* proc_1_2 = nullptr;
@@ -417,7 +556,7 @@ SkMipmap* SkMipmap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact,
             proc_1_2 = downsample_1_2<ColorTypeFilter_8888>;
             proc_1_3 = downsample_1_3<ColorTypeFilter_8888>;
             proc_2_1 = downsample_2_1<ColorTypeFilter_8888>;
-            proc_2_2 = downsample_2_2<ColorTypeFilter_8888>;
+            proc_2_2 = downsample_2_2_8888;
             proc_2_3 = downsample_2_3<ColorTypeFilter_8888>;
             proc_3_1 = downsample_3_1<ColorTypeFilter_8888>;
             proc_3_2 = downsample_3_2<ColorTypeFilter_8888>;
@@ -448,7 +587,7 @@ SkMipmap* SkMipmap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact,
             proc_1_2 = downsample_1_2<ColorTypeFilter_8>;
             proc_1_3 = downsample_1_3<ColorTypeFilter_8>;
             proc_2_1 = downsample_2_1<ColorTypeFilter_8>;
-            proc_2_2 = downsample_2_2<ColorTypeFilter_8>;
+            proc_2_2 = downsample_2_2_8;
             proc_2_3 = downsample_2_3<ColorTypeFilter_8>;
             proc_3_1 = downsample_3_1<ColorTypeFilter_8>;
             proc_3_2 = downsample_3_2<ColorTypeFilter_8>;
@@ -459,7 +598,7 @@ SkMipmap* SkMipmap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact,
             proc_1_2 = downsample_1_2<ColorTypeFilter_RGBA_F16>;
             proc_1_3 = downsample_1_3<ColorTypeFilter_RGBA_F16>;
             proc_2_1 = downsample_2_1<ColorTypeFilter_RGBA_F16>;
-            proc_2_2 = downsample_2_2<ColorTypeFilter_RGBA_F16>;
+            proc_2_2 = downsample_2_2_RGBA_F16;
             proc_2_3 = downsample_2_3<ColorTypeFilter_RGBA_F16>;
             proc_3_1 = downsample_3_1<ColorTypeFilter_RGBA_F16>;
             proc_3_2 = downsample_3_2<ColorTypeFilter_RGBA_F16>;
@@ -590,6 +729,10 @@ SkMipmap* SkMipmap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact,
     // large as 8 (for F16 pixels). See the comment on SkMipmap::Level.
     SkASSERT(SkIsAlign8((uintptr_t)addr));
 
+    // Don't bother splitting levels (or spinning up a task group) below this size.
+    static constexpr int64_t kMinPixelsPerBand = 64 * 1024;
+    std::unique_ptr<SkTaskGroup> taskGroup;
+
     for (int i = 0; i < countLevels; ++i) {
         FilterProc* proc;
         if (height & 1) {
@@ -634,14 +777,32 @@ SkMipmap* SkMipmap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact,
 
         const SkPixmap& dstPM = levels[i].fPixmap;
         if (computeContents) {
-            const void* srcBasePtr = srcPM.addr();
-            void* dstBasePtr = dstPM.writable_addr();
-
             const size_t srcRB = srcPM.rowBytes();
-            for (int y = 0; y < height; y++) {
-                proc(dstBasePtr, srcBasePtr, srcRB, width);
-                srcBasePtr = (char*)srcBasePtr + srcRB * 2; // jump two rows
-                dstBasePtr = (char*)dstBasePtr + dstPM.rowBytes();
+            auto downsampleRows = [&, proc, width](int y0, int y1) {
+                const void* srcBasePtr = srcPM.addr(0, 2 * y0);
+                void* dstBasePtr = dstPM.writable_addr(0, y0);
+                for (int y = y0; y < y1; y++) {
+                    proc(dstBasePtr, srcBasePtr, srcRB, width);
+                    srcBasePtr = (char*)srcBasePtr + srcRB * 2; // jump two rows
+                    dstBasePtr = (char*)dstBasePtr + dstPM.rowBytes();
+                }
+            };
+
+            // Each destination row only depends on the source, so large levels are split into
+            // horizontal bands and filtered concurrently. Levels themselves are still serial.
+            const int bands = std::min<int64_t>(height,
+                                                sk_64_mul(width, height) / kMinPixelsPerBand);
+            if (bands > 1) {
+                if (!taskGroup) {
+                    taskGroup = std::make_unique<SkTaskGroup>(
+                            executor ? *executor : SkExecutor::GetDefault());
+                }
+                taskGroup->batch(bands, [&](int band) {
+                    downsampleRows(height * band / bands, height * (band + 1) / bands);
+                });
+                taskGroup->wait();
+            } else {
+                downsampleRows(0, height);
             }
         }
         srcPM = dstPM;
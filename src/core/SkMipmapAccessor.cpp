@@ -14,6 +14,8 @@
 #include "src/core/SkMipmapAccessor.h"
 #include "src/image/SkImage_Base.h"
 
+#include <algorithm>
+
 // Try to load from the base image, or from the cache
 static sk_sp<const SkMipmap> try_load_mips(const SkImage_Base* image) {
     sk_sp<const SkMipmap> mips = image->refMips();
@@ -26,23 +28,50 @@ static sk_sp<const SkMipmap> try_load_mips(const SkImage_Base* image) {
     return mips;
 }
 
+// Mips built from a scaled-down decode of the image are cached under that decode's desc.
+static sk_sp<const SkMipmap> try_load_scaled_mips(const SkImage_Base* image,
+                                                  const SkBitmap& scaledBase) {
+    auto desc = SkBitmapCacheDesc::MakeScaled(image->uniqueID(), image->bounds(),
+                                              scaledBase.dimensions());
+    sk_sp<const SkMipmap> mips(SkMipmapCache::FindAndRef(desc));
+    if (!mips) {
+        mips.reset(SkMipmapCache::AddAndRef(image, desc, scaledBase));
+    }
+    return mips;
+}
+
 SkMipmapAccessor::SkMipmapAccessor(const SkImage_Base* image, const SkMatrix& inv,
                                    SkMipmapMode requestedMode) {
     fResolvedMode = requestedMode;
     fLowerWeight = 0;
 
+    SkSize scale;
+    bool hasScale = inv.decomposeScale(&scale, nullptr);
+
+    // When drawing downscaled, a lazy image may be able to decode straight to a smaller size
+    // that still covers the draw (e.g. JPEG DCT scaling). That decode then stands in for the
+    // full-size pixels as the base level, and any mips are built from it.
+    bool scaledBase = false;
+    if (hasScale) {
+        float drawScale = std::max(1 / scale.width(), 1 / scale.height());
+        if (drawScale < 1 && image->getScaledROPixels(drawScale, &fBaseStorage)) {
+            scaledBase = true;
+            scale.set(scale.width()  * fBaseStorage.width()  / image->width(),
+                      scale.height() * fBaseStorage.height() / image->height());
+        }
+    }
+
     auto load_upper_from_base = [&]() {
         // only do this once
         if (fBaseStorage.getPixels() == nullptr) {
             (void)image->getROPixels(nullptr, &fBaseStorage);
-            fUpper.reset(fBaseStorage.info(), fBaseStorage.getPixels(), fBaseStorage.rowBytes());
         }
+        fUpper.reset(fBaseStorage.info(), fBaseStorage.getPixels(), fBaseStorage.rowBytes());
     };
 
     float level = 0;
     if (requestedMode != SkMipmapMode::kNone) {
-        SkSize scale;
-        if (!inv.decomposeScale(&scale, nullptr)) {
+        if (!hasScale) {
             fResolvedMode = SkMipmapMode::kNone;
         } else {
             level = SkMipmap::ComputeLevel({1/scale.width(), 1/scale.height()});
@@ -67,7 +96,7 @@ SkMipmapAccessor::SkMipmapAccessor(const SkImage_Base* image, const SkMatrix& in
     }
     // load fCurrMip if needed
     if (levelNum > 0 || (fResolvedMode == SkMipmapMode::kLinear && lowerWeight > 0)) {
-        fCurrMip = try_load_mips(image);
+        fCurrMip = scaledBase ? try_load_scaled_mips(image, fBaseStorage) : try_load_mips(image);
         if (!fCurrMip) {
             load_upper_from_base();
             fResolvedMode = SkMipmapMode::kNone;
@@ -73,6 +73,15 @@ namespace SkOpts {
     DEFINE_DEFAULT(inverted_CMYK_to_RGB1);
     DEFINE_DEFAULT(inverted_CMYK_to_BGR1);
 
+    DEFINE_DEFAULT(RGB_565_to_RGB1);
+    DEFINE_DEFAULT(RGB_565_to_BGR1);
+    DEFINE_DEFAULT(RGBA_1010102_to_RGBA);
+    DEFINE_DEFAULT(RGBA_1010102_to_BGRA);
+    DEFINE_DEFAULT(RGBA_F16_to_RGBA);
+    DEFINE_DEFAULT(RGBA_F16_to_BGRA);
+    DEFINE_DEFAULT(rgbA_F16_to_rgbA);
+    DEFINE_DEFAULT(rgbA_F16_to_bgrA);
+
     DEFINE_DEFAULT(memset16);
     DEFINE_DEFAULT(memset32);
     DEFINE_DEFAULT(memset64);
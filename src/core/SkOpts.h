@@ -46,6 +46,20 @@ namespace SkOpts {
                            grayA_to_RGBA,   // i.e. expand to color channels
                            grayA_to_rgbA;   // i.e. expand to color channels and premultiply
 
+    // Convert other pixel formats into 8888 without changing color space or alpha type.
+    typedef void (*Convert_8888_u16)(uint32_t*, const uint16_t*, int);
+    extern Convert_8888_u16 RGB_565_to_RGB1,    // i.e. expand to 8 bits + an opaque alpha
+                            RGB_565_to_BGR1;    // i.e. swap RB and expand + an opaque alpha
+
+    extern Swizzle_8888_u32 RGBA_1010102_to_RGBA,  // i.e. narrow to 8 bits
+                            RGBA_1010102_to_BGRA;  // i.e. swap RB and narrow to 8 bits
+
+    typedef void (*Convert_8888_u64)(uint32_t*, const uint64_t*, int);
+    extern Convert_8888_u64 RGBA_F16_to_RGBA,   // i.e. clamp and narrow to 8 bits
+                            RGBA_F16_to_BGRA,   // i.e. swap RB, clamp and narrow
+                            rgbA_F16_to_rgbA,   // i.e. clamp to premul and narrow
+                            rgbA_F16_to_bgrA;   // i.e. swap RB, clamp to premul and narrow
+
     extern void (*memset16)(uint16_t[], uint16_t, int);
     extern void SK_SPI(*memset32)(uint32_t[], uint32_t, int);
     extern void (*memset64)(uint64_t[], uint64_t, int);
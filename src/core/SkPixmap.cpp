@@ -9,6 +9,7 @@
 
 #include "include/core/SkBitmap.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkSurface.h"
 #include "include/core/SkUnPreMultiply.h"
 #include "include/private/SkColorData.h"
@@ -24,6 +25,7 @@
 #include "src/core/SkMatrixProvider.h"
 #include "src/core/SkPixmapPriv.h"
 #include "src/core/SkRasterClip.h"
+#include "src/core/SkResamplePixels.h"
 #include "src/core/SkUtils.h"
 #include "src/image/SkReadPixelsRec.h"
 #include "src/shaders/SkImageShader.h"
@@ -228,6 +230,12 @@ bool SkPixmap::scalePixels(const SkPixmap& actualDst, const SkSamplingOptions& s
         clampAsIfUnpremul = true;
     }
 
+    // Cubic resampling between 8888 pixmaps has a dedicated separable engine, banded across
+    // the default executor.  Everything else draws through an image shader.
+    if (SkResamplePixels(dst, src, sampling, clampAsIfUnpremul, &SkExecutor::GetDefault())) {
+        return true;
+    }
+
     SkBitmap bitmap;
     if (!bitmap.installPixels(src)) {
         return false;
@@ -0,0 +1,177 @@
+/*
+ * Copyright 2021 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkResamplePixels.h"
+
+#include "include/core/SkColorSpace.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkM44.h"
+#include "include/core/SkPixmap.h"
+#include "include/core/SkSamplingOptions.h"
+#include "include/private/SkTemplates.h"
+#include "include/private/SkVx.h"
+#include "src/core/SkExecutorPriv.h"
+#include "src/core/SkTaskGroup.h"
+#include "src/shaders/SkImageShader.h"
+
+#include <climits>
+
+namespace {
+
+using F4 = skvx::Vec<4,float>;
+
+// Each destination pixel reads 4 source pixels along an axis, all weighted by the cubic at the
+// same fractional offset.  fFirst is the unclamped index of the first tap.
+struct Taps {
+    int   fFirst;
+    int   fIndex[4];
+    float fWeight[4];
+};
+
+// SkImageShader maps dst pixel centers back into src and samples at -1.5, -0.5, +0.5, and +1.5
+// pixels from there, clamping to the edges.  The weights are the rows of the resampler matrix
+// dotted with {1, t, t^2, t^3}, as in SkImageShader::onProgram().
+void compute_taps(Taps taps[], int dstLen, int srcLen, const SkM44& weights) {
+    const float scale = (float)srcLen / dstLen;
+    for (int i = 0; i < dstLen; i++) {
+        float s = (i + 0.5f) * scale + 0.5f,
+              t = s - floorf(s);
+
+        taps[i].fFirst = (int)floorf(s) - 2;
+        for (int k = 0; k < 4; k++) {
+            SkV4 w = weights.row(k);
+            taps[i].fIndex [k] = SkTPin(taps[i].fFirst + k, 0, srcLen - 1);
+            taps[i].fWeight[k] = w[0] + t*(w[1] + t*(w[2] + t*w[3]));
+        }
+    }
+}
+
+F4 load(const uint32_t* px) {
+    return skvx::cast<float>(skvx::Vec<4,uint8_t>::Load(px));
+}
+
+// Filters dst rows [top, bottom).  Colors stay in [0,255] floats until the final store.
+void resample_rows(const SkPixmap& dst, const SkPixmap& src,
+                   const Taps xtaps[], const Taps ytaps[], int top, int bottom,
+                   bool swapRB, bool clampToOne) {
+    const int width = dst.width();
+
+    // Horizontally filtered source rows.  The rows a dst row needs are consecutive, so the row
+    // with unclamped index i always lives in slot i&3, and slots are reused down the band.
+    SkAutoTMalloc<F4> rows(4 * width);
+    int slotRow[4] = { INT_MIN, INT_MIN, INT_MIN, INT_MIN };
+
+    auto filter_row = [&](int y, F4* out) {
+        const uint32_t* row = src.addr32(0, y);
+        for (int x = 0; x < width; x++) {
+            const Taps& t = xtaps[x];
+            out[x] = load(row + t.fIndex[0]) * t.fWeight[0]
+                   + load(row + t.fIndex[1]) * t.fWeight[1]
+                   + load(row + t.fIndex[2]) * t.fWeight[2]
+                   + load(row + t.fIndex[3]) * t.fWeight[3];
+        }
+    };
+
+    for (int y = top; y < bottom; y++) {
+        const Taps& t = ytaps[y];
+        const F4* r[4];
+        for (int k = 0; k < 4; k++) {
+            int i = t.fFirst + k,
+                slot = i & 3;
+            if (slotRow[slot] != i) {
+                filter_row(t.fIndex[k], rows.get() + slot * width);
+                slotRow[slot] = i;
+            }
+            r[k] = rows.get() + slot * width;
+        }
+
+        uint32_t* d = dst.writable_addr32(0, y);
+        for (int x = 0; x < width; x++) {
+            F4 c = r[0][x] * t.fWeight[0]
+                 + r[1][x] * t.fWeight[1]
+                 + r[2][x] * t.fWeight[2]
+                 + r[3][x] * t.fWeight[3];
+
+            // Cubics overshoot on both sides, so clamp like SkImageShader's clamp_0 and
+            // clamp_1 or clamp_a.  The alpha lane is its own limit in the clamp_a case.
+            c = skvx::min(skvx::max(c, 0.0f), 255.0f);
+            if (!clampToOne) {
+                c = skvx::min(c, c[3]);
+            }
+            if (swapRB) {
+                c = skvx::shuffle<2,1,0,3>(c);
+            }
+            skvx::cast<uint8_t>(skvx::cast<int32_t>(c + 0.5f)).store(d + x);
+        }
+    }
+}
+
+}  // namespace
+
+bool SkResamplePixels(const SkPixmap& dst, const SkPixmap& src, const SkSamplingOptions& sampling,
+                      bool clampAsIfUnpremul, SkExecutor* executor) {
+    // Linear and nearest sampling of 8888 usually draws with fixed-point legacy shader
+    // contexts, and mipmaps need more than one source, so those still draw.
+    if (!sampling.useCubic) {
+        return false;
+    }
+    auto is_unit = [](float x) { return x >= 0 && x <= 1; };
+    if (!is_unit(sampling.cubic.B) || !is_unit(sampling.cubic.C)) {
+        return false;
+    }
+
+    auto is_8888 = [](SkColorType ct) {
+        return ct == kRGBA_8888_SkColorType || ct == kBGRA_8888_SkColorType;
+    };
+    if (!is_8888(src.colorType()) || !is_8888(dst.colorType()) ||
+        src.alphaType() == kUnpremul_SkAlphaType ||
+        dst.alphaType() == kUnpremul_SkAlphaType ||
+        !SkColorSpace::Equals(src.colorSpace(), dst.colorSpace())) {
+        return false;
+    }
+    if (src.width() <= 0 || src.height() <= 0 || dst.width() <= 0 || dst.height() <= 0) {
+        return false;
+    }
+
+    const SkM44 weights = SkImageShader::CubicResamplerMatrix(sampling.cubic.B, sampling.cubic.C);
+    SkAutoTMalloc<Taps> xtaps(dst.width()),
+                        ytaps(dst.height());
+    compute_taps(xtaps.get(), dst.width(),  src.width(),  weights);
+    compute_taps(ytaps.get(), dst.height(), src.height(), weights);
+
+    const bool swapRB = src.colorType() != dst.colorType();
+
+    // Each band refilters up to 3 source rows its neighbor already filtered,
+    // so keep bands large enough for that not to matter. The trivial executor
+    // would just run the bands one after another on this thread, so don't band for it.
+    constexpr int64_t kMinPixelsPerBand = 1 << 16;
+    constexpr int     kMaxBands         = 32;
+    const int bands = executor && !SkExecutorIsTrivial(*executor)
+                    ? (int)std::min<int64_t>({(int64_t)dst.width() * dst.height()
+                                                      / kMinPixelsPerBand,
+                                              dst.height() / 4,
+                                              kMaxBands})
+                    : 1;
+    if (bands < 2) {
+        resample_rows(dst, src, xtaps.get(), ytaps.get(), 0, dst.height(),
+                      swapRB, clampAsIfUnpremul);
+        return true;
+    }
+
+    const int rowsPerBand = (dst.height() + bands - 1) / bands;
+    SkTaskGroup tg(*executor);
+    tg.batch(bands, [&](int band) {
+        int top    = band * rowsPerBand,
+            bottom = std::min(top + rowsPerBand, dst.height());
+        if (top < bottom) {
+            resample_rows(dst, src, xtaps.get(), ytaps.get(), top, bottom,
+                          swapRB, clampAsIfUnpremul);
+        }
+    });
+    tg.wait();
+    return true;
+}
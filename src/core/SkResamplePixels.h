@@ -0,0 +1,30 @@
+/*
+ * Copyright 2021 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkResamplePixels_DEFINED
+#define SkResamplePixels_DEFINED
+
+#include "include/core/SkTypes.h"
+
+class SkExecutor;
+class SkPixmap;
+struct SkSamplingOptions;
+
+/**
+ *  Scales src to fill dst with separable filters, producing the same pixels (to within rounding)
+ *  as drawing src into dst with a clamped SkImageShader and kSrc blending.  Large destinations
+ *  are split into bands of rows run on the executor, unless it is null or the trivial one.
+ *
+ *  Returns false without touching dst if the sampling or pixel formats aren't handled here.
+ *  Only cubic resampling between 8888 formats with matching color spaces is handled, and
+ *  neither pixmap may be unpremul.  clampAsIfUnpremul means the same as for SkImageShader.
+ */
+bool SK_WARN_UNUSED_RESULT SkResamplePixels(const SkPixmap& dst, const SkPixmap& src,
+                                            const SkSamplingOptions&, bool clampAsIfUnpremul,
+                                            SkExecutor*);
+
+#endif
@@ -15,7 +15,9 @@
 #include "src/core/SkMessageBus.h"
 #include "src/core/SkMipmap.h"
 #include "src/core/SkOpts.h"
+#include "src/core/SkSharedMutex.h"
 
+#include <atomic>
 #include <stddef.h>
 #include <stdlib.h>
 
@@ -75,6 +77,97 @@ namespace {
 class SkResourceCache::Hash :
     public SkTHashTable<SkResourceCache::Rec*, SkResourceCache::Key, HashTraits> {};
 
+SkResourceCache::Shards::Shards() {
+    for (int i = 0; i < kCount; ++i) {
+#ifdef SK_USE_DISCARDABLE_SCALEDIMAGECACHE
+        fShards[i].fCache = std::make_unique<SkResourceCache>(SkDiscardableMemory::Create);
+#else
+        fShards[i].fCache = std::make_unique<SkResourceCache>(
+                SliceOf(SK_DEFAULT_IMAGE_CACHE_LIMIT, i));
+#endif
+        fShards[i].fCache->fShards = this;
+    }
+#ifndef SK_USE_DISCARDABLE_SCALEDIMAGECACHE
+    fTotalByteLimit = SK_DEFAULT_IMAGE_CACHE_LIMIT;
+#endif
+}
+
+SkResourceCache::Shards::Shards(size_t byteLimit) {
+    for (int i = 0; i < kCount; ++i) {
+        fShards[i].fCache = std::make_unique<SkResourceCache>(SliceOf(byteLimit, i));
+        fShards[i].fCache->fShards = this;
+    }
+    fTotalByteLimit = byteLimit;
+}
+
+bool SkResourceCache::Shards::find(const Key& key, FindVisitor visitor, void* context) {
+    Shard& shard = fShards[IndexFor(key)];
+    uint64_t staleGeneration;
+    {
+        SkAutoSharedMutexShared am(shard.fMutex);
+        if (shard.fCache->findShared(key, visitor, context, &staleGeneration)) {
+            return true;
+        }
+    }
+    if (staleGeneration) {
+        SkAutoSharedMutexExclusive am(shard.fMutex);
+        shard.fCache->removeStale(key, staleGeneration);
+    }
+    return false;
+}
+
+void SkResourceCache::Shards::add(Rec* rec, void* payload) {
+    {
+        Shard& shard = fShards[IndexFor(rec->getKey())];
+        SkAutoSharedMutexExclusive am(shard.fMutex);
+        shard.fCache->add(rec, payload);
+    }
+    this->purgeIfOverBudget();
+}
+
+void SkResourceCache::Shards::purgeIfOverBudget() {
+    // Discardable shards have no byte budget.
+    if (this->discardableFactory()) {
+        return;
+    }
+    // The shard that was just added to has already purged down to its slice, if it was over it.
+    // Others may have grown past theirs while the rest were empty; trim them now. Only one
+    // shard's lock is held at a time.
+    for (int i = 0; i < kCount && fTotalBytesUsed >= fTotalByteLimit; ++i) {
+        SkAutoSharedMutexExclusive am(fShards[i].fMutex);
+        fShards[i].fCache->purgeAsNeeded();
+    }
+}
+
+void SkResourceCache::Shards::visitAll(Visitor visitor, void* context) {
+    for (Shard& shard : fShards) {
+        SkAutoSharedMutexExclusive am(shard.fMutex);
+        shard.fCache->visitAll(visitor, context);
+    }
+}
+
+void SkResourceCache::Shards::purgeAll() {
+    for (Shard& shard : fShards) {
+        SkAutoSharedMutexExclusive am(shard.fMutex);
+        shard.fCache->purgeAll();
+    }
+}
+
+void SkResourceCache::Shards::dump() {
+    for (Shard& shard : fShards) {
+        SkAutoSharedMutexExclusive am(shard.fMutex);
+        shard.fCache->dump();
+    }
+}
+
+size_t SkResourceCache::Shards::setTotalByteLimit(size_t newLimit) {
+    size_t prevLimit = fTotalByteLimit.exchange(newLimit);
+    for (int i = 0; i < kCount; ++i) {
+        SkAutoSharedMutexExclusive am(fShards[i].fMutex);
+        fShards[i].fCache->setTotalByteLimit(SliceOf(newLimit, i));
+    }
+    return prevLimit;
+}
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -89,6 +182,10 @@ void SkResourceCache::init() {
     // One of these should be explicit set by the caller after we return.
     fTotalByteLimit = 0;
     fDiscardableFactory = nullptr;
+    fDiskCache = nullptr;
+
+    fShards = nullptr;
+    fNextGeneration = 1;
 }
 
 SkResourceCache::SkResourceCache(DiscardableFactory factory) {
@@ -129,6 +226,32 @@ bool SkResourceCache::find(const Key& key, FindVisitor visitor, void* context) {
     return false;
 }
 
+bool SkResourceCache::findShared(const Key& key, FindVisitor visitor, void* context,
+                                 uint64_t* staleGeneration) const {
+    *staleGeneration = 0;
+    if (auto found = fHash->find(key)) {
+        Rec* rec = *found;
+        if (visitor(*rec, context)) {
+            rec->fRecentlyUsed.store(true, std::memory_order_relaxed);  // for our LRU
+            return true;
+        }
+        *staleGeneration = rec->fGeneration;
+    }
+    return false;
+}
+
+void SkResourceCache::removeStale(const Key& key, uint64_t staleGeneration) {
+    this->checkMessages();
+
+    // Another thread may have removed (or even replaced) it since it was found.
+    if (auto found = fHash->find(key)) {
+        Rec* rec = *found;
+        if (rec->fGeneration == staleGeneration && rec->canBePurged()) {
+            this->remove(rec);
+        }
+    }
+}
+
 static void make_size_str(size_t size, SkString* str) {
     const char suffix[] = { 'b', 'k', 'm', 'g', 't', 0 };
     int i = 0;
@@ -185,6 +308,9 @@ void SkResourceCache::remove(Rec* rec) {
 
     fTotalBytesUsed -= used;
     fCount -= 1;
+    if (fShards) {
+        fShards->fTotalBytesUsed -= used;
+    }
 
     //SkDebugf("-RC count [%3d] bytes %d\n", fCount, fTotalBytesUsed);
 
@@ -210,15 +336,26 @@ void SkResourceCache::purgeAsNeeded(bool forcePurge) {
         countLimit = SK_MaxS32; // no limit based on count
         byteLimit = fTotalByteLimit;
     }
+    if (fShards) {
+        countLimit = std::max(1, countLimit / Shards::kCount);
+    }
+    auto overBudget = [&]() {
+        return fTotalBytesUsed >= byteLimit &&
+               (!fShards || fShards->fTotalBytesUsed >= fShards->fTotalByteLimit);
+    };
 
     Rec* rec = fTail;
     while (rec) {
-        if (!forcePurge && fTotalBytesUsed < byteLimit && fCount < countLimit) {
+        if (!forcePurge && !overBudget() && fCount < countLimit) {
             break;
         }
 
         Rec* prev = rec->fPrev;
-        if (rec->canBePurged()) {
+        if (!forcePurge && rec->fRecentlyUsed.exchange(false, std::memory_order_relaxed)) {
+            // Added or hit by findShared() since we last got here: move it now, and come back
+            // to it (from the head end) only if there's nothing older left to purge.
+            this->moveToHead(rec);
+        } else if (rec->canBePurged()) {
             this->remove(rec);
         }
         rec = prev;
@@ -290,17 +427,21 @@ size_t SkResourceCache::setTotalByteLimit(size_t newLimit) {
     return prevLimit;
 }
 
-SkCachedData* SkResourceCache::newCachedData(size_t bytes) {
-    this->checkMessages();
-
-    if (fDiscardableFactory) {
-        SkDiscardableMemory* dm = fDiscardableFactory(bytes);
+static SkCachedData* new_cached_data(SkResourceCache::DiscardableFactory factory, size_t bytes) {
+    if (factory) {
+        SkDiscardableMemory* dm = factory(bytes);
         return dm ? new SkCachedData(bytes, dm) : nullptr;
     } else {
         return new SkCachedData(sk_malloc_throw(bytes), bytes);
     }
 }
 
+SkCachedData* SkResourceCache::newCachedData(size_t bytes) {
+    this->checkMessages();
+
+    return new_cached_data(fDiscardableFactory, bytes);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 void SkResourceCache::release(Rec* rec) {
@@ -356,6 +497,13 @@ void SkResourceCache::addToHead(Rec* rec) {
     }
     fTotalBytesUsed += rec->bytesUsed();
     fCount += 1;
+    rec->fGeneration = fNextGeneration++;
+    if (fShards) {
+        fShards->fTotalBytesUsed += rec->bytesUsed();
+        // Hits don't reorder a shard's LRU, so an older rec hit since may be moved back in front
+        // of this one (see purgeAsNeeded()). Start it off recently used too.
+        rec->fRecentlyUsed.store(true, std::memory_order_relaxed);
+    }
 
     this->validate();
 }
@@ -450,89 +598,67 @@ void SkResourceCache::checkMessages() {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-static SkResourceCache* gResourceCache = nullptr;
-static SkMutex& resource_cache_mutex() {
-    static SkMutex& mutex = *(new SkMutex);
-    return mutex;
-}
-
-/** Must hold resource_cache_mutex() when calling. */
-static SkResourceCache* get_cache() {
-    // resource_cache_mutex() is always held when this is called, so we don't need to be fancy in here.
-    resource_cache_mutex().assertHeld();
-    if (nullptr == gResourceCache) {
-#ifdef SK_USE_DISCARDABLE_SCALEDIMAGECACHE
-        gResourceCache = new SkResourceCache(SkDiscardableMemory::Create);
-#else
-        gResourceCache = new SkResourceCache(SK_DEFAULT_IMAGE_CACHE_LIMIT);
-#endif
-    }
-    return gResourceCache;
+SkResourceCache::Shards& SkResourceCache::GlobalShards() {
+    static Shards& shards = *(new Shards);
+    return shards;
 }
 
 size_t SkResourceCache::GetTotalBytesUsed() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->getTotalBytesUsed();
+    return GlobalShards().getTotalBytesUsed();
 }
 
 size_t SkResourceCache::GetTotalByteLimit() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->getTotalByteLimit();
+    return GlobalShards().getTotalByteLimit();
 }
 
 size_t SkResourceCache::SetTotalByteLimit(size_t newLimit) {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->setTotalByteLimit(newLimit);
+    return GlobalShards().setTotalByteLimit(newLimit);
 }
 
 SkResourceCache::DiscardableFactory SkResourceCache::GetDiscardableFactory() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->discardableFactory();
+    return GlobalShards().discardableFactory();
 }
 
 SkCachedData* SkResourceCache::NewCachedData(size_t bytes) {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->newCachedData(bytes);
+    return new_cached_data(GetDiscardableFactory(), bytes);
 }
 
 void SkResourceCache::Dump() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    get_cache()->dump();
+    GlobalShards().dump();
 }
 
 size_t SkResourceCache::SetSingleAllocationByteLimit(size_t size) {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->setSingleAllocationByteLimit(size);
+    return GlobalShards().fSingleAllocationByteLimit.exchange(size);
 }
 
 size_t SkResourceCache::GetSingleAllocationByteLimit() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->getSingleAllocationByteLimit();
+    return GlobalShards().fSingleAllocationByteLimit;
 }
 
 size_t SkResourceCache::GetEffectiveSingleAllocationByteLimit() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->getEffectiveSingleAllocationByteLimit();
+    // Like getEffectiveSingleAllocationByteLimit(), against the budget of all the shards.
+    size_t limit = GetSingleAllocationByteLimit();
+    if (nullptr == GetDiscardableFactory()) {
+        const size_t totalLimit = GetTotalByteLimit();
+        limit = 0 == limit ? totalLimit : std::min(limit, totalLimit);
+    }
+    return limit;
 }
 
 void SkResourceCache::PurgeAll() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->purgeAll();
+    GlobalShards().purgeAll();
 }
 
 bool SkResourceCache::Find(const Key& key, FindVisitor visitor, void* context) {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->find(key, visitor, context);
+    return GlobalShards().find(key, visitor, context);
 }
 
 void SkResourceCache::Add(Rec* rec, void* payload) {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    get_cache()->add(rec, payload);
+    GlobalShards().add(rec, payload);
 }
 
 void SkResourceCache::VisitAll(Visitor visitor, void* context) {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    get_cache()->visitAll(visitor, context);
+    GlobalShards().visitAll(visitor, context);
 }
 
 void SkResourceCache::PostPurgeSharedID(uint64_t sharedID) {
@@ -541,6 +667,16 @@ void SkResourceCache::PostPurgeSharedID(uint64_t sharedID) {
     }
 }
 
+static std::atomic<SkResourceDiskCache*> gDiskCache{nullptr};
+
+void SkResourceCache::SetDiskCache(SkResourceDiskCache* diskCache) {
+    gDiskCache.store(diskCache, std::memory_order_release);
+}
+
+SkResourceDiskCache* SkResourceCache::GetDiskCache() {
+    return gDiskCache.load(std::memory_order_acquire);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "include/core/SkGraphics.h"
@@ -10,10 +10,16 @@
 
 #include "include/core/SkBitmap.h"
 #include "include/private/SkTDArray.h"
+#include "include/private/SkTo.h"
 #include "src/core/SkMessageBus.h"
+#include "src/core/SkSharedMutex.h"
+
+#include <atomic>
+#include <memory>
 
 class SkCachedData;
 class SkDiscardableMemory;
+class SkResourceDiskCache;
 class SkTraceMemoryDump;
 
 /**
@@ -106,6 +112,11 @@ public:
         Rec*    fNext;
         Rec*    fPrev;
 
+        // Set by hits that couldn't move the rec to the head of the LRU (see findShared()).
+        std::atomic<bool> fRecentlyUsed{false};
+        // Tells this rec apart from any later one at the same address (see removeStale()).
+        uint64_t          fGeneration = 0;
+
         friend class SkResourceCache;
     };
 
@@ -137,7 +148,8 @@ public:
 
     /*
      *  The following static methods are thread-safe wrappers around a global
-     *  instance of this cache.
+     *  instance of this cache. It is sharded by key, and Find() only takes its
+     *  shard's lock shared, so FindVisitors may run concurrently with each other.
      */
 
     /**
@@ -182,6 +194,14 @@ public:
 
     static void PostPurgeSharedID(uint64_t sharedID);
 
+    /**
+     *  Installs a persistent second-level cache consulted by SkBitmapCache and SkMipmapCache on
+     *  a miss, for images with a content hash. The caller keeps ownership, and must uninstall it
+     *  (by passing nullptr) before deleting it. Pass nullptr to stop using a disk cache.
+     */
+    static void SetDiskCache(SkResourceDiskCache*);
+    static SkResourceDiskCache* GetDiskCache();
+
     /**
      *  Call SkDebugf() with diagnostic information about the state of the cache
      */
@@ -249,6 +269,12 @@ public:
 
     DiscardableFactory discardableFactory() const { return fDiscardableFactory; }
 
+    /**
+     *  Like SetDiskCache(), for SkMipmapCache calls made with this (local) cache.
+     */
+    void setDiskCache(SkResourceDiskCache* diskCache) { fDiskCache = diskCache; }
+    SkResourceDiskCache* diskCache() const { return fDiskCache; }
+
     SkCachedData* newCachedData(size_t bytes);
 
     /**
@@ -256,6 +282,12 @@ public:
      */
     void dump() const;
 
+    /**
+     *  The global cache's implementation: several SkResourceCaches splitting the budget. The
+     *  static methods above use the global instance; tests may make their own.
+     */
+    class Shards;
+
 private:
     Rec*    fHead;
     Rec*    fTail;
@@ -264,6 +296,7 @@ private:
     Hash*   fHash;
 
     DiscardableFactory  fDiscardableFactory;
+    SkResourceDiskCache* fDiskCache;
 
     size_t  fTotalBytesUsed;
     size_t  fTotalByteLimit;
@@ -272,6 +305,22 @@ private:
 
     SkMessageBus<PurgeSharedIDMessage>::Inbox fPurgeSharedIDInbox;
 
+    // The global cache is split into shards, each its own SkResourceCache. Null otherwise.
+    Shards*  fShards;
+    static Shards& GlobalShards();
+
+    // Stamped on each added rec (see Rec::fGeneration).
+    uint64_t fNextGeneration;
+
+    // Like find(), but safe to call concurrently with other findShared() calls: a hit marks the
+    // rec recently used rather than moving it in the LRU, and the generation of a rec the visitor
+    // rejects is returned in *staleGeneration (0 if none) for removeStale() to remove it, rather
+    // than removing it here.
+    bool findShared(const Key&, FindVisitor, void* context, uint64_t* staleGeneration) const;
+    // Removes the rec found stale, unless it has been removed or replaced since. It's matched by
+    // generation, as its address may have been reused by a new rec.
+    void removeStale(const Key&, uint64_t staleGeneration);
+
     void checkMessages();
     void purgeAsNeeded(bool forcePurge = false);
 
@@ -289,4 +338,62 @@ private:
     void validate() const {}
 #endif
 };
+
+// The shards are picked by key hash, and each has its own lock, LRU and slice of the budget, so
+// that threads working with different keys don't contend. Lookups only take their shard's lock
+// shared. A shard may grow past its slice while the shards together are within the budget; once
+// they are over it, every shard over its slice purges down to it.
+class SkResourceCache::Shards {
+public:
+    static constexpr int kCountLog2 = 3;
+    static constexpr int kCount = 1 << kCountLog2;
+
+    // The global cache's configuration (see SK_DEFAULT_IMAGE_CACHE_LIMIT).
+    Shards();
+    // Malloc-backed shards, splitting byteLimit.
+    explicit Shards(size_t byteLimit);
+
+    // Which shard holds key.
+    static int IndexFor(const Key& key) {
+        // SkTHashTable indexes with the low bits, so use the high ones here.
+        return key.hash() >> (32 - kCountLog2);
+    }
+
+    bool find(const Key&, FindVisitor, void* context);
+    void add(Rec*, void* payload);
+    void visitAll(Visitor, void* context);
+    void purgeAll();
+    void dump();
+
+    size_t getTotalBytesUsed() const { return fTotalBytesUsed; }
+    size_t getTotalByteLimit() const { return fTotalByteLimit; }
+    size_t setTotalByteLimit(size_t newLimit);
+
+    DiscardableFactory discardableFactory() const {
+        // The same for every shard, and never changes.
+        return fShards[0].fCache->discardableFactory();
+    }
+
+private:
+    struct Shard {
+        SkSharedMutex                    fMutex;
+        std::unique_ptr<SkResourceCache> fCache;
+    };
+
+    // Shard i's part of limit. The slices add up to limit.
+    static size_t SliceOf(size_t limit, int i) {
+        return limit / kCount + (SkToSizeT(i) < limit % kCount ? 1 : 0);
+    }
+
+    // If the shards together are over the budget, purges the shards that are over their slice.
+    void purgeIfOverBudget();
+
+    std::atomic<size_t> fTotalBytesUsed{0};
+    std::atomic<size_t> fTotalByteLimit{0};
+    std::atomic<size_t> fSingleAllocationByteLimit{0};
+    Shard               fShards[kCount];
+
+    friend class SkResourceCache;
+};
+
 #endif
@@ -0,0 +1,402 @@
+/*
+ * Copyright 2021 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkResourceDiskCache.h"
+
+#include "include/core/SkExecutor.h"
+#include "include/private/SkTDArray.h"
+#include "include/private/SkTo.h"
+#include "src/core/SkOSFile.h"
+#include "src/core/SkOpts.h"
+#include "src/utils/SkOSPath.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+// Every entry file is a Header, the key, the meta, padding up to kContentsAlign, then the
+// contents. The contents are aligned so that mapped pixels are safe to read directly.
+namespace {
+
+constexpr uint32_t kMagic   = SkSetFourByteTag('s', 'k', 'r', 'c');
+constexpr uint32_t kVersion = 1;
+constexpr size_t   kContentsAlign = 16;
+
+constexpr char kEntrySuffix[] = ".skrc";
+constexpr char kTempSuffix[]  = ".tmp";
+constexpr char kIndexName[]   = "index.skri";
+
+// Temporary files older than this were left behind by a process that died mid-write.
+constexpr double kStaleTempSeconds = 60 * 60;
+
+struct Header {
+    uint32_t fMagic;
+    uint32_t fVersion;
+    uint32_t fKeySize;
+    uint32_t fMetaSize;
+    uint64_t fContentsSize;
+};
+static_assert(sizeof(Header) == 24, "");
+
+size_t contents_offset(size_t keySize, size_t metaSize) {
+    return (sizeof(Header) + keySize + metaSize + kContentsAlign - 1) & ~(kContentsAlign - 1);
+}
+
+uint64_t digest_of(const SkData& key) {
+    return SkResourceDiskCache::HashContents(key.data(), key.size());
+}
+
+// Returns a unique path to write path's contents to before renaming them into place. Several
+// processes may share the directory, so names are unique to this process, too.
+SkString temp_path_for(const SkString& path) {
+    static const uint64_t gProcessToken = [] {
+        const struct {
+            const void* fStatic;
+            time_t      fTime;
+            clock_t     fClock;
+        } seed = { &kMagic, time(nullptr), clock() };
+        return SkResourceDiskCache::HashContents(&seed, sizeof(seed));
+    }();
+    static std::atomic<uint32_t> gNextTemp{0};
+
+    SkString temp = path;
+    temp.appendf(".%016llx.%u%s", (unsigned long long)gProcessToken, gNextTemp++, kTempSuffix);
+    return temp;
+}
+
+bool parse_digest(const SkString& name, uint64_t* digest) {
+    const size_t kDigits = 16;
+    if (name.size() != kDigits + strlen(kEntrySuffix) || !name.endsWith(kEntrySuffix)) {
+        return false;
+    }
+    char* end;
+    *digest = strtoull(name.c_str(), &end, 16);
+    return end == name.c_str() + kDigits;
+}
+
+}  // namespace
+
+struct SkResourceDiskCache::Entry {
+    uint64_t fDigest;
+    size_t   fBytes;    // the size of the entry's file
+
+    // Set until the entry's file has been written.
+    sk_sp<SkData> fPendingKey, fPendingMeta, fPendingContents;
+
+    SK_DECLARE_INTERNAL_LLIST_INTERFACE(Entry);
+};
+
+uint64_t SkResourceDiskCache::HashContents(const void* data, size_t size, uint64_t seed) {
+    uint64_t lo = SkOpts::hash(data, size, (uint32_t)seed),
+             hi = SkOpts::hash(data, size, (uint32_t)(seed >> 32) ^ 0x9e3779b9);
+    uint64_t hash = hi << 32 | lo;
+    return hash ? hash : 1;
+}
+
+std::unique_ptr<SkResourceDiskCache> SkResourceDiskCache::Make(const char dir[],
+                                                               size_t byteLimit,
+                                                               SkExecutor* writeExecutor) {
+    if (!dir || !*dir) {
+        return nullptr;
+    }
+    if (!sk_isdir(dir) && !sk_mkdir(dir)) {
+        return nullptr;
+    }
+
+    std::unique_ptr<SkExecutor> owned;
+    if (!writeExecutor) {
+        // One writer keeps the disk traffic sequential and in order.
+        owned = SkExecutor::MakeFIFOThreadPool(1, false);
+        writeExecutor = owned.get();
+    }
+    std::unique_ptr<SkResourceDiskCache> cache(
+            new SkResourceDiskCache(SkString(dir), byteLimit, writeExecutor, std::move(owned)));
+    cache->loadIndex();
+    return cache;
+}
+
+SkResourceDiskCache::SkResourceDiskCache(SkString dir, size_t byteLimit, SkExecutor* executor,
+                                         std::unique_ptr<SkExecutor> ownedExecutor)
+        : fDir(std::move(dir))
+        , fTotalByteLimit(byteLimit)
+        , fOwnedExecutor(std::move(ownedExecutor))
+        , fWrites(*executor) {}
+
+SkResourceDiskCache::~SkResourceDiskCache() {
+    this->flush();
+
+    SkAutoMutexExclusive lock(fMutex);
+    while (Entry* entry = fLRU.head()) {
+        fLRU.remove(entry);
+        delete entry;
+    }
+    fIndex.reset();
+}
+
+SkString SkResourceDiskCache::entryPath(uint64_t digest) const {
+    SkString name = SkStringPrintf("%016llx%s", (unsigned long long)digest, kEntrySuffix);
+    return SkOSPath::Join(fDir.c_str(), name.c_str());
+}
+
+void SkResourceDiskCache::loadIndex() {
+    // Clear out partial writes from processes that didn't finish them. Recent ones may still
+    // be in progress in another process sharing the directory.
+    SkString name;
+    SkOSFile::Iter temps(fDir.c_str(), kTempSuffix);
+    while (temps.next(&name)) {
+        const SkString path = SkOSPath::Join(fDir.c_str(), name.c_str());
+        double age;
+        if (sk_file_age(path.c_str(), &age) && age > kStaleTempSeconds) {
+            remove(path.c_str());
+        }
+    }
+
+    SkAutoMutexExclusive lock(fMutex);
+
+    SkOSFile::Iter files(fDir.c_str(), kEntrySuffix);
+    while (files.next(&name)) {
+        uint64_t digest;
+        if (!parse_digest(name, &digest) || fIndex.find(digest)) {
+            continue;
+        }
+        FILE* file = sk_fopen(SkOSPath::Join(fDir.c_str(), name.c_str()).c_str(),
+                              kRead_SkFILE_Flag);
+        if (!file) {
+            continue;
+        }
+        size_t bytes = sk_fgetsize(file);
+        sk_fclose(file);
+
+        // Entries missing from the saved order were written last, so they start out most recent.
+        Entry* entry = new Entry{digest, bytes, nullptr, nullptr, nullptr};
+        fIndex.set(digest, entry);
+        fLRU.addToHead(entry);
+        fTotalBytes += bytes;
+    }
+
+    // The saved order lists digests from most to least recently used.
+    if (sk_sp<SkData> order = SkData::MakeFromFileName(
+                SkOSPath::Join(fDir.c_str(), kIndexName).c_str())) {
+        const size_t count = order->size() / sizeof(uint64_t);
+        const uint64_t* digests = (const uint64_t*)order->data();
+        SkTInternalLList<Entry> saved;
+        SkTHashSet<uint64_t> seen;
+        for (size_t i = 0; i < count; ++i) {
+            Entry** entry = fIndex.find(digests[i]);
+            if (entry && !seen.contains(digests[i])) {
+                seen.add(digests[i]);
+                fLRU.remove(*entry);
+                saved.addToTail(*entry);
+            }
+        }
+        while (Entry* entry = saved.head()) {
+            saved.remove(entry);
+            fLRU.addToTail(entry);
+        }
+    }
+
+    this->evictAsNeeded();
+}
+
+void SkResourceDiskCache::saveIndex() {
+    SkTDArray<uint64_t> digests;
+    {
+        SkAutoMutexExclusive lock(fMutex);
+        for (Entry* entry = fLRU.head(); entry; entry = entry->fNext) {
+            *digests.append() = entry->fDigest;
+        }
+    }
+
+    const SkString path = SkOSPath::Join(fDir.c_str(), kIndexName),
+                   temp = temp_path_for(path);
+    if (FILE* file = sk_fopen(temp.c_str(), kWrite_SkFILE_Flag)) {
+        bool ok = digests.isEmpty() ||
+                  sk_fwrite(digests.begin(), digests.bytes(), file) == digests.bytes();
+        sk_fclose(file);
+        remove(path.c_str());
+        if (!ok || rename(temp.c_str(), path.c_str()) != 0) {
+            remove(temp.c_str());
+        }
+    }
+}
+
+void SkResourceDiskCache::evictAsNeeded() {
+    fMutex.assertHeld();
+
+    Entry* entry = fLRU.tail();
+    while (fTotalBytes > fTotalByteLimit && entry) {
+        Entry* prev = entry->fPrev;
+        // Entries still waiting to be written are skipped; their write will evict again.
+        if (!entry->fPendingContents) {
+            remove(this->entryPath(entry->fDigest).c_str());
+            fTotalBytes -= entry->fBytes;
+            fIndex.remove(entry->fDigest);
+            fLRU.remove(entry);
+            delete entry;
+        }
+        entry = prev;
+    }
+}
+
+bool SkResourceDiskCache::find(const SkData& key, sk_sp<SkData>* meta, sk_sp<SkData>* contents) {
+    const uint64_t digest = digest_of(key);
+    {
+        SkAutoMutexExclusive lock(fMutex);
+        Entry** found = fIndex.find(digest);
+        if (!found) {
+            return false;
+        }
+        Entry* entry = *found;
+        fLRU.remove(entry);
+        fLRU.addToHead(entry);
+
+        if (entry->fPendingContents) {
+            if (!entry->fPendingKey->equals(&key)) {
+                return false;
+            }
+            *meta     = entry->fPendingMeta;
+            *contents = entry->fPendingContents;
+            return true;
+        }
+    }
+
+    // Map the file without holding the lock. If it's evicted meanwhile, this either fails or
+    // keeps the unlinked file mapped, both of which are fine.
+    sk_sp<SkData> file = SkData::MakeFromFileName(this->entryPath(digest).c_str());
+    if (!file || file->size() < sizeof(Header)) {
+        return false;
+    }
+    Header header;
+    memcpy(&header, file->data(), sizeof(Header));
+    const size_t offset = contents_offset(header.fKeySize, header.fMetaSize);
+    if (header.fMagic != kMagic || header.fVersion != kVersion ||
+        header.fKeySize != key.size() ||
+        offset > file->size() || header.fContentsSize != file->size() - offset ||
+        memcmp(file->bytes() + sizeof(Header), key.data(), key.size()) != 0) {
+        return false;
+    }
+
+    *meta     = SkData::MakeSubset(file.get(), sizeof(Header) + header.fKeySize,
+                                   header.fMetaSize);
+    *contents = SkData::MakeSubset(file.get(), offset, header.fContentsSize);
+    return *meta && *contents;
+}
+
+void SkResourceDiskCache::add(const SkData& key, sk_sp<SkData> meta, sk_sp<SkData> contents) {
+    SkASSERT(meta && contents);
+    const uint64_t digest = digest_of(key);
+    sk_sp<SkData> keyCopy = SkData::MakeWithCopy(key.data(), key.size());
+
+    {
+        SkAutoMutexExclusive lock(fMutex);
+        if (Entry** found = fIndex.find(digest)) {
+            fLRU.remove(*found);
+            fLRU.addToHead(*found);
+            return;
+        }
+
+        const size_t bytes = contents_offset(key.size(), meta->size()) + contents->size();
+        Entry* entry = new Entry{digest, bytes, keyCopy, meta, contents};
+        fIndex.set(digest, entry);
+        fLRU.addToHead(entry);
+        fTotalBytes += bytes;
+        this->evictAsNeeded();
+    }
+
+    fWrites.add([this, digest, keyCopy = std::move(keyCopy), meta = std::move(meta),
+                 contents = std::move(contents)]() mutable {
+        this->writeEntry(digest, std::move(keyCopy), std::move(meta), std::move(contents));
+    });
+}
+
+void SkResourceDiskCache::writeEntry(uint64_t digest, sk_sp<SkData> key, sk_sp<SkData> meta,
+                                     sk_sp<SkData> contents) {
+    // Write to a temporary file and rename it into place, so that readers (including other
+    // processes) only ever map complete entries.
+    const SkString path = this->entryPath(digest),
+                   temp = temp_path_for(path);
+
+    bool ok = false;
+    if (FILE* file = sk_fopen(temp.c_str(), kWrite_SkFILE_Flag)) {
+        const Header header = { kMagic, kVersion, SkToU32(key->size()), SkToU32(meta->size()),
+                                contents->size() };
+        const size_t offset = contents_offset(key->size(), meta->size());
+        const size_t padding = offset - (sizeof(Header) + key->size() + meta->size());
+        static const char kZeros[kContentsAlign] = {};
+
+        ok = sk_fwrite(&header, sizeof(header), file) == sizeof(header)
+          && sk_fwrite(key->data(),  key->size(),  file) == key->size()
+          && sk_fwrite(meta->data(), meta->size(), file) == meta->size()
+          && sk_fwrite(kZeros, padding, file) == padding
+          && sk_fwrite(contents->data(), contents->size(), file) == contents->size();
+        sk_fclose(file);
+
+        if (ok && rename(temp.c_str(), path.c_str()) != 0) {
+            // Some platforms won't rename over an existing file.
+            remove(path.c_str());
+            ok = rename(temp.c_str(), path.c_str()) == 0;
+        }
+        if (!ok) {
+            remove(temp.c_str());
+        }
+    }
+
+    SkAutoMutexExclusive lock(fMutex);
+    if (Entry** found = fIndex.find(digest)) {
+        Entry* entry = *found;
+        if (ok) {
+            entry->fPendingKey.reset();
+            entry->fPendingMeta.reset();
+            entry->fPendingContents.reset();
+        } else {
+            fTotalBytes -= entry->fBytes;
+            fIndex.remove(digest);
+            fLRU.remove(entry);
+            delete entry;
+        }
+    } else if (ok) {
+        // The entry was purged while its write was queued or running. Don't leave its file
+        // behind, unindexed and outside the byte budget.
+        remove(path.c_str());
+    }
+    this->evictAsNeeded();
+}
+
+void SkResourceDiskCache::flush() {
+    fWrites.wait();
+    this->saveIndex();
+}
+
+void SkResourceDiskCache::purgeAll() {
+    // Entries added after this wait may still be pending below; their writes delete their
+    // files again once they find the entry gone.
+    fWrites.wait();
+
+    {
+        SkAutoMutexExclusive lock(fMutex);
+        while (Entry* entry = fLRU.head()) {
+            remove(this->entryPath(entry->fDigest).c_str());
+            fLRU.remove(entry);
+            delete entry;
+        }
+        fIndex.reset();
+        fTotalBytes = 0;
+    }
+    this->saveIndex();
+}
+
+size_t SkResourceDiskCache::getTotalBytesUsed() const {
+    SkAutoMutexExclusive lock(fMutex);
+    return fTotalBytes;
+}
+
+int SkResourceDiskCache::count() const {
+    SkAutoMutexExclusive lock(fMutex);
+    return fIndex.count();
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright 2021 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkResourceDiskCache_DEFINED
+#define SkResourceDiskCache_DEFINED
+
+#include "include/core/SkData.h"
+#include "include/core/SkString.h"
+#include "include/private/SkMutex.h"
+#include "include/private/SkTHash.h"
+#include "src/core/SkTInternalLList.h"
+#include "src/core/SkTaskGroup.h"
+
+#include <memory>
+
+class SkExecutor;
+
+/**
+ *  A second-level, persistent tier for SkResourceCache, backed by one file per entry in a
+ *  directory. Entries survive the process, so a restarted process can refetch pixels it has
+ *  already decoded instead of decoding them again.
+ *
+ *  Keys must mean the same thing in every process: build them from a stable tag and a hash of
+ *  the source content (see HashContents()), never from pointers or unique IDs. Each entry holds
+ *  a small meta blob describing its contents (e.g. an SkImageInfo) and the contents themselves.
+ *
+ *  Writes are queued and happen later on an executor, so add() never waits on the disk. find()
+ *  memory-maps the entry's file. When the files exceed the byte limit, the least recently used
+ *  entries are deleted. The recency order is saved by flush() and the destructor.
+ *
+ *  This class is thread-safe. Install one with SkResourceCache::SetDiskCache() to have
+ *  SkBitmapCache and SkMipmapCache use it for images that have a content hash.
+ */
+class SkResourceDiskCache {
+public:
+    /**
+     *  Opens the cache in dir, creating the directory if needed and picking up entries written
+     *  by earlier processes. Writes run on writeExecutor, or on a private thread if it's null.
+     *  Returns nullptr if dir can't be used.
+     */
+    static std::unique_ptr<SkResourceDiskCache> Make(const char dir[], size_t byteLimit,
+                                                     SkExecutor* writeExecutor = nullptr);
+
+    ~SkResourceDiskCache();
+
+    /**
+     *  Returns true and sets meta and contents if key is in the cache, marking it most recently
+     *  used. Both point into the memory-mapped file (or the pending write).
+     */
+    bool find(const SkData& key, sk_sp<SkData>* meta, sk_sp<SkData>* contents);
+
+    /**
+     *  Queues meta and contents to be written under key. They're held (not copied) until the
+     *  write is done, and find() sees them right away. Content-keyed entries never change, so
+     *  adding a key that's already present only marks it most recently used.
+     */
+    void add(const SkData& key, sk_sp<SkData> meta, sk_sp<SkData> contents);
+
+    /** Waits for queued writes to finish and saves the recency order. */
+    void flush();
+
+    /** Deletes every entry. */
+    void purgeAll();
+
+    size_t getTotalBytesUsed() const;
+    size_t getTotalByteLimit() const { return fTotalByteLimit; }
+    int count() const;
+
+    /** A 64-bit hash of data, suitable for content keys. Never returns 0. */
+    static uint64_t HashContents(const void* data, size_t size, uint64_t seed = 0);
+
+private:
+    struct Entry;
+
+    SkResourceDiskCache(SkString dir, size_t byteLimit, SkExecutor*,
+                        std::unique_ptr<SkExecutor> ownedExecutor);
+
+    SkString entryPath(uint64_t digest) const;
+    void loadIndex();
+    void saveIndex();
+    // Removes entries (and their files) until the index fits. Files are deleted under the
+    // lock, so that they can't race with re-adding the same entry.
+    void evictAsNeeded();
+    void writeEntry(uint64_t digest, sk_sp<SkData> key, sk_sp<SkData> meta,
+                    sk_sp<SkData> contents);
+
+    const SkString fDir;
+    const size_t   fTotalByteLimit;
+
+    mutable SkMutex                fMutex;
+    SkTHashMap<uint64_t, Entry*>   fIndex        SK_GUARDED_BY(fMutex);
+    SkTInternalLList<Entry>        fLRU          SK_GUARDED_BY(fMutex);   // head is most recent
+    size_t                         fTotalBytes   SK_GUARDED_BY(fMutex) = 0;
+
+    std::unique_ptr<SkExecutor> fOwnedExecutor;
+    SkTaskGroup                 fWrites;
+};
+
+#endif
@@ -15,10 +15,10 @@
 #include "src/core/SkColorFilterBase.h"
 #include "src/core/SkColorSpacePriv.h"
 #include "src/core/SkColorSpaceXformSteps.h"
-#include "src/core/SkLRUCache.h"
 #include "src/core/SkMatrixProvider.h"
 #include "src/core/SkOpts.h"
 #include "src/core/SkRasterPipeline.h"
+#include "src/core/SkRuntimeEffectCache.h"
 #include "src/core/SkReadBuffer.h"
 #include "src/core/SkUtils.h"
 #include "src/core/SkVM.h"
@@ -42,27 +42,46 @@
 #endif
 
 #include <algorithm>
+#include <limits>
 
 namespace SkSL {
+// Hands out a compiler for the duration of one compile. Compilers are pooled (and never freed,
+// since compiled Programs keep referring to their compiler's Context), so threads creating effects
+// concurrently no longer wait on each other. With shared built-in modules, each additional
+// compiler is cheap.
 class SharedCompiler {
 public:
-    SharedCompiler() : fLock(compiler_mutex()) {
-        if (!gImpl) {
-            gImpl = new Impl();
+    SharedCompiler() {
+        Impl& impl = Impl::Get();
+        {
+            SkAutoMutexExclusive lock(impl.fMutex);
+            if (!impl.fFreeCompilers.empty()) {
+                fCompiler = impl.fFreeCompilers.back();
+                impl.fFreeCompilers.pop_back();
+            }
+        }
+        if (!fCompiler) {
+            fCompiler = new SkSL::Compiler(impl.fCaps.get());
         }
     }
 
-    SkSL::Compiler* operator->() const { return gImpl->fCompiler; }
+    ~SharedCompiler() {
+        Impl& impl = Impl::Get();
+        SkAutoMutexExclusive lock(impl.fMutex);
+        impl.fFreeCompilers.push_back(fCompiler);
+    }
 
-private:
-    SkAutoMutexExclusive fLock;
+    SkSL::Compiler* operator->() const { return fCompiler; }
 
-    static SkMutex& compiler_mutex() {
-        static SkMutex& mutex = *(new SkMutex);
-        return mutex;
-    }
+private:
+    SkSL::Compiler* fCompiler = nullptr;
 
     struct Impl {
+        static Impl& Get() {
+            static Impl* gImpl = new Impl();
+            return *gImpl;
+        }
+
         Impl() {
             // These caps are configured to apply *no* workarounds. This avoids changes that are
             // unnecessary (GLSL intrinsic rewrites), or possibly incorrect (adding do-while loops).
@@ -75,19 +94,14 @@ private:
             fCaps->fBuiltinDeterminantSupport = true;
             // Don't inline if it would require a do loop, some devices don't support them.
             fCaps->fCanUseDoLoops = false;
-
-            fCompiler = new SkSL::Compiler(fCaps.get());
         }
 
-        SkSL::ShaderCapsPointer fCaps;
-        SkSL::Compiler*         fCompiler;
+        SkSL::ShaderCapsPointer      fCaps;
+        SkMutex                      fMutex;
+        std::vector<SkSL::Compiler*> fFreeCompilers SK_GUARDED_BY(fMutex);
     };
-
-    static Impl* gImpl;
 };
 
-SharedCompiler::Impl* SharedCompiler::gImpl = nullptr;
-
 }  // namespace SkSL
 
 // Accepts a valid marker, or "normals(<marker>)"
@@ -127,39 +141,112 @@ static bool init_uniform_type(const SkSL::Context& ctx,
     return false;
 }
 
-SK_BEGIN_REQUIRE_DENSE;
-struct Key {
-    uint32_t skslHashA;
-    uint32_t skslHashB;
-    int      inlineThreshold;
-
-    bool operator==(const Key& that) const {
-        return this->skslHashA        == that.skslHashA
-            && this->skslHashB        == that.skslHashB
-            && this->inlineThreshold  == that.inlineThreshold;
-    }
-
-    Key(const SkString& sksl, const SkRuntimeEffect::Options& options)
+SkRuntimeEffectCache::Key::Key(const SkString& sksl, const SkRuntimeEffect::Options& options)
         : skslHashA(SkOpts::hash(sksl.c_str(), sksl.size(), 0))
         , skslHashB(SkOpts::hash(sksl.c_str(), sksl.size(), 1))
         , inlineThreshold(options.inlineThreshold) {}
-};
-SK_END_REQUIRE_DENSE;
 
+SkRuntimeEffectCache::Shard::Shard() : fLRU(std::numeric_limits<int>::max()) {}
+
+SkRuntimeEffectCache::SkRuntimeEffectCache(size_t byteLimit, int shardCount)
+        : fShardCount(shardCount)
+        , fShards(new Shard[shardCount])
+        , fByteLimit(byteLimit) {
+    SkASSERT(shardCount > 0);
+}
+
+SkRuntimeEffectCache& SkRuntimeEffectCache::Global() {
+    static SkRuntimeEffectCache* gCache = new SkRuntimeEffectCache;
+    return *gCache;
+}
+
+sk_sp<SkRuntimeEffect> SkRuntimeEffectCache::find(const Key& key) {
+    Shard& shard = this->shardFor(key);
+    SkAutoMutexExclusive lock(shard.fMutex);
+    Entry* entry = shard.fLRU.find(key);
+    return entry ? entry->fEffect : nullptr;
+}
+
+void SkRuntimeEffectCache::insert(const Key& key, sk_sp<SkRuntimeEffect> effect) {
+    size_t bytes = ApproximateSize(*effect);
+    Shard& shard = this->shardFor(key);
+    SkAutoMutexExclusive lock(shard.fMutex);
+    if (Entry* existing = shard.fLRU.find(key)) {
+        // Another thread made the same effect while we were compiling it.
+        shard.fBytes -= existing->fBytes;
+        *existing = {std::move(effect), bytes};
+    } else {
+        shard.fLRU.insert(key, {std::move(effect), bytes});
+    }
+    shard.fBytes += bytes;
+    PurgeShard(&shard, this->shardLimit());
+}
+
+size_t SkRuntimeEffectCache::setByteLimit(size_t newLimit) {
+    size_t prevLimit = fByteLimit.exchange(newLimit, std::memory_order_relaxed);
+    if (newLimit < prevLimit) {
+        this->purgeAll(newLimit / fShardCount);
+    }
+    return prevLimit;
+}
 
-static std::tuple<SkAutoMutexExclusive, SkLRUCache<Key, sk_sp<SkRuntimeEffect>>*> locked_cache() {
-    static auto* mutex = new SkMutex;
-    static auto* cache = new SkLRUCache<Key, sk_sp<SkRuntimeEffect>>(11/*totally arbitrary*/);
-    return { *mutex, cache };
+size_t SkRuntimeEffectCache::bytesUsed() {
+    size_t total = 0;
+    for (int i = 0; i < fShardCount; ++i) {
+        SkAutoMutexExclusive lock(fShards[i].fMutex);
+        total += fShards[i].fBytes;
+    }
+    return total;
+}
+
+int SkRuntimeEffectCache::count() {
+    int total = 0;
+    for (int i = 0; i < fShardCount; ++i) {
+        SkAutoMutexExclusive lock(fShards[i].fMutex);
+        total += fShards[i].fLRU.count();
+    }
+    return total;
+}
+
+void SkRuntimeEffectCache::purgeAll(size_t shardLimit) {
+    for (int i = 0; i < fShardCount; ++i) {
+        SkAutoMutexExclusive lock(fShards[i].fMutex);
+        PurgeShard(&fShards[i], shardLimit);
+    }
+}
+
+size_t SkRuntimeEffectCache::ApproximateSize(const SkRuntimeEffect& effect) {
+    static constexpr size_t kIRBytesPerSourceByte = 16;
+    return sizeof(SkRuntimeEffect) + effect.source().size() * (1 + kIRBytesPerSourceByte) +
+           effect.uniforms().count() * sizeof(SkRuntimeEffect::Uniform);
+}
+
+void SkRuntimeEffectCache::PurgeShard(Shard* shard, size_t shardLimit) {
+    while (shard->fBytes > shardLimit && shard->fLRU.count() > 0) {
+        shard->fBytes -= shard->fLRU.removeLeastRecentlyUsed().fBytes;
+    }
+}
+
+size_t SkRuntimeEffect::GetCacheByteLimit() {
+    return SkRuntimeEffectCache::Global().byteLimit();
+}
+
+size_t SkRuntimeEffect::SetCacheByteLimit(size_t newLimit) {
+    return SkRuntimeEffectCache::Global().setByteLimit(newLimit);
+}
+
+size_t SkRuntimeEffect::GetCacheBytesUsed() {
+    return SkRuntimeEffectCache::Global().bytesUsed();
+}
+
+void SkRuntimeEffect::PurgeCache() {
+    SkRuntimeEffectCache::Global().purgeAll();
 }
 
 SkRuntimeEffect::Result SkRuntimeEffect::Make(SkString sksl, const Options& options) {
-    Key key(sksl, options);
-    {
-        auto [locked, cache] = locked_cache();
-        if (sk_sp<SkRuntimeEffect>* found = cache->find(key)) {
-            return Result{*found, SkString()};
-        }
+    SkRuntimeEffectCache::Key key(sksl, options);
+    if (sk_sp<SkRuntimeEffect> found = SkRuntimeEffectCache::Global().find(key)) {
+        return Result{std::move(found), SkString()};
     }
 
     SkSL::SharedCompiler compiler;
@@ -282,10 +369,7 @@ SkRuntimeEffect::Result SkRuntimeEffect::Make(SkString sksl, const Options& opti
                                                       std::move(varyings),
                                                       usesSampleCoords,
                                                       allowColorFilter));
-    {
-        auto [locked, cache] = locked_cache();
-        cache->insert_or_update(key, effect);
-    }
+    SkRuntimeEffectCache::Global().insert(key, effect);
     return Result{std::move(effect), SkString()};
 }
 
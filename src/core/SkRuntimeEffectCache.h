@@ -0,0 +1,89 @@
+/*
+ * Copyright 2021 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkRuntimeEffectCache_DEFINED
+#define SkRuntimeEffectCache_DEFINED
+
+#include "include/effects/SkRuntimeEffect.h"
+#include "include/private/SkMutex.h"
+#include "src/core/SkLRUCache.h"
+
+#include <atomic>
+#include <memory>
+
+/**
+ *  The cache behind SkRuntimeEffect::Make(). Effects are cached by their source and options. The
+ *  cache is split into shards, each with its own lock and LRU list, so threads making different
+ *  effects rarely contend. It is budgeted by the approximate memory held by the cached effects
+ *  rather than by count; each shard gets an equal slice of the byte limit.
+ *
+ *  Make() uses Global(). Tests can make their own instances.
+ */
+class SkRuntimeEffectCache {
+public:
+    static constexpr size_t kDefaultByteLimit  = 8 * 1024 * 1024;
+    static constexpr int    kDefaultShardCount = 16;
+
+    SK_BEGIN_REQUIRE_DENSE;
+    struct Key {
+        uint32_t skslHashA;
+        uint32_t skslHashB;
+        int      inlineThreshold;
+
+        bool operator==(const Key& that) const {
+            return this->skslHashA        == that.skslHashA
+                && this->skslHashB        == that.skslHashB
+                && this->inlineThreshold  == that.inlineThreshold;
+        }
+
+        Key(const SkString& sksl, const SkRuntimeEffect::Options& options);
+    };
+    SK_END_REQUIRE_DENSE;
+
+    explicit SkRuntimeEffectCache(size_t byteLimit = kDefaultByteLimit,
+                                  int shardCount = kDefaultShardCount);
+
+    static SkRuntimeEffectCache& Global();
+
+    sk_sp<SkRuntimeEffect> find(const Key&);
+    void insert(const Key&, sk_sp<SkRuntimeEffect>);
+
+    size_t byteLimit() const { return fByteLimit.load(std::memory_order_relaxed); }
+    // Returns the previous limit, and purges down to a lower limit immediately.
+    size_t setByteLimit(size_t newLimit);
+    size_t bytesUsed();
+    int count();
+    void purgeAll() { this->purgeAll(0); }
+
+    // The program's IR lives in an SkSL pool we can't measure, but it grows with the source.
+    static size_t ApproximateSize(const SkRuntimeEffect&);
+
+private:
+    struct Entry {
+        sk_sp<SkRuntimeEffect> fEffect;
+        size_t                 fBytes;
+    };
+
+    struct Shard {
+        SkMutex                  fMutex;
+        SkLRUCache<Key, Entry>   fLRU SK_GUARDED_BY(fMutex);
+        size_t                   fBytes SK_GUARDED_BY(fMutex) = 0;
+
+        Shard();
+    };
+
+    Shard& shardFor(const Key& key) { return fShards[key.skslHashA % fShardCount]; }
+    size_t shardLimit() const { return this->byteLimit() / fShardCount; }
+    void purgeAll(size_t shardLimit);
+    static void PurgeShard(Shard* shard, size_t shardLimit) SK_REQUIRES(shard->fMutex);
+
+    const int                fShardCount;
+    std::unique_ptr<Shard[]> fShards;
+    std::atomic<size_t>      fByteLimit;
+};
+
+#endif
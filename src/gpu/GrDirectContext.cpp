@@ -17,6 +17,7 @@
 #include "src/gpu/GrDrawingManager.h"
 #include "src/gpu/GrGpu.h"
 #include "src/gpu/GrResourceProvider.h"
+#include "src/gpu/GrShaderPrecompiler.h"
 #include "src/gpu/GrShaderUtils.h"
 #include "src/image/SkImage_GpuBase.h"
 
@@ -112,6 +113,10 @@ void GrDirectContext::abandonContext() {
     // abandon first so destructors don't try to free the resources in the API.
     fResourceCache->abandonAll();
 
+    if (fShaderPrecompiler) {
+        fShaderPrecompiler->abandon();
+    }
+
     fGpu->disconnect(GrGpu::DisconnectType::kAbandon);
 
     // Must be after GrResourceCache::abandonAll().
@@ -155,6 +160,10 @@ void GrDirectContext::releaseResourcesAndAbandonContext() {
     // Must be after GrResourceCache::releaseAll().
     fMappedBufferManager.reset();
 
+    if (fShaderPrecompiler) {
+        fShaderPrecompiler->abandon();
+    }
+
     fGpu->disconnect(GrGpu::DisconnectType::kCleanup);
     if (fSmallPathAtlasMgr) {
         fSmallPathAtlasMgr->reset();
@@ -878,6 +887,33 @@ bool GrDirectContext::precompileShader(const SkData& key, const SkData& data) {
     return fGpu->precompileShader(key, data);
 }
 
+void GrDirectContext::precompileShaderAsync(sk_sp<SkData> key, sk_sp<SkData> data) {
+    ASSERT_SINGLE_OWNER
+    if (this->abandoned() || !key || !data) {
+        return;
+    }
+    if (!fShaderPrecompiler) {
+        fShaderPrecompiler = std::make_unique<GrShaderPrecompiler>(fGpu.get(), fTaskGroup.get());
+    }
+    fShaderPrecompiler->add(std::move(key), std::move(data));
+}
+
+int GrDirectContext::finishPrecompiledShaders(bool waitForAll) {
+    ASSERT_SINGLE_OWNER
+    if (!fShaderPrecompiler) {
+        return 0;
+    }
+    if (this->abandoned()) {
+        fShaderPrecompiler->abandon();
+        return 0;
+    }
+    return fShaderPrecompiler->finish(waitForAll);
+}
+
+GrDirectContext::PrecompileStats GrDirectContext::precompileStats() const {
+    return fShaderPrecompiler ? fShaderPrecompiler->stats() : PrecompileStats();
+}
+
 #ifdef SK_ENABLE_DUMP_GPU
 #include "include/core/SkString.h"
 #include "src/utils/SkJSONWriter.h"
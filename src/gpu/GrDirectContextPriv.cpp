@@ -117,6 +117,9 @@ void GrDirectContextPriv::dumpGpuStats(SkString* out) const {
     if (auto builder = fContext->fGpu->pipelineBuilder()) {
         builder->stats()->dump(out);
     }
+    if (auto atlasManager = fContext->onGetAtlasManager()) {
+        atlasManager->dumpStats(out);
+    }
 #endif
 }
 
@@ -127,6 +130,9 @@ void GrDirectContextPriv::dumpGpuStatsKeyValuePairs(SkTArray<SkString>* keys,
     if (auto builder = fContext->fGpu->pipelineBuilder()) {
         builder->stats()->dumpKeyValuePairs(keys, values);
     }
+    if (auto atlasManager = fContext->onGetAtlasManager()) {
+        atlasManager->dumpStatsKeyValuePairs(keys, values);
+    }
 #endif
 }
 
@@ -234,6 +234,68 @@ inline void GrDrawOpAtlas::processEviction(PlotLocator plotLocator) {
     }
 
     fAtlasGeneration = fGenerationCounter->next();
+    fStats.incPlotEvictions();
+}
+
+void GrDrawOpAtlas::relocatePlot(Plot* src, Plot* dst) {
+    SkASSERT(fEvictionCallbacks.empty());
+    SkASSERT(src->fWidth == dst->fWidth && src->fHeight == dst->fHeight);
+    if (!src->fData) {
+        return;
+    }
+
+    size_t size = src->fBytesPerPixel * src->fWidth * src->fHeight;
+    if (!dst->fData) {
+        dst->fData = reinterpret_cast<unsigned char*>(sk_malloc_throw(size));
+    }
+    memcpy(dst->fData, src->fData, size);
+    dst->fRectanizer.copyFrom(src->fRectanizer);
+
+    // The whole plot goes up with the next upload. Until then 'dst' is treated like a plot that
+    // was just filled, so it is neither evicted nor picked as another relocation target.
+    dst->fDirtyRect.setWH(dst->fWidth, dst->fHeight);
+    SkDEBUGCODE(dst->fDirty = true;)
+    dst->resetFlushesSinceLastUsed();
+    this->makeMRU(dst, dst->pageIndex());
+
+    fRelocations.push_back({src->plotLocator(),
+                            dst->plotLocator(),
+                            SkIPoint16::Make(dst->fOffset.fX - src->fOffset.fX,
+                                             dst->fOffset.fY - src->fOffset.fY)});
+    fStats.incPlotRelocations();
+}
+
+bool GrDrawOpAtlas::relocate(GrDeferredUploadTarget* target, AtlasLocator* atlasLocator) {
+    for (const Relocation& relocation : fRelocations) {
+        if (relocation.fFrom == atlasLocator->plotLocator()) {
+            if (!this->hasID(relocation.fTo)) {
+                return false;
+            }
+            SkIPoint topLeft = atlasLocator->topLeft();
+            atlasLocator->updateRect(GrIRect16::MakeXYWH(
+                    SkToS16(topLeft.x() + relocation.fOffset.fX),
+                    SkToS16(topLeft.y() + relocation.fOffset.fY),
+                    SkToS16(atlasLocator->width()),
+                    SkToS16(atlasLocator->height())));
+            Plot* plot = fPages[relocation.fTo.pageIndex()]
+                                 .fPlotArray[relocation.fTo.plotIndex()].get();
+            return this->updatePlot(target, atlasLocator, plot);
+        }
+    }
+    return false;
+}
+
+float GrDrawOpAtlas::occupancy() const {
+    if (!fNumActivePages) {
+        return 0;
+    }
+    float percentFull = 0;
+    for (uint32_t pageIdx = 0; pageIdx < fNumActivePages; ++pageIdx) {
+        for (uint32_t plotIdx = 0; plotIdx < fNumPlots; ++plotIdx) {
+            percentFull += fPages[pageIdx].fPlotArray[plotIdx]->fRectanizer.percentFull();
+        }
+    }
+    return percentFull / (fNumActivePages * fNumPlots);
 }
 
 inline bool GrDrawOpAtlas::updatePlot(GrDeferredUploadTarget* target,
@@ -256,6 +318,7 @@ inline bool GrDrawOpAtlas::updatePlot(GrDeferredUploadTarget* target,
                     plotsp->uploadToTexture(writePixels, proxy);
                 });
         plot->setLastUploadToken(lastUploadToken);
+        fStats.incASAPUploads();
     }
     atlasLocator->updatePlotLocator(plot->plotLocator());
     SkDEBUGCODE(this->validate(*atlasLocator);)
@@ -393,6 +456,7 @@ GrDrawOpAtlas::ErrorCode GrDrawOpAtlas::addToAtlas(GrResourceProvider* resourceP
                 plotsp->uploadToTexture(writePixels, proxy);
             });
     newPlot->setLastUploadToken(lastUploadToken);
+    fStats.incInlineUploads();
 
     atlasLocator->updatePlotLocator(newPlot->plotLocator());
     SkDEBUGCODE(this->validate(*atlasLocator);)
@@ -406,6 +470,13 @@ void GrDrawOpAtlas::compact(GrDeferredUploadToken startTokenForNextFlush) {
         return;
     }
 
+    // Forget relocations whose destination has since been evicted.
+    for (int i = fRelocations.count() - 1; i >= 0; --i) {
+        if (!this->hasID(fRelocations[i].fTo)) {
+            fRelocations.removeShuffle(i);
+        }
+    }
+
     // For all plots, reset number of flushes since used if used this frame.
     PlotList::Iter plotIter;
     bool atlasUsedThisFlush = false;
@@ -519,12 +590,18 @@ void GrDrawOpAtlas::compact(GrDeferredUploadToken startTokenForNextFlush) {
             while (Plot* plot = plotIter.get()) {
                 // If this plot was used recently
                 if (plot->flushesSinceLastUsed() <= kPlotRecentlyUsedCount) {
-                    // See if there's room in an earlier page and if so evict.
+                    // See if there's room in an earlier page and if so move or evict.
                     // We need to be somewhat harsh here so that a handful of plots that are
                     // consistently in use don't end up locking the page in memory.
                     if (availablePlots.count() > 0) {
+                        Plot* dst = availablePlots.back();
+                        this->processEvictionAndResetRects(dst);
+                        // Clients with eviction callbacks track plots themselves and can't follow
+                        // a relocation.
+                        if (fEvictionCallbacks.empty()) {
+                            this->relocatePlot(plot, dst);
+                        }
                         this->processEvictionAndResetRects(plot);
-                        this->processEvictionAndResetRects(availablePlots.back());
                         availablePlots.pop_back();
                         --usedPlots;
                     }
@@ -609,6 +686,7 @@ bool GrDrawOpAtlas::activateNewPage(GrResourceProvider* resourceProvider) {
 #endif
 
     ++fNumActivePages;
+    fStats.incPageActivations();
     return true;
 }
 
@@ -640,6 +718,7 @@ inline void GrDrawOpAtlas::deactivateLastPage() {
     // remove ref to the backing texture
     fViews[lastPageIndex].proxy()->deinstantiate();
     --fNumActivePages;
+    fStats.incPageDeactivations();
 }
 
 GrDrawOpAtlasConfig::GrDrawOpAtlasConfig(int maxTextureSize, size_t maxBytes) {
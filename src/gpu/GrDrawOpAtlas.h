@@ -12,6 +12,7 @@
 #include <vector>
 
 #include "include/gpu/GrBackendSurface.h"
+#include "include/gpu/GrConfig.h"
 #include "include/private/SkTArray.h"
 #include "src/core/SkIPoint16.h"
 #include "src/core/SkTInternalLList.h"
@@ -49,6 +50,11 @@ class GrTextureProxy;
  * solution is to make the client a subclass of GrOnFlushCallbackObject, register it with the
  * GrContext via addOnFlushCallbackObject(), and the client's postFlush() method calls compact()
  * and passes in the given GrDrawUploadToken.
+ *
+ * When compact() shifts a plot that is still in use from the last page to an earlier one, atlases
+ * without eviction callbacks relocate the plot's contents instead of evicting them. Clients then
+ * call relocate() on locators that are no longer valid to find the subimage at its new location,
+ * which avoids adding every subimage of that plot again.
  */
 class GrDrawOpAtlas {
 public:
@@ -282,8 +288,58 @@ public:
         plot->setLastUseToken(token);
     }
 
+    /**
+     * If the plot holding 'atlasLocator' was moved by compact(), point the locator at the plot's
+     * new location and schedule the upload of that plot. Returns false if the subimage is no
+     * longer in the atlas and has to be added again.
+     */
+    bool relocate(GrDeferredUploadTarget*, AtlasLocator*);
+
     uint32_t numActivePages() { return fNumActivePages; }
 
+    /** The fraction of the area of the active pages that is covered by subimages. */
+    float occupancy() const;
+
+    class Stats {
+    public:
+#if GR_GPU_STATS
+        int asapUploads() const { return fASAPUploads; }
+        void incASAPUploads() { ++fASAPUploads; }
+
+        int inlineUploads() const { return fInlineUploads; }
+        void incInlineUploads() { ++fInlineUploads; }
+
+        int plotEvictions() const { return fPlotEvictions; }
+        void incPlotEvictions() { ++fPlotEvictions; }
+
+        int plotRelocations() const { return fPlotRelocations; }
+        void incPlotRelocations() { ++fPlotRelocations; }
+
+        int pageActivations() const { return fPageActivations; }
+        void incPageActivations() { ++fPageActivations; }
+
+        int pageDeactivations() const { return fPageDeactivations; }
+        void incPageDeactivations() { ++fPageDeactivations; }
+
+    private:
+        int fASAPUploads = 0;
+        int fInlineUploads = 0;
+        int fPlotEvictions = 0;
+        int fPlotRelocations = 0;
+        int fPageActivations = 0;
+        int fPageDeactivations = 0;
+#else
+        void incASAPUploads() {}
+        void incInlineUploads() {}
+        void incPlotEvictions() {}
+        void incPlotRelocations() {}
+        void incPageActivations() {}
+        void incPageDeactivations() {}
+#endif
+    };
+
+    const Stats& stats() const { return fStats; }
+
     /**
      * A class which can be handed back to GrDrawOpAtlas for updating last use tokens in bulk.  The
      * current max number of plots per page the GrDrawOpAtlas can handle is 32. If in the future
@@ -485,6 +541,8 @@ private:
     void deactivateLastPage();
 
     void processEviction(PlotLocator);
+    // Copy the contents of 'src' to the freshly reset 'dst' and remember where they went.
+    void relocatePlot(Plot* src, Plot* dst);
     inline void processEvictionAndResetRects(Plot* plot) {
         this->processEviction(plot->plotLocator());
         plot->resetRects();
@@ -522,6 +580,17 @@ private:
 
     uint32_t fNumActivePages;
 
+    // Plots moved by compact(). Locators of subimages in 'fFrom' can be rewritten to 'fTo' by
+    // adding 'fOffset' until the plot at 'fTo' is evicted.
+    struct Relocation {
+        PlotLocator fFrom;
+        PlotLocator fTo;
+        SkIPoint16  fOffset;
+    };
+    SkTArray<Relocation> fRelocations;
+
+    Stats fStats;
+
     SkDEBUGCODE(void validate(const AtlasLocator& atlasLocator) const;)
 };
 
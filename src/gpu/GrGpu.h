@@ -10,6 +10,7 @@
 
 #include "include/core/SkPath.h"
 #include "include/core/SkSurface.h"
+#include "include/gpu/GrContextOptions.h"
 #include "include/gpu/GrTypes.h"
 #include "include/private/SkTArray.h"
 #include "src/core/SkSpan.h"
@@ -26,7 +27,6 @@
 class GrAttachment;
 class GrBackendRenderTarget;
 class GrBackendSemaphore;
-struct GrContextOptions;
 class GrDirectContext;
 class GrGpuBuffer;
 class GrGLContext;
@@ -618,6 +618,34 @@ public:
 
     virtual bool precompileShader(const SkData& key, const SkData& data) { return false; }
 
+    /**
+     * precompileShader() split in two stages so that most of the work can happen off of the
+     * context's thread. translatePrecompile() is thread safe and does everything that doesn't need
+     * the backend API, e.g. translating the cached SkSL, using the passed in compiler. It reports
+     * errors to the passed in handler, never to the context's, which expects its own thread.
+     * finishPrecompile() runs on the context's thread and creates the program from the
+     * translation. Backends that don't split the work leave the translation null, in which case
+     * finishPrecompile() is just precompileShader().
+     */
+    struct PrecompileTranslation {
+        virtual ~PrecompileTranslation() = default;
+    };
+
+    virtual bool translatePrecompile(SkSL::Compiler*,
+                                     GrContextOptions::ShaderErrorHandler*,
+                                     const SkData& key,
+                                     const SkData& data,
+                                     std::unique_ptr<PrecompileTranslation>*) const {
+        return true;
+    }
+
+    virtual bool finishPrecompile(const SkData& key,
+                                  const SkData& data,
+                                  std::unique_ptr<PrecompileTranslation> translation) {
+        SkASSERT(!translation);
+        return this->precompileShader(key, data);
+    }
+
 #if GR_TEST_UTILS
     /** Check a handle represents an actual texture in the backend API that has not been freed. */
     virtual bool isTestingOnlyBackendTexture(const GrBackendTexture&) const = 0;
@@ -34,6 +34,13 @@ public:
 
     bool addRect(int w, int h, SkIPoint16* loc) final;
 
+    // Take on the packing state of 'that', which must have the same dimensions.
+    void copyFrom(const GrRectanizerSkyline& that) {
+        SkASSERT(this->width() == that.width() && this->height() == that.height());
+        fSkyline = that.fSkyline;
+        fAreaSoFar = that.fAreaSoFar;
+    }
+
     float percentFull() const final {
         return fAreaSoFar / ((float)this->width() * this->height());
     }
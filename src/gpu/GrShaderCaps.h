@@ -14,6 +14,7 @@
 #include "src/gpu/glsl/GrGLSL.h"
 
 namespace SkSL {
+class ModuleCache;
 class ShaderCapsFactory;
 class SharedCompiler;
 }  // namespace SkSL
@@ -340,6 +341,7 @@ private:
     friend class GrMockCaps;
     friend class GrMtlCaps;
     friend class GrVkCaps;
+    friend class SkSL::ModuleCache;
     friend class SkSL::ShaderCapsFactory;
     friend class SkSL::SharedCompiler;
 };
@@ -0,0 +1,128 @@
+/*
+ * Copyright 2021 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/gpu/GrShaderPrecompiler.h"
+
+#include "src/core/SkTaskGroup.h"
+#include "src/core/SkTraceEvent.h"
+#include "src/gpu/GrCaps.h"
+#include "src/gpu/GrDirectContextPriv.h"
+#include "src/sksl/SkSLCompiler.h"
+
+GrShaderPrecompiler::GrShaderPrecompiler(GrGpu* gpu, SkTaskGroup* taskGroup)
+        : fGpu(gpu)
+        , fTaskGroup(taskGroup) {}
+
+GrShaderPrecompiler::~GrShaderPrecompiler() {
+    // Translations reference fGpu and our compiler pool, so they must all be done before either
+    // goes away. The task group is shared, so this also waits for the context's other tasks.
+    if (fTaskGroup) {
+        fTaskGroup->wait();
+    }
+}
+
+std::unique_ptr<SkSL::Compiler> GrShaderPrecompiler::acquireCompiler() {
+    {
+        SkAutoMutexExclusive lock(fMutex);
+        if (!fCompilers.empty()) {
+            std::unique_ptr<SkSL::Compiler> compiler = std::move(fCompilers.back());
+            fCompilers.pop_back();
+            return compiler;
+        }
+    }
+    return std::make_unique<SkSL::Compiler>(fGpu->caps()->shaderCaps());
+}
+
+void GrShaderPrecompiler::releaseCompiler(std::unique_ptr<SkSL::Compiler> compiler) {
+    SkAutoMutexExclusive lock(fMutex);
+    fCompilers.push_back(std::move(compiler));
+}
+
+void GrShaderPrecompiler::add(sk_sp<SkData> key, sk_sp<SkData> data) {
+    SkASSERT(key && data);
+    auto job = std::make_unique<Job>();
+    job->fKey = std::move(key);
+    job->fData = std::move(data);
+    {
+        SkAutoMutexExclusive lock(fMutex);
+        ++fPending;
+    }
+    if (!fTaskGroup) {
+        this->translate(std::move(job));
+        return;
+    }
+    // SkTaskGroup takes a copyable std::function, so hand the job over as a raw pointer.
+    Job* rawJob = job.release();
+    fTaskGroup->add([this, rawJob] { this->translate(std::unique_ptr<Job>(rawJob)); });
+}
+
+void GrShaderPrecompiler::translate(std::unique_ptr<Job> job) {
+    TRACE_EVENT0("skia.shaders", "GrShaderPrecompiler::translate");
+    std::unique_ptr<SkSL::Compiler> compiler = this->acquireCompiler();
+    job->fTranslated = fGpu->translatePrecompile(compiler.get(), &job->fErrors, *job->fKey,
+                                                 *job->fData, &job->fTranslation);
+    this->releaseCompiler(std::move(compiler));
+
+    SkAutoMutexExclusive lock(fMutex);
+    fTranslated.push_back(std::move(job));
+}
+
+void GrShaderPrecompiler::DeferredErrorHandler::reportTo(
+        GrContextOptions::ShaderErrorHandler* handler) const {
+    for (const auto& [shader, errors] : fErrors) {
+        handler->compileError(shader.c_str(), errors.c_str());
+    }
+}
+
+int GrShaderPrecompiler::finish(bool waitForAll) {
+    if (waitForAll && fTaskGroup) {
+        fTaskGroup->wait();
+    }
+
+    SkTArray<std::unique_ptr<Job>> ready;
+    {
+        SkAutoMutexExclusive lock(fMutex);
+        ready.swap(fTranslated);
+        fPending -= ready.count();
+    }
+
+    GrContextOptions::ShaderErrorHandler* errorHandler =
+            fGpu->getContext()->priv().getShaderErrorHandler();
+    int succeeded = 0;
+    for (std::unique_ptr<Job>& job : ready) {
+        job->fErrors.reportTo(errorHandler);
+        if (job->fTranslated &&
+            fGpu->finishPrecompile(*job->fKey, *job->fData, std::move(job->fTranslation))) {
+            ++succeeded;
+        } else {
+            ++fFailed;
+        }
+    }
+    fSucceeded += succeeded;
+    return succeeded;
+}
+
+void GrShaderPrecompiler::abandon() {
+    if (fTaskGroup) {
+        fTaskGroup->wait();
+    }
+    SkAutoMutexExclusive lock(fMutex);
+    fFailed += fTranslated.count();
+    fPending -= fTranslated.count();
+    fTranslated.reset();
+}
+
+GrDirectContext::PrecompileStats GrShaderPrecompiler::stats() const {
+    GrDirectContext::PrecompileStats stats;
+    {
+        SkAutoMutexExclusive lock(fMutex);
+        stats.fPending = fPending;
+    }
+    stats.fSucceeded = fSucceeded;
+    stats.fFailed = fFailed;
+    return stats;
+}
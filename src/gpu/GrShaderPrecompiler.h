@@ -0,0 +1,95 @@
+/*
+ * Copyright 2021 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef GrShaderPrecompiler_DEFINED
+#define GrShaderPrecompiler_DEFINED
+
+#include "include/core/SkData.h"
+#include "include/core/SkString.h"
+#include "include/gpu/GrContextOptions.h"
+#include "include/gpu/GrDirectContext.h"
+#include "include/private/SkMutex.h"
+#include "include/private/SkTArray.h"
+#include "src/gpu/GrGpu.h"
+
+#include <memory>
+#include <utility>
+
+class SkTaskGroup;
+
+/**
+ * Runs the backend-independent half of GrGpu's shader precompilation (SkSL parsing and
+ * translation to the backend's shading language) on the context's task group, and hands the results back to
+ * the context's thread where GrGpu::finishPrecompile performs the work that requires the 3D API
+ * (e.g. linking a GL program).
+ *
+ * Each worker borrows an SkSL::Compiler from a small pool so that translations never share a
+ * compiler with the GrGpu or with each other. Without a task group (the context has no executor),
+ * translation runs synchronously inside add().
+ */
+class GrShaderPrecompiler {
+public:
+    // The task group is the context's, and may be shared with other work.
+    GrShaderPrecompiler(GrGpu*, SkTaskGroup*);
+    ~GrShaderPrecompiler();
+
+    void add(sk_sp<SkData> key, sk_sp<SkData> data);
+
+    /**
+     * Completes all jobs whose translation has finished. If waitForAll is true, blocks until every
+     * pending translation is done first. Returns the number of jobs that finished successfully.
+     * Must be called on the context's thread.
+     */
+    int finish(bool waitForAll);
+
+    /** Drops all finished-but-not-completed jobs. Used when the context is abandoned. */
+    void abandon();
+
+    GrDirectContext::PrecompileStats stats() const;
+
+private:
+    // Holds the errors a translation reports off the context's thread, until finish() passes
+    // them to the context's ShaderErrorHandler on its thread.
+    class DeferredErrorHandler final : public GrContextOptions::ShaderErrorHandler {
+    public:
+        void compileError(const char* shader, const char* errors) override {
+            fErrors.push_back({SkString(shader), SkString(errors)});
+        }
+
+        void reportTo(GrContextOptions::ShaderErrorHandler*) const;
+
+    private:
+        SkTArray<std::pair<SkString, SkString>> fErrors;
+    };
+
+    struct Job {
+        sk_sp<SkData> fKey;
+        sk_sp<SkData> fData;
+        std::unique_ptr<GrGpu::PrecompileTranslation> fTranslation;
+        DeferredErrorHandler fErrors;
+        bool fTranslated = false;
+    };
+
+    void translate(std::unique_ptr<Job>);
+
+    std::unique_ptr<SkSL::Compiler> acquireCompiler();
+    void releaseCompiler(std::unique_ptr<SkSL::Compiler>);
+
+    GrGpu*                               fGpu;
+    SkTaskGroup*                         fTaskGroup;
+
+    mutable SkMutex                      fMutex;
+    SkTArray<std::unique_ptr<SkSL::Compiler>> fCompilers SK_GUARDED_BY(fMutex);
+    SkTArray<std::unique_ptr<Job>>       fTranslated SK_GUARDED_BY(fMutex);
+    int                                  fPending SK_GUARDED_BY(fMutex) = 0;
+
+    // Only touched on the context's thread.
+    int                                  fSucceeded = 0;
+    int                                  fFailed = 0;
+};
+
+#endif
@@ -377,7 +377,7 @@ void GrSurfaceDrawContext::drawGlyphRunList(const GrClip* clip,
     // It might be worth caching these things, but its not clear at this time
     // TODO for animated mask filters, this will fill up our cache.  We need a safeguard here
     const SkMaskFilter* mf = drawPaint.getMaskFilter();
-    bool canCache = glyphRunList.canCache() &&
+    bool canCache = (glyphRunList.canCache() || textBlobCache->usesContentKeys()) &&
             !(drawPaint.getPathEffect() || (mf && !as_MFB(mf)->asABlur(&blurRec)));
 
     // If we're doing linear blending, then we can disable the gamma hacks.
@@ -402,7 +402,9 @@ void GrSurfaceDrawContext::drawGlyphRunList(const GrClip* clip,
         GrColor canonicalColor = compute_canonical_color(drawPaint, hasLCD);
 
         key.fPixelGeometry = pixelGeometry;
-        key.fUniqueID = glyphRunList.uniqueID();
+        key.fUniqueID = textBlobCache->usesContentKeys()
+                                ? textBlobCache->findOrCreateContentID(glyphRunList)
+                                : glyphRunList.uniqueID();
         key.fStyle = drawPaint.getStyle();
         if (key.fStyle != SkPaint::kFill_Style) {
             key.fFrameWidth = drawPaint.getStrokeWidth();
@@ -446,6 +448,10 @@ void GrSurfaceDrawContext::drawGlyphRunList(const GrClip* clip,
             // TODO we could probably get away with reuse most of the time if the pointer is unique,
             //      but we'd have to clear the SubRun information
             textBlobCache->remove(blob.get());
+            if (textBlobCache->usesContentKeys()) {
+                // Removing the last blob for some content also retires its content ID.
+                key.fUniqueID = textBlobCache->findOrCreateContentID(glyphRunList);
+            }
         }
 
         blob = GrTextBlob::Make(glyphRunList, drawMatrix);
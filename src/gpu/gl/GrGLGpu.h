@@ -28,6 +28,7 @@
 
 class GrGLBuffer;
 class GrGLOpsRenderPass;
+struct GrGLPrecompiledShaders;
 class GrPipeline;
 class GrSwizzle;
 
@@ -150,6 +151,16 @@ public:
         return fProgramCache->precompileShader(key, data);
     }
 
+    bool translatePrecompile(SkSL::Compiler*,
+                             GrContextOptions::ShaderErrorHandler*,
+                             const SkData& key,
+                             const SkData& data,
+                             std::unique_ptr<PrecompileTranslation>*) const override;
+
+    bool finishPrecompile(const SkData& key,
+                          const SkData& data,
+                          std::unique_ptr<PrecompileTranslation>) override;
+
 #if GR_TEST_UTILS
     bool isTestingOnlyBackendTexture(const GrBackendTexture&) const override;
 
@@ -377,6 +388,7 @@ private:
             return tmp;
         }
         bool precompileShader(const SkData& key, const SkData& data);
+        bool precompileShader(const SkData& key, const GrGLPrecompiledShaders&);
 
     private:
         struct Entry;
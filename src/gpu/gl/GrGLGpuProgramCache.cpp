@@ -125,3 +125,49 @@ bool GrGLGpu::ProgramCache::precompileShader(const SkData& key, const SkData& da
     fMap.insert(desc, std::make_unique<Entry>(precompiledProgram));
     return true;
 }
+
+bool GrGLGpu::ProgramCache::precompileShader(const SkData& key,
+                                             const GrGLPrecompiledShaders& shaders) {
+    GrProgramDesc desc;
+    if (!GrProgramDesc::BuildFromData(&desc, key.data(), key.size())) {
+        return false;
+    }
+
+    std::unique_ptr<Entry>* entry = fMap.find(desc);
+    if (entry) {
+        // We've already seen/compiled this shader
+        return true;
+    }
+
+    GrGLPrecompiledProgram precompiledProgram;
+    if (!GrGLProgramBuilder::PrecompileProgram(&precompiledProgram, fGpu, shaders)) {
+        return false;
+    }
+
+    fMap.insert(desc, std::make_unique<Entry>(precompiledProgram));
+    return true;
+}
+
+bool GrGLGpu::translatePrecompile(SkSL::Compiler* compiler,
+                                  GrContextOptions::ShaderErrorHandler* errorHandler,
+                                  const SkData& key,
+                                  const SkData& data,
+                                  std::unique_ptr<PrecompileTranslation>* translation) const {
+    auto shaders = std::make_unique<GrGLPrecompiledShaders>();
+    if (!GrGLProgramBuilder::TranslatePrecompiledShaders(shaders.get(), this, compiler,
+                                                          errorHandler, data)) {
+        return false;
+    }
+    *translation = std::move(shaders);
+    return true;
+}
+
+bool GrGLGpu::finishPrecompile(const SkData& key,
+                               const SkData& data,
+                               std::unique_ptr<PrecompileTranslation> translation) {
+    if (!translation) {
+        return this->precompileShader(key, data);
+    }
+    return fProgramCache->precompileShader(
+            key, *static_cast<GrGLPrecompiledShaders*>(translation.get()));
+}
@@ -578,6 +578,18 @@ sk_sp<GrGLProgram> GrGLProgramBuilder::createProgram(GrGLuint programID) {
 bool GrGLProgramBuilder::PrecompileProgram(GrGLPrecompiledProgram* precompiledProgram,
                                            GrGLGpu* gpu,
                                            const SkData& cachedData) {
+    GrGLPrecompiledShaders shaders;
+    return TranslatePrecompiledShaders(&shaders, gpu, gpu->shaderCompiler(),
+                                       gpu->getContext()->priv().getShaderErrorHandler(),
+                                       cachedData) &&
+           PrecompileProgram(precompiledProgram, gpu, shaders);
+}
+
+bool GrGLProgramBuilder::TranslatePrecompiledShaders(GrGLPrecompiledShaders* precompiledShaders,
+                                                     const GrGLGpu* gpu,
+                                                     SkSL::Compiler* compiler,
+                                                     GrContextOptions::ShaderErrorHandler* errorHandler,
+                                                     const SkData& cachedData) {
     SkReadBuffer reader(cachedData.data(), cachedData.size());
     SkFourByteTag shaderType = GrPersistentCacheUtils::GetType(&reader);
     if (shaderType != kSKSL_Tag) {
@@ -585,20 +597,41 @@ bool GrGLProgramBuilder::PrecompileProgram(GrGLPrecompiledProgram* precompiledPr
         return false;
     }
 
-    const GrGLInterface* gl = gpu->glInterface();
-    auto errorHandler = gpu->getContext()->priv().getShaderErrorHandler();
-
     SkSL::Program::Settings settings;
     settings.fSharpenTextures = gpu->getContext()->priv().options().fSharpenMipmappedTextures;
     GrPersistentCacheUtils::ShaderMetadata meta;
     meta.fSettings = &settings;
 
     SkSL::String shaders[kGrShaderTypeCount];
-    SkSL::Program::Inputs inputs;
-    if (!GrPersistentCacheUtils::UnpackCachedShaders(&reader, shaders, &inputs, 1, &meta)) {
+    if (!GrPersistentCacheUtils::UnpackCachedShaders(&reader, shaders,
+                                                     &precompiledShaders->fInputs, 1, &meta)) {
+        return false;
+    }
+
+    auto translate = [&](SkSL::ProgramKind kind, GrShaderType shaderType) {
+        return GrSkSLtoGLSL(compiler, kind, shaders[shaderType], settings,
+                            &precompiledShaders->fGLSL[shaderType], errorHandler) != nullptr;
+    };
+
+    if (!translate(SkSL::ProgramKind::kFragment, kFragment_GrShaderType) ||
+        !translate(SkSL::ProgramKind::kVertex, kVertex_GrShaderType) ||
+        (!shaders[kGeometry_GrShaderType].empty() &&
+         !translate(SkSL::ProgramKind::kGeometry, kGeometry_GrShaderType))) {
         return false;
     }
 
+    precompiledShaders->fAttributeNames = std::move(meta.fAttributeNames);
+    precompiledShaders->fHasCustomColorOutput = meta.fHasCustomColorOutput;
+    precompiledShaders->fHasSecondaryColorOutput = meta.fHasSecondaryColorOutput;
+    return true;
+}
+
+bool GrGLProgramBuilder::PrecompileProgram(GrGLPrecompiledProgram* precompiledProgram,
+                                           GrGLGpu* gpu,
+                                           const GrGLPrecompiledShaders& precompiledShaders) {
+    const GrGLInterface* gl = gpu->glInterface();
+    auto errorHandler = gpu->getContext()->priv().getShaderErrorHandler();
+
     GrGLuint programID;
     GR_GL_CALL_RET(gl, programID, CreateProgram());
     if (0 == programID) {
@@ -607,14 +640,9 @@ bool GrGLProgramBuilder::PrecompileProgram(GrGLPrecompiledProgram* precompiledPr
 
     SkTDArray<GrGLuint> shadersToDelete;
 
-    auto compileShader = [&](SkSL::ProgramKind kind, const SkSL::String& sksl, GrGLenum type) {
-        SkSL::String glsl;
-        auto program = GrSkSLtoGLSL(gpu, kind, sksl, settings, &glsl, errorHandler);
-        if (!program) {
-            return false;
-        }
-
-        if (GrGLuint shaderID = GrGLCompileAndAttachShader(gpu->glContext(), programID, type, glsl,
+    auto compileShader = [&](GrShaderType shaderType, GrGLenum type) {
+        if (GrGLuint shaderID = GrGLCompileAndAttachShader(gpu->glContext(), programID, type,
+                                                           precompiledShaders.fGLSL[shaderType],
                                                            gpu->pipelineBuilder()->stats(),
                                                            errorHandler)) {
             shadersToDelete.push_back(shaderID);
@@ -624,31 +652,26 @@ bool GrGLProgramBuilder::PrecompileProgram(GrGLPrecompiledProgram* precompiledPr
         }
     };
 
-    if (!compileShader(SkSL::ProgramKind::kFragment,
-                       shaders[kFragment_GrShaderType],
-                       GR_GL_FRAGMENT_SHADER) ||
-        !compileShader(SkSL::ProgramKind::kVertex,
-                       shaders[kVertex_GrShaderType],
-                       GR_GL_VERTEX_SHADER) ||
-        (!shaders[kGeometry_GrShaderType].empty() &&
-         !compileShader(SkSL::ProgramKind::kGeometry,
-                       shaders[kGeometry_GrShaderType],
-                       GR_GL_GEOMETRY_SHADER))) {
+    if (!compileShader(kFragment_GrShaderType, GR_GL_FRAGMENT_SHADER) ||
+        !compileShader(kVertex_GrShaderType, GR_GL_VERTEX_SHADER) ||
+        (!precompiledShaders.fGLSL[kGeometry_GrShaderType].empty() &&
+         !compileShader(kGeometry_GrShaderType, GR_GL_GEOMETRY_SHADER))) {
         cleanup_program(gpu, programID, shadersToDelete);
         return false;
     }
 
-    for (int i = 0; i < meta.fAttributeNames.count(); ++i) {
-        GR_GL_CALL(gpu->glInterface(), BindAttribLocation(programID, i,
-                                                          meta.fAttributeNames[i].c_str()));
+    for (int i = 0; i < precompiledShaders.fAttributeNames.count(); ++i) {
+        GR_GL_CALL(gpu->glInterface(), BindAttribLocation(
+                programID, i, precompiledShaders.fAttributeNames[i].c_str()));
     }
 
     const GrGLCaps& caps = gpu->glCaps();
-    if (meta.fHasCustomColorOutput && caps.bindFragDataLocationSupport()) {
+    if (precompiledShaders.fHasCustomColorOutput && caps.bindFragDataLocationSupport()) {
         GR_GL_CALL(gpu->glInterface(), BindFragDataLocation(programID, 0,
                 GrGLSLFragmentShaderBuilder::DeclaredColorOutputName()));
     }
-    if (meta.fHasSecondaryColorOutput && caps.shaderCaps()->mustDeclareFragmentShaderOutput()) {
+    if (precompiledShaders.fHasSecondaryColorOutput &&
+        caps.shaderCaps()->mustDeclareFragmentShaderOutput()) {
         GR_GL_CALL(gpu->glInterface(), BindFragDataLocationIndexed(programID, 0, 1,
                 GrGLSLFragmentShaderBuilder::DeclaredSecondaryColorOutputName()));
     }
@@ -664,6 +687,6 @@ bool GrGLProgramBuilder::PrecompileProgram(GrGLPrecompiledProgram* precompiledPr
     cleanup_shaders(gpu, shadersToDelete);
 
     precompiledProgram->fProgramID = programID;
-    precompiledProgram->fInputs = inputs;
+    precompiledProgram->fInputs = precompiledShaders.fInputs;
     return true;
 }
@@ -8,6 +8,7 @@
 #ifndef GrGLProgramBuilder_DEFINED
 #define GrGLProgramBuilder_DEFINED
 
+#include "src/gpu/GrGpu.h"
 #include "src/gpu/GrPipeline.h"
 #include "src/gpu/gl/GrGLProgram.h"
 #include "src/gpu/gl/GrGLProgramDataManager.h"
@@ -33,6 +34,16 @@ struct GrGLPrecompiledProgram {
     SkSL::Program::Inputs fInputs;
 };
 
+// The GLSL for a persistent cache entry that holds SkSL. Translating it doesn't need the GL
+// context, so it can happen on any thread.
+struct GrGLPrecompiledShaders : public GrGpu::PrecompileTranslation {
+    SkSL::String fGLSL[kGrShaderTypeCount];
+    SkSL::Program::Inputs fInputs;
+    SkTArray<SkSL::String> fAttributeNames;
+    bool fHasCustomColorOutput = false;
+    bool fHasSecondaryColorOutput = false;
+};
+
 class GrGLProgramBuilder : public GrGLSLProgramBuilder {
 public:
     /** Generates a shader program.
@@ -52,6 +63,16 @@ public:
 
     static bool PrecompileProgram(GrGLPrecompiledProgram*, GrGLGpu*, const SkData&);
 
+    // The two halves of PrecompileProgram. TranslatePrecompiledShaders is thread safe as long as
+    // each thread uses its own compiler and error handler.
+    static bool TranslatePrecompiledShaders(GrGLPrecompiledShaders*,
+                                            const GrGLGpu*,
+                                            SkSL::Compiler*,
+                                            GrContextOptions::ShaderErrorHandler*,
+                                            const SkData&);
+    static bool PrecompileProgram(GrGLPrecompiledProgram*, GrGLGpu*,
+                                  const GrGLPrecompiledShaders&);
+
     const GrCaps* caps() const override;
 
     GrGLGpu* gpu() const { return fGpu; }
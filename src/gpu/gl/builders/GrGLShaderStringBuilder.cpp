@@ -23,7 +23,15 @@ std::unique_ptr<SkSL::Program> GrSkSLtoGLSL(const GrGLGpu* gpu,
                                             const SkSL::Program::Settings& settings,
                                             SkSL::String* glsl,
                                             GrContextOptions::ShaderErrorHandler* errorHandler) {
-    SkSL::Compiler* compiler = gpu->shaderCompiler();
+    return GrSkSLtoGLSL(gpu->shaderCompiler(), programKind, sksl, settings, glsl, errorHandler);
+}
+
+std::unique_ptr<SkSL::Program> GrSkSLtoGLSL(SkSL::Compiler* compiler,
+                                            SkSL::ProgramKind programKind,
+                                            const SkSL::String& sksl,
+                                            const SkSL::Program::Settings& settings,
+                                            SkSL::String* glsl,
+                                            GrContextOptions::ShaderErrorHandler* errorHandler) {
     std::unique_ptr<SkSL::Program> program;
 #ifdef SK_DEBUG
     SkSL::String src = GrShaderUtils::PrettyPrint(sksl);
@@ -14,6 +14,13 @@
 #include "src/gpu/gl/GrGLContext.h"
 #include "src/sksl/SkSLGLSLCodeGenerator.h"
 
+std::unique_ptr<SkSL::Program> GrSkSLtoGLSL(SkSL::Compiler* compiler,
+                                            SkSL::ProgramKind programKind,
+                                            const SkSL::String& sksl,
+                                            const SkSL::Program::Settings& settings,
+                                            SkSL::String* glsl,
+                                            GrContextOptions::ShaderErrorHandler* errorHandler);
+
 std::unique_ptr<SkSL::Program> GrSkSLtoGLSL(const GrGLGpu* gpu,
                                             SkSL::ProgramKind programKind,
                                             const SkSL::String& sksl,
@@ -7,6 +7,7 @@
 
 #include "src/gpu/text/GrAtlasManager.h"
 
+#include "include/core/SkString.h"
 #include "src/codec/SkMasks.h"
 #include "src/core/SkAutoMalloc.h"
 #include "src/gpu/GrGlyph.h"
@@ -34,6 +35,12 @@ bool GrAtlasManager::hasGlyph(GrMaskFormat format, GrGlyph* glyph) {
     return this->getAtlas(format)->hasID(glyph->fAtlasLocator.plotLocator());
 }
 
+bool GrAtlasManager::relocateGlyph(GrMaskFormat format, GrGlyph* glyph,
+                                   GrDeferredUploadTarget* uploadTarget) {
+    SkASSERT(glyph);
+    return this->getAtlas(format)->relocate(uploadTarget, &glyph->fAtlasLocator);
+}
+
 template <typename INT_TYPE>
 static void expand_bits(INT_TYPE* dst,
                         const uint8_t* src,
@@ -288,6 +295,48 @@ void GrAtlasManager::dump(GrDirectContext* context) const {
 }
 #endif
 
+#if GR_GPU_STATS && GR_TEST_UTILS
+static const char* mask_format_name(GrMaskFormat format) {
+    switch (format) {
+        case kA8_GrMaskFormat:   return "A8";
+        case kA565_GrMaskFormat: return "A565";
+        case kARGB_GrMaskFormat: return "ARGB";
+    }
+    SkUNREACHABLE;
+}
+
+void GrAtlasManager::dumpStats(SkString* out) const {
+    for (int i = 0; i < kMaskFormatCount; ++i) {
+        if (const GrDrawOpAtlas* atlas = fAtlases[i].get()) {
+            const GrDrawOpAtlas::Stats& stats = atlas->stats();
+            out->appendf("%s glyph atlas: occupancy %.2f, ASAP uploads %d, inline uploads %d, "
+                         "plot evictions %d, plot relocations %d, page activations %d, "
+                         "page deactivations %d\n",
+                         mask_format_name(AtlasIndexToMaskFormat(i)), atlas->occupancy(),
+                         stats.asapUploads(), stats.inlineUploads(), stats.plotEvictions(),
+                         stats.plotRelocations(), stats.pageActivations(),
+                         stats.pageDeactivations());
+        }
+    }
+}
+
+void GrAtlasManager::dumpStatsKeyValuePairs(SkTArray<SkString>* keys,
+                                            SkTArray<double>* values) const {
+    for (int i = 0; i < kMaskFormatCount; ++i) {
+        if (const GrDrawOpAtlas* atlas = fAtlases[i].get()) {
+            const char* name = mask_format_name(AtlasIndexToMaskFormat(i));
+            const GrDrawOpAtlas::Stats& stats = atlas->stats();
+            keys->push_back(SkStringPrintf("glyph_atlas_%s_occupancy", name));
+            values->push_back(atlas->occupancy());
+            keys->push_back(SkStringPrintf("glyph_atlas_%s_plot_evictions", name));
+            values->push_back(stats.plotEvictions());
+            keys->push_back(SkStringPrintf("glyph_atlas_%s_plot_relocations", name));
+            values->push_back(stats.plotRelocations());
+        }
+    }
+}
+#endif
+
 void GrAtlasManager::setAtlasDimensionsToMinimum_ForTesting() {
     // Delete any old atlases.
     // This should be safe to do as long as we are not in the middle of a flush.
@@ -46,6 +46,10 @@ public:
 
     bool hasGlyph(GrMaskFormat, GrGlyph*);
 
+    // If the glyph's plot was moved to another page when the atlas was compacted, point the glyph
+    // at its new location. Returns false if the glyph has to be added to the atlas again.
+    bool relocateGlyph(GrMaskFormat, GrGlyph*, GrDeferredUploadTarget*);
+
     // If bilerpPadding == true then addGlyphToAtlas adds a 1 pixel border to the glyph before
     // inserting it into the atlas.
     GrDrawOpAtlas::ErrorCode addGlyphToAtlas(const SkGlyph& skGlyph,
@@ -109,6 +113,11 @@ public:
     void dump(GrDirectContext*) const;
 #endif
 
+#if GR_GPU_STATS && GR_TEST_UTILS
+    void dumpStats(SkString*) const;
+    void dumpStatsKeyValuePairs(SkTArray<SkString>* keys, SkTArray<double>* values) const;
+#endif
+
     void setAtlasDimensionsToMinimum_ForTesting();
     void setMaxPages_TestingOnly(uint32_t maxPages);
 
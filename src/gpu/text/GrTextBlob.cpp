@@ -399,7 +399,8 @@ std::tuple<bool, int> GlyphVector::regenerateAtlas(int begin, int end,
             GrGlyph* grGlyph = variant.grGlyph;
             SkASSERT(grGlyph != nullptr);
 
-            if (!atlasManager->hasGlyph(maskFormat, grGlyph)) {
+            if (!atlasManager->hasGlyph(maskFormat, grGlyph) &&
+                !atlasManager->relocateGlyph(maskFormat, grGlyph, uploadTarget)) {
                 const SkGlyph& skGlyph = *metricsAndImages.glyph(grGlyph->fPackedID);
                 auto code = atlasManager->addGlyphToAtlas(
                         skGlyph, grGlyph, srcPadding, target->resourceProvider(),
@@ -367,7 +367,9 @@ public:
     SK_BEGIN_REQUIRE_DENSE
     struct Key {
         Key();
-        uint32_t fUniqueID;
+        // Either the SkTextBlob's unique ID, or - when the cache is keyed by content - an ID
+        // handed out by GrTextBlobCache::findOrCreateContentID, which never fits in 32 bits.
+        uint64_t fUniqueID;
         // Color may affect the gamma of the mask we generate, but in a fairly limited way.
         // Each color is assigned to on of a fixed number of buckets based on its
         // luminance. For each luminance bucket there is a "canonical color" that
@@ -7,6 +7,10 @@
 
 #include "src/gpu/text/GrTextBlobCache.h"
 
+#include "src/core/SkGlyphRun.h"
+#include "src/core/SkOpts.h"
+#include "src/core/SkWriter32.h"
+
 DECLARE_SKMESSAGEBUS_MESSAGE(GrTextBlobCache::PurgeBlobMessage)
 
 // This function is captured by the above macro using implementations from SkMessageBus.h
@@ -15,16 +19,97 @@ static inline bool SkShouldPostMessageToBus(
     return msg.fContextID == msgBusUniqueID;
 }
 
-GrTextBlobCache::GrTextBlobCache(uint32_t messageBusID)
+GrTextBlobCache::GrTextBlobCache(uint32_t messageBusID, bool usesContentKeys)
         : fSizeBudget(kDefaultBudget)
         , fMessageBusID(messageBusID)
+        , fUsesContentKeys(usesContentKeys)
         , fPurgeBlobInbox(messageBusID) { }
 
+// Everything about a glyph run list that the SubRuns of a GrTextBlob depend on, other than the
+// paint and matrix which are already part of GrTextBlob::Key.
+static sk_sp<SkData> glyph_run_list_content(const SkGlyphRunList& glyphRunList) {
+    SkWriter32 writer;
+    writer.write32(SkToS32(glyphRunList.runCount()));
+    for (const SkGlyphRun& run : glyphRunList) {
+        const SkFont& font = run.font();
+        writer.write32(SkTypeface::UniqueID(font.getTypefaceOrDefault()));
+        writer.writeScalar(font.getSize());
+        writer.writeScalar(font.getScaleX());
+        writer.writeScalar(font.getSkewX());
+        writer.write32(SkToS32(font.isEmbolden())           << 0 |
+                       SkToS32(font.isSubpixel())           << 1 |
+                       SkToS32(font.isLinearMetrics())      << 2 |
+                       SkToS32(font.isEmbeddedBitmaps())    << 3 |
+                       SkToS32(font.isForceAutoHinting())   << 4 |
+                       SkToS32(font.isBaselineSnap())       << 5 |
+                       SkToS32(font.getEdging())            << 8 |
+                       SkToS32(font.getHinting())           << 16);
+        writer.write32(SkToS32(run.runSize()));
+        writer.write(run.glyphsIDs().data(), run.glyphsIDs().size_bytes());
+        writer.write(run.positions().data(), run.positions().size_bytes());
+    }
+    return writer.snapshotAsData();
+}
+
+uint64_t GrTextBlobCache::findOrCreateContentID(const SkGlyphRunList& glyphRunList) {
+    SkASSERT(fUsesContentKeys);
+
+    // Serialize and hash outside of the lock; this is the expensive part.
+    sk_sp<SkData> content = glyph_run_list_content(glyphRunList);
+    uint32_t hash = SkOpts::hash(content->data(), content->size());
+
+    SkAutoSpinlock lock{fSpinLock};
+    auto* entries = fContentIDs.find(hash);
+    if (entries == nullptr) {
+        entries = fContentIDs.set(hash, {});
+    }
+    for (const ContentIDEntry& entry : *entries) {
+        if (entry.fContent->equals(content.get())) {
+            return entry.fID;
+        }
+    }
+
+    // The content hash lives in the low half of the ID so the entry can be found again on
+    // removal. The high half is never zero, which keeps content IDs distinct from SkTextBlob IDs.
+    if (fNextContentID == 0) {
+        fNextContentID = 1;
+    }
+    uint64_t id = (uint64_t)fNextContentID++ << 32 | hash;
+    // The serialized content lives as long as the blobs keyed by it, so it is charged to the
+    // budget along with them. The blob added for this ID triggers the purge, if one is needed.
+    fCurrentSize += content->size();
+    entries->push_back(ContentIDEntry{std::move(content), id});
+    return id;
+}
+
+void GrTextBlobCache::internalRemoveContentID(uint64_t id) {
+    SkASSERT(IsContentID(id));
+    uint32_t hash = (uint32_t)id;
+    auto* entries = fContentIDs.find(hash);
+    if (entries == nullptr) {
+        return;
+    }
+    for (int i = 0; i < entries->count(); ++i) {
+        if ((*entries)[i].fID == id) {
+            fCurrentSize -= (*entries)[i].fContent->size();
+            entries->removeShuffle(i);
+            break;
+        }
+    }
+    if (entries->empty()) {
+        fContentIDs.remove(hash);
+    }
+}
+
 sk_sp<GrTextBlob> GrTextBlobCache::addOrReturnExisting(
         const SkGlyphRunList& glyphRunList, sk_sp<GrTextBlob> blob) {
     SkAutoSpinlock lock{fSpinLock};
     blob = this->internalAdd(std::move(blob));
-    glyphRunList.temporaryShuntBlobNotifyAddedToCache(fMessageBusID);
+    // Content keyed blobs are not tied to the lifetime of any SkTextBlob, so they are only
+    // removed when they fall out of the budget.
+    if (!IsContentID(GrTextBlob::GetKey(*blob).fUniqueID)) {
+        glyphRunList.temporaryShuntBlobNotifyAddedToCache(fMessageBusID);
+    }
     return blob;
 }
 
@@ -61,6 +146,9 @@ void GrTextBlobCache::internalRemove(GrTextBlob* blob) {
             idEntry->removeBlob(blob);
             if (idEntry->fBlobs.empty()) {
                 fBlobIDCache.remove(id);
+                if (IsContentID(id)) {
+                    this->internalRemoveContentID(id);
+                }
             }
         }
     }
@@ -69,6 +157,7 @@ void GrTextBlobCache::internalRemove(GrTextBlob* blob) {
 void GrTextBlobCache::freeAll() {
     SkAutoSpinlock lock{fSpinLock};
     fBlobIDCache.reset();
+    fContentIDs.reset();
     fBlobList.reset();
     fCurrentSize = 0;
 }
@@ -160,9 +249,9 @@ sk_sp<GrTextBlob> GrTextBlobCache::internalAdd(sk_sp<GrTextBlob> blob) {
 
 GrTextBlobCache::BlobIDCacheEntry::BlobIDCacheEntry() : fID(SK_InvalidGenID) {}
 
-GrTextBlobCache::BlobIDCacheEntry::BlobIDCacheEntry(uint32_t id) : fID(id) {}
+GrTextBlobCache::BlobIDCacheEntry::BlobIDCacheEntry(uint64_t id) : fID(id) {}
 
-uint32_t GrTextBlobCache::BlobIDCacheEntry::GetKey(const GrTextBlobCache::BlobIDCacheEntry& entry) {
+uint64_t GrTextBlobCache::BlobIDCacheEntry::GetKey(const GrTextBlobCache::BlobIDCacheEntry& entry) {
     return entry.fID;
 }
 
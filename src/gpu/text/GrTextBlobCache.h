@@ -8,6 +8,7 @@
 #ifndef GrTextBlobCache_DEFINED
 #define GrTextBlobCache_DEFINED
 
+#include "include/core/SkData.h"
 #include "include/core/SkRefCnt.h"
 #include "include/private/SkMutex.h"
 #include "include/private/SkTArray.h"
@@ -20,7 +21,16 @@
 
 class GrTextBlobCache {
 public:
-    GrTextBlobCache(uint32_t messageBusID);
+    GrTextBlobCache(uint32_t messageBusID, bool usesContentKeys);
+
+    // True if blobs are keyed by the content of the glyph run list rather than by the identity
+    // of the SkTextBlob it came from.
+    bool usesContentKeys() const { return fUsesContentKeys; }
+
+    // Returns the ID to use for GrTextBlob::Key::fUniqueID when keying by content. Glyph run
+    // lists with the same fonts, glyphs and positions get the same ID, regardless of which
+    // SkTextBlob - if any - they were built from. Only valid if usesContentKeys() is true.
+    uint64_t findOrCreateContentID(const SkGlyphRunList& glyphRunList) SK_EXCLUDES(fSpinLock);
 
     // If not already in the cache, then add it else, return the text blob from the cache.
     sk_sp<GrTextBlob> addOrReturnExisting(
@@ -54,9 +64,9 @@ private:
 
     struct BlobIDCacheEntry {
         BlobIDCacheEntry();
-        explicit BlobIDCacheEntry(uint32_t id);
+        explicit BlobIDCacheEntry(uint64_t id);
 
-        static uint32_t GetKey(const BlobIDCacheEntry& entry);
+        static uint64_t GetKey(const BlobIDCacheEntry& entry);
 
         void addBlob(sk_sp<GrTextBlob> blob);
 
@@ -66,14 +76,26 @@ private:
 
         int findBlobIndex(const GrTextBlob::Key& key) const;
 
-        uint32_t fID;
+        uint64_t fID;
         // Current clients don't generate multiple GrAtlasTextBlobs per SkTextBlob, so an array w/
         // linear search is acceptable.  If usage changes, we should re-evaluate this structure.
         SkSTArray<1, sk_sp<GrTextBlob>> fBlobs;
     };
 
+    // The glyph data that a content ID stands for. Kept so that hash collisions between
+    // different text can be told apart. Its size counts against the budget until the last blob
+    // with the ID is removed.
+    struct ContentIDEntry {
+        sk_sp<SkData> fContent;
+        uint64_t fID;
+    };
+
+    static bool IsContentID(uint64_t id) { return (id >> 32) != 0; }
+
     void internalPurgeStaleBlobs() SK_REQUIRES(fSpinLock);
 
+    void internalRemoveContentID(uint64_t id) SK_REQUIRES(fSpinLock);
+
     sk_sp<GrTextBlob> internalAdd(sk_sp<GrTextBlob> blob) SK_REQUIRES(fSpinLock);
     void internalRemove(GrTextBlob* blob) SK_REQUIRES(fSpinLock);
 
@@ -83,12 +105,16 @@ private:
 
     mutable SkSpinlock fSpinLock;
     TextBlobList fBlobList SK_GUARDED_BY(fSpinLock);
-    SkTHashMap<uint32_t, BlobIDCacheEntry> fBlobIDCache SK_GUARDED_BY(fSpinLock);
+    SkTHashMap<uint64_t, BlobIDCacheEntry> fBlobIDCache SK_GUARDED_BY(fSpinLock);
+    // Content hash -> the content IDs with that hash.
+    SkTHashMap<uint32_t, SkSTArray<1, ContentIDEntry>> fContentIDs SK_GUARDED_BY(fSpinLock);
+    uint32_t fNextContentID SK_GUARDED_BY(fSpinLock) {1};
     size_t fSizeBudget SK_GUARDED_BY(fSpinLock);
     size_t fCurrentSize SK_GUARDED_BY(fSpinLock) {0};
 
     // In practice 'messageBusID' is always the unique ID of the owning GrContext
     const uint32_t fMessageBusID;
+    const bool fUsesContentKeys;
     SkMessageBus<PurgeBlobMessage>::Inbox fPurgeBlobInbox SK_GUARDED_BY(fSpinLock);
 };
 
@@ -113,6 +113,22 @@ public:
     virtual bool getROPixels(GrDirectContext*, SkBitmap*,
                              CachingHint = kAllow_CachingHint) const = 0;
 
+    // Like getROPixels(), for a raster draw at the given scale (< 1), but only succeeds if the
+    // image can produce pixels smaller than its dimensions that still cover that scale (e.g. a
+    // codec's native downscale). The result may be cached under SkBitmapCacheDesc::MakeScaled.
+    virtual bool getScaledROPixels(float scale, SkBitmap*) const { return false; }
+
+    // For a raster draw that only reads subset of the image: returns pixels covering at least
+    // subset, with *origin set to their top-left within the image, if the image can produce them
+    // without decoding all of itself. Returns false when getROPixels() should be used instead.
+    virtual bool getSubsetROPixels(const SkIRect& subset, SkBitmap*, SkIPoint* origin) const {
+        return false;
+    }
+
+    // A hash of what the image's pixels are made from (e.g. its encoded data), stable across
+    // processes, for keying SkResourceCache's disk tier. 0 if there is none.
+    virtual uint64_t contentHash() const { return 0; }
+
     virtual sk_sp<SkImage> onMakeSubset(const SkIRect&, GrDirectContext*) const = 0;
 
     virtual sk_sp<SkData> onRefEncoded() const { return nullptr; }
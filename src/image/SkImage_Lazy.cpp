@@ -9,17 +9,25 @@
 
 #include "include/core/SkBitmap.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImageGenerator.h"
+#include "include/private/SkOnce.h"
+#include "include/private/SkTHash.h"
 #include "src/core/SkBitmapCache.h"
 #include "src/core/SkCachedData.h"
 #include "src/core/SkImagePriv.h"
 #include "src/core/SkNextID.h"
+#include "src/core/SkResourceCache.h"
+#include "src/core/SkResourceDiskCache.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
 
 #if SK_SUPPORT_GPU
 #include "include/gpu/GrDirectContext.h"
 #include "include/gpu/GrRecordingContext.h"
 #include "include/private/GrResourceKey.h"
-#include "src/core/SkResourceCache.h"
 #include "src/core/SkYUVPlanesCache.h"
 #include "src/gpu/GrBitmapTextureMaker.h"
 #include "src/gpu/GrCaps.h"
@@ -45,6 +53,17 @@ public:
     // This is thread safe.  It is a const field set in the constructor.
     const SkImageInfo& getInfo() { return fGenerator->getInfo(); }
 
+    // A hash of the generator's encoded data, or 0 if it has none. Computed on first use.
+    uint64_t encodedHash() {
+        fEncodedHashOnce([this] {
+            SkAutoMutexExclusive lock(fMutex);
+            if (sk_sp<SkData> encoded = fGenerator->refEncodedData()) {
+                fEncodedHash = SkResourceDiskCache::HashContents(encoded->data(), encoded->size());
+            }
+        });
+        return fEncodedHash;
+    }
+
 private:
     explicit SharedGenerator(std::unique_ptr<SkImageGenerator> gen)
             : fGenerator(std::move(gen)) {
@@ -56,6 +75,10 @@ private:
 
     std::unique_ptr<SkImageGenerator> fGenerator;
     SkMutex                           fMutex;
+    // Set once a region decode has failed, so tiled draws stop trying and decode everything.
+    std::atomic<bool>                 fSubsetDecodeFailed{false};
+    SkOnce                            fEncodedHashOnce;
+    uint64_t                          fEncodedHash = 0;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -143,13 +166,13 @@ bool SkImage_Lazy::getROPixels(GrDirectContext*, SkBitmap* bitmap,
     }
 
     if (SkImage::kAllow_CachingHint == chint) {
-        SkPixmap pmap;
-        SkBitmapCache::RecPtr cacheRec = SkBitmapCache::Alloc(desc, this->imageInfo(), &pmap);
-        if (!cacheRec || !ScopedGenerator(fSharedGenerator)->getPixels(pmap)) {
+        // If another thread is already decoding these pixels, wait for it rather than running
+        // the generator a second time. Otherwise, wait() runs the decode right here.
+        bool created;
+        sk_sp<PendingDecode> pending = this->findOrCreatePendingDecode(desc, &created);
+        if (!pending->wait(bitmap)) {
             return false;
         }
-        SkBitmapCache::Add(std::move(cacheRec), bitmap);
-        this->notifyAddedToRasterCache();
     } else {
         if (!bitmap->tryAllocPixels(this->imageInfo()) ||
             !ScopedGenerator(fSharedGenerator)->getPixels(bitmap->pixmap())) {
@@ -162,6 +185,376 @@ bool SkImage_Lazy::getROPixels(GrDirectContext*, SkBitmap* bitmap,
     return true;
 }
 
+SkISize SkImage_Lazy::scaledDecodeDimensions(float scale) const {
+    const SkISize full = this->dimensions();
+    if (!(scale > 0 && scale < 1)) {
+        return full;
+    }
+    const SkISize needed = {sk_float_ceil2int(full.width()  * scale),
+                            sk_float_ceil2int(full.height() * scale)};
+
+    // Like getInfo(), this is a const query on the generator, safe without the mutex. Generators
+    // round to their nearest native scale, which may fall below what was asked for, so step the
+    // request up until the result covers the draw.
+    const SkImageGenerator* generator = fSharedGenerator->fGenerator.get();
+    for (float s = scale; s < 1; s *= 1.25f) {
+        SkISize dims = generator->getScaledDimensions(s);
+        if (dims.width() >= needed.width() && dims.height() >= needed.height()) {
+            return dims;
+        }
+    }
+    return full;
+}
+
+bool SkImage_Lazy::getScaledROPixels(float scale, SkBitmap* bitmap) const {
+    SkISize dims = this->scaledDecodeDimensions(scale);
+    if (dims == this->dimensions()) {
+        return false;
+    }
+
+    auto desc = SkBitmapCacheDesc::MakeScaled(this->uniqueID(), this->bounds(), dims);
+    if (SkBitmapCache::Find(desc, bitmap)) {
+        return true;
+    }
+    bool created;
+    return this->findOrCreatePendingDecode(desc, &created)->wait(bitmap);
+}
+
+uint64_t SkImage_Lazy::contentHash() const {
+    const uint64_t encoded = fSharedGenerator->encodedHash();
+    if (!encoded) {
+        return 0;
+    }
+    // Images made with a different color type or space share the generator (and so the
+    // encoded data), but decode to different pixels.
+    const SkImageInfo& info = this->imageInfo();
+    const struct {
+        uint32_t fColorType;
+        uint32_t fAlphaType;
+        uint64_t fColorSpace;
+    } decoded = { (uint32_t)info.colorType(), (uint32_t)info.alphaType(),
+                  info.colorSpace() ? info.colorSpace()->hash() : 0 };
+    return SkResourceDiskCache::HashContents(&decoded, sizeof(decoded), encoded);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// Identifies one raster decode: the image's unique ID, the subset it covers and the size it
+// is decoded to.
+struct PendingDecodeKey {
+    SkBitmapCacheDesc fDesc;
+
+    bool operator==(const PendingDecodeKey& that) const {
+        return fDesc.fImageID    == that.fDesc.fImageID &&
+               fDesc.fSubset     == that.fDesc.fSubset  &&
+               fDesc.fDimensions == that.fDesc.fDimensions;
+    }
+};
+
+// Decodes that have been requested but not yet finished, shared by every SkImage_Lazy. The
+// map holds a ref on each entry, so an entry stays valid even if every handle is dropped; it is
+// removed when the decode runs, or when its queued task is dropped unrun.
+SkMutex& pending_decodes_mutex() {
+    static SkMutex& mutex = *(new SkMutex);
+    return mutex;
+}
+
+SkTHashMap<PendingDecodeKey, sk_sp<SkImage_Lazy::PendingDecode>>& pending_decodes() {
+    static auto& decodes =
+            *(new SkTHashMap<PendingDecodeKey, sk_sp<SkImage_Lazy::PendingDecode>>);
+    return decodes;
+}
+
+}  // namespace
+
+bool SkImage_Lazy::PendingDecode::isDone() const {
+    SkAutoMutexExclusive lock(fMutex);
+    return fDone;
+}
+
+bool SkImage_Lazy::PendingDecode::wait(SkBitmap* result) {
+    // Blocking on a decode that is still queued could deadlock, e.g. when waiting from the
+    // executor's only (or last free) thread, so claim it instead.
+    this->runIfUnclaimed();
+
+    fMutex.acquire();
+    if (!fDone) {
+        fWaiters++;
+        fMutex.release();
+        fDoneSemaphore.wait();
+        fMutex.acquire();
+    }
+    SkASSERT(fDone);
+    if (fSuccess && result) {
+        *result = fBitmap;
+    }
+    bool success = fSuccess;
+    fMutex.release();
+    return success;
+}
+
+void SkImage_Lazy::PendingDecode::runIfUnclaimed() {
+    sk_sp<const SkImage_Lazy> image;
+    {
+        SkAutoMutexExclusive lock(fMutex);
+        image = std::move(fImage);
+    }
+    if (image) {
+        image->runPendingDecode(fDesc, this);
+    }
+}
+
+void SkImage_Lazy::PendingDecode::unregister() {
+    sk_sp<PendingDecode> entry;
+    {
+        SkAutoMutexExclusive lock(pending_decodes_mutex());
+        PendingDecodeKey key{fDesc};
+        // A newer decode of the same pixels may have replaced this one.
+        sk_sp<PendingDecode>* existing = pending_decodes().find(key);
+        if (!existing || existing->get() != this) {
+            return;
+        }
+        entry = std::move(*existing);
+        pending_decodes().remove(key);
+    }
+    // Dropped outside the lock: this may be the last ref, and it may hold the image's last ref.
+}
+
+void SkImage_Lazy::PendingDecode::finish(const SkBitmap* bitmap) {
+    int waiters;
+    {
+        SkAutoMutexExclusive lock(fMutex);
+        SkASSERT(!fDone);
+        fDone = true;
+        fSuccess = bitmap != nullptr;
+        if (bitmap) {
+            fBitmap = *bitmap;
+        }
+        waiters = fWaiters;
+        fWaiters = 0;
+    }
+    fDoneSemaphore.signal(waiters);
+}
+
+sk_sp<SkImage_Lazy::PendingDecode> SkImage_Lazy::findOrCreatePendingDecode(
+        const SkBitmapCacheDesc& desc, bool* created) const {
+    PendingDecodeKey key{desc};
+
+    SkAutoMutexExclusive lock(pending_decodes_mutex());
+    if (sk_sp<PendingDecode>* existing = pending_decodes().find(key)) {
+        *created = false;
+        return *existing;
+    }
+    sk_sp<PendingDecode> pending(new PendingDecode(sk_ref_sp(this), desc));
+    pending_decodes().set(key, pending);
+    *created = true;
+    return pending;
+}
+
+void SkImage_Lazy::runPendingDecode(const SkBitmapCacheDesc& desc,
+                                    PendingDecode* pending) const {
+    // A decode that finished just before this one was registered may already have filled the
+    // cache (or an earlier process, the disk cache), so look there before running the generator.
+    SkBitmap bitmap;
+    // Hashing the encoded data isn't free, so only bother when there's a disk cache to key.
+    const uint64_t contentHash = SkResourceCache::GetDiskCache() ? this->contentHash() : 0;
+    bool success = SkBitmapCache::Find(desc, contentHash, &bitmap);
+    if (success) {
+        // The pixels may have just been loaded from the disk cache into memory.
+        this->notifyAddedToRasterCache();
+    } else {
+        SkImageInfo info = this->imageInfo().makeDimensions(desc.fDimensions);
+        SkPixmap pmap;
+        SkBitmapCache::RecPtr cacheRec = SkBitmapCache::Alloc(desc, info, &pmap);
+        auto decode = [&]() {
+            ScopedGenerator generator(fSharedGenerator);
+            if (desc.fSubset == this->bounds()) {
+                return generator->getPixels(pmap);
+            }
+            if (!generator->getSubsetPixels(desc.fSubset, pmap)) {
+                fSharedGenerator->fSubsetDecodeFailed = true;
+                return false;
+            }
+            return true;
+        };
+        if (cacheRec && decode()) {
+            SkBitmapCache::Add(std::move(cacheRec), &bitmap, contentHash);
+            this->notifyAddedToRasterCache();
+            success = true;
+        }
+    }
+
+    // Unregister before waking the waiters; anyone arriving after this finds the pixels in the
+    // cache (or, on failure, starts a fresh attempt).
+    pending->unregister();
+    pending->finish(success ? &bitmap : nullptr);
+}
+
+// Large lazy images are decoded in tiles of this size when a draw only needs part of them.
+static constexpr int kDecodeTileSize = 512;
+// ... but only if they have at least this many pixels; below it, one decode is cheap enough.
+static constexpr int64_t kMinPixelsForTiledDecode = 2048 * 2048;
+
+bool SkImage_Lazy::getTileROPixels(const SkIRect& tile, SkBitmap* bitmap) const {
+    auto desc = SkBitmapCacheDesc::Make(this->uniqueID(), tile);
+    if (SkBitmapCache::Find(desc, bitmap)) {
+        return true;
+    }
+    bool created;
+    return this->findOrCreatePendingDecode(desc, &created)->wait(bitmap);
+}
+
+bool SkImage_Lazy::getSubsetROPixels(const SkIRect& subset, SkBitmap* bitmap,
+                                     SkIPoint* origin) const {
+    const int64_t imagePixels = this->bounds().width64() * this->bounds().height64();
+    SkIRect needed = subset;
+    if (imagePixels < kMinPixelsForTiledDecode || fSharedGenerator->fSubsetDecodeFailed ||
+        !needed.intersect(this->bounds())) {
+        return false;
+    }
+
+    // Snap to the tile grid, and only go tile by tile if that saves decoding most of the image.
+    const SkIRect tiles = SkIRect::MakeLTRB(
+            needed.left() / kDecodeTileSize,
+            needed.top() / kDecodeTileSize,
+            (needed.right()  + kDecodeTileSize - 1) / kDecodeTileSize,
+            (needed.bottom() + kDecodeTileSize - 1) / kDecodeTileSize);
+    SkIRect region = SkIRect::MakeLTRB(tiles.left()   * kDecodeTileSize,
+                                       tiles.top()    * kDecodeTileSize,
+                                       tiles.right()  * kDecodeTileSize,
+                                       tiles.bottom() * kDecodeTileSize);
+    SkAssertResult(region.intersect(this->bounds()));
+    if (region.width64() * region.height64() * 2 > imagePixels) {
+        return false;
+    }
+
+    // If the whole image is already decoded, that's cheaper still.
+    SkBitmap full;
+    if (SkBitmapCache::Find(SkBitmapCacheDesc::Make(this), &full)) {
+        return false;
+    }
+
+    auto tile_rect = [this](int x, int y) {
+        SkIRect tile = SkIRect::MakeXYWH(x * kDecodeTileSize, y * kDecodeTileSize,
+                                         kDecodeTileSize, kDecodeTileSize);
+        SkAssertResult(tile.intersect(this->bounds()));
+        return tile;
+    };
+
+    if (tiles.width() == 1 && tiles.height() == 1) {
+        if (!this->getTileROPixels(region, bitmap)) {
+            return false;
+        }
+        *origin = region.topLeft();
+        return true;
+    }
+
+    // Spanning several tiles: copy in the cached ones, and decode the rest a row of tiles at a
+    // time. The stitched pixels are cached under the region's own subset key, so redrawing the
+    // same area neither stitches nor copies again.
+    const auto regionDesc = SkBitmapCacheDesc::Make(this->uniqueID(), region);
+    if (!SkBitmapCache::Find(regionDesc, bitmap)) {
+        SkPixmap pmap;
+        SkBitmapCache::RecPtr cacheRec = SkBitmapCache::Alloc(
+                regionDesc, this->imageInfo().makeDimensions(region.size()), &pmap);
+        if (!cacheRec) {
+            return false;
+        }
+        auto region_pixels = [&](const SkIRect& rect, SkPixmap* dst) {
+            return pmap.extractSubset(dst, rect.makeOffset(-region.left(), -region.top()));
+        };
+
+        for (int y = tiles.top(); y < tiles.bottom(); ++y) {
+            int firstMissing = tiles.right(),
+                lastMissing  = tiles.left() - 1;
+            for (int x = tiles.left(); x < tiles.right(); ++x) {
+                SkIRect tile = tile_rect(x, y);
+                SkBitmap tileBitmap;
+                SkPixmap dst;
+                if (!SkBitmapCache::Find(SkBitmapCacheDesc::Make(this->uniqueID(), tile),
+                                         &tileBitmap)) {
+                    firstMissing = std::min(firstMissing, x);
+                    lastMissing  = x;
+                } else if (!region_pixels(tile, &dst) || !tileBitmap.readPixels(dst)) {
+                    return false;
+                }
+            }
+            if (firstMissing > lastMissing) {
+                continue;
+            }
+
+            // Generators without native region support decode whole rows for any subset, so
+            // decoding the missing tiles one by one would decode those rows once per tile.
+            // Decode them as one band instead, then cache each tile for later, smaller draws.
+            SkIRect band = tile_rect(firstMissing, y);
+            band.join(tile_rect(lastMissing, y));
+            SkPixmap bandPixels;
+            if (!region_pixels(band, &bandPixels)) {
+                return false;
+            }
+            {
+                ScopedGenerator generator(fSharedGenerator);
+                if (!generator->getSubsetPixels(band, bandPixels)) {
+                    fSharedGenerator->fSubsetDecodeFailed = true;
+                    return false;
+                }
+            }
+            for (int x = firstMissing; x <= lastMissing; ++x) {
+                SkIRect tile = tile_rect(x, y);
+                SkPixmap src, tilePixels;
+                SkBitmapCache::RecPtr tileRec = SkBitmapCache::Alloc(
+                        SkBitmapCacheDesc::Make(this->uniqueID(), tile),
+                        this->imageInfo().makeDimensions(tile.size()), &tilePixels);
+                if (tileRec && region_pixels(tile, &src) && src.readPixels(tilePixels)) {
+                    SkBitmap tileBitmap;
+                    SkBitmapCache::Add(std::move(tileRec), &tileBitmap);
+                }
+            }
+        }
+        SkBitmapCache::Add(std::move(cacheRec), bitmap);
+        this->notifyAddedToRasterCache();
+    }
+    *origin = region.topLeft();
+    return true;
+}
+
+sk_sp<SkImage_Lazy::PendingDecode> SkImage_Lazy::decodeAsync(SkExecutor* executor) const {
+    auto desc = SkBitmapCacheDesc::Make(this);
+    SkBitmap bitmap;
+    if (SkBitmapCache::Find(desc, &bitmap)) {
+        sk_sp<PendingDecode> done(new PendingDecode);
+        done->finish(&bitmap);
+        return done;
+    }
+
+    bool created;
+    sk_sp<PendingDecode> pending = this->findOrCreatePendingDecode(desc, &created);
+    if (created) {
+        SkExecutor& exec = executor ? *executor : SkExecutor::GetDefault();
+        // Executors may destroy queued tasks without running them. Every copy of the task
+        // shares this ref, and unregisters the decode when the last one goes away, so a dropped
+        // task doesn't leave later requests waiting on a decode that will never run. (Handles
+        // still run it themselves from wait().)
+        std::shared_ptr<PendingDecode> task(SkRef(pending.get()), [](PendingDecode* p) {
+            p->unregister();
+            p->unref();
+        });
+        exec.add([task] { task->runIfUnclaimed(); });
+    }
+    return pending;
+}
+
+void SkImage_Lazy::DecodeAhead(const sk_sp<SkImage> images[], int count, SkExecutor* executor) {
+    for (int i = 0; i < count; ++i) {
+        const SkImage* image = images[i].get();
+        if (image && image->isLazyGenerated()) {
+            static_cast<const SkImage_Lazy*>(image)->decodeAsync(executor);
+        }
+    }
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////////////
 
 bool SkImage_Lazy::onReadPixels(GrDirectContext* dContext,
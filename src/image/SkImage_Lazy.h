@@ -8,8 +8,11 @@
 #ifndef SkImage_Lazy_DEFINED
 #define SkImage_Lazy_DEFINED
 
+#include "include/core/SkBitmap.h"
 #include "include/private/SkIDChangeListener.h"
 #include "include/private/SkMutex.h"
+#include "include/private/SkSemaphore.h"
+#include "src/core/SkBitmapCache.h"
 #include "src/image/SkImage_Base.h"
 
 #if SK_SUPPORT_GPU
@@ -18,6 +21,7 @@
 #endif
 
 class SharedGenerator;
+class SkExecutor;
 
 class SkImage_Lazy : public SkImage_Base {
 public:
@@ -34,6 +38,55 @@ public:
 
     SkImage_Lazy(Validator* validator);
 
+    // Handle on a raster decode started by decodeAsync(). All requests for the same image
+    // (unique ID, subset and decoded size) that arrive while a decode is in flight share one
+    // handle, so the generator only runs once and every caller waits on that single decode.
+    // Scaled decodes (getScaledROPixels) are coalesced the same way, per decoded size.
+    class PendingDecode : public SkNVRefCnt<PendingDecode> {
+    public:
+        bool isDone() const;
+
+        // Blocks until the decode has finished. If no thread has started it yet (e.g. it is
+        // still queued on a busy or single-threaded executor), runs it on the calling thread
+        // instead. On success, returns true and, if result is non-null, sets it to the decoded
+        // (immutable, cached) pixels.
+        bool wait(SkBitmap* result = nullptr);
+
+    private:
+        friend class SkImage_Lazy;
+
+        PendingDecode() = default;
+        PendingDecode(sk_sp<const SkImage_Lazy> image, const SkBitmapCacheDesc& desc)
+            : fDesc(desc), fImage(std::move(image)) {}
+
+        // Runs the decode, unless another thread has already claimed it.
+        void runIfUnclaimed();
+        // Removes this decode from the registry of in-flight decodes, if it is still there.
+        void unregister();
+        void finish(const SkBitmap*);
+
+        const SkBitmapCacheDesc   fDesc = {};
+        mutable SkMutex           fMutex;
+        SkSemaphore               fDoneSemaphore;
+        // Set until some thread claims the decode.
+        sk_sp<const SkImage_Lazy> fImage   SK_GUARDED_BY(fMutex);
+        int                       fWaiters SK_GUARDED_BY(fMutex) = 0;
+        bool                      fDone    SK_GUARDED_BY(fMutex) = false;
+        bool                      fSuccess SK_GUARDED_BY(fMutex) = false;
+        SkBitmap                  fBitmap  SK_GUARDED_BY(fMutex);
+    };
+
+    // Starts decoding this image into the SkResourceCache on executor (the default executor if
+    // null) and returns immediately. If a decode of the same pixels is already in flight, its
+    // handle is returned instead of starting another one. Dropping the handle without waiting
+    // is fine: the decode still completes and lands in the cache for a later draw.
+    sk_sp<PendingDecode> decodeAsync(SkExecutor* executor = nullptr) const;
+
+    // Decode-ahead: queues decodeAsync() for every lazy image in the array, skipping images that
+    // are not lazily generated or whose pixels are already cached or being decoded.
+    static void DecodeAhead(const sk_sp<SkImage> images[], int count,
+                            SkExecutor* executor = nullptr);
+
     bool onHasMipmaps() const override {
         // TODO: Should we defer to the generator? The generator interface currently doesn't have
         // a way to provide content for levels other than via SkImageGenerator::generateTexture().
@@ -45,6 +98,9 @@ public:
     sk_sp<SkData> onRefEncoded() const override;
     sk_sp<SkImage> onMakeSubset(const SkIRect&, GrDirectContext*) const override;
     bool getROPixels(GrDirectContext*, SkBitmap*, CachingHint) const override;
+    bool getScaledROPixels(float scale, SkBitmap*) const override;
+    bool getSubsetROPixels(const SkIRect& subset, SkBitmap*, SkIPoint* origin) const override;
+    uint64_t contentHash() const override;
     bool onIsLazyGenerated() const override { return true; }
     sk_sp<SkImage> onMakeColorTypeAndColorSpace(SkColorType, sk_sp<SkColorSpace>,
                                                 GrDirectContext*) const override;
@@ -68,6 +124,23 @@ public:
 
 private:
     void addUniqueIDListener(sk_sp<SkIDChangeListener>) const;
+
+    // Returns the smallest size, no smaller than scale times this image's dimensions, that the
+    // generator can decode to directly. Returns this->dimensions() if it cannot do better.
+    SkISize scaledDecodeDimensions(float scale) const;
+
+    // Finds or decodes the pixels of one tile (see getSubsetROPixels), coalescing with any
+    // in-flight decode of the same tile.
+    bool getTileROPixels(const SkIRect& tile, SkBitmap*) const;
+
+    // Returns the in-flight decode of the pixels described by desc, creating and registering one
+    // if there is none (*created is then set to true). It runs on whichever thread claims it
+    // first: the one it was queued on, or one waiting for it.
+    sk_sp<PendingDecode> findOrCreatePendingDecode(const SkBitmapCacheDesc& desc,
+                                                   bool* created) const;
+    // Runs the generator into the SkBitmapCache at desc.fDimensions (for desc.fSubset alone, if
+    // that is not the whole image) and completes (and unregisters) pending.
+    void runPendingDecode(const SkBitmapCacheDesc& desc, PendingDecode* pending) const;
 #if SK_SUPPORT_GPU
     std::tuple<GrSurfaceProxyView, GrColorType> onAsView(GrRecordingContext*,
                                                          GrMipmapped,
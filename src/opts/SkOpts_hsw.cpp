@@ -34,6 +34,15 @@ namespace SkOpts {
         inverted_CMYK_to_RGB1 = SK_OPTS_NS::inverted_CMYK_to_RGB1;
         inverted_CMYK_to_BGR1 = SK_OPTS_NS::inverted_CMYK_to_BGR1;
 
+        RGB_565_to_RGB1      = SK_OPTS_NS::RGB_565_to_RGB1;
+        RGB_565_to_BGR1      = SK_OPTS_NS::RGB_565_to_BGR1;
+        RGBA_1010102_to_RGBA = SK_OPTS_NS::RGBA_1010102_to_RGBA;
+        RGBA_1010102_to_BGRA = SK_OPTS_NS::RGBA_1010102_to_BGRA;
+        RGBA_F16_to_RGBA     = SK_OPTS_NS::RGBA_F16_to_RGBA;
+        RGBA_F16_to_BGRA     = SK_OPTS_NS::RGBA_F16_to_BGRA;
+        rgbA_F16_to_rgbA     = SK_OPTS_NS::rgbA_F16_to_rgbA;
+        rgbA_F16_to_bgrA     = SK_OPTS_NS::rgbA_F16_to_bgrA;
+
     #define M(st) stages_highp[SkRasterPipeline::st] = (StageFn)SK_OPTS_NS::st;
         SK_RASTER_PIPELINE_STAGES(M)
         just_return_highp = (StageFn)SK_OPTS_NS::just_return;
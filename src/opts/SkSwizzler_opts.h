@@ -1384,6 +1384,147 @@ static void RGB_to_BGR1_portable(uint32_t dst[], const uint8_t* src, int count)
     }
 #endif
 
+// The kernels below convert other pixel formats into 8888 with no change of color space or
+// alpha type.  They're written with SkVx, so each SK_OPTS_NS gets its own instruction set.
+// Their output matches the SkRasterPipeline that SkConvertPixels() would otherwise run, bit for
+// bit: that's the lowp pipeline for 565 and the highp (float) pipeline for the others.
+template <int N>
+static skvx::Vec<N,uint32_t> pack_8888(bool kSwapRB, const skvx::Vec<N,uint32_t>& r,
+                                                     const skvx::Vec<N,uint32_t>& g,
+                                                     const skvx::Vec<N,uint32_t>& b,
+                                                     const skvx::Vec<N,uint32_t>& a) {
+    return (kSwapRB ? b : r) << 0
+         | g << 8
+         | (kSwapRB ? r : b) << 16
+         | a << 24;
+}
+
+// RGB_565 has r in the top bits.  We expand each channel by bit replication like lowp does.
+// (The highp pipeline rounds x*255/31 instead, which can differ by one.)
+template <int N>
+static void RGB_565_to_8888_n(bool kSwapRB, uint32_t dst[], const uint16_t* src) {
+    using U16 = skvx::Vec<N,uint16_t>;
+    using U32 = skvx::Vec<N,uint32_t>;
+
+    U16 px = U16::Load(src),
+        r  = (px >> 11),
+        g  = (px >>  5) & 63,
+        b  = (px >>  0) & 31;
+    r = (r << 3) | (r >> 2);
+    g = (g << 2) | (g >> 4);
+    b = (b << 3) | (b >> 2);
+
+    pack_8888(kSwapRB, skvx::cast<uint32_t>(r),
+                       skvx::cast<uint32_t>(g),
+                       skvx::cast<uint32_t>(b), U32(0xff)).store(dst);
+}
+
+static void RGB_565_to_8888(bool kSwapRB, uint32_t dst[], const uint16_t* src, int count) {
+    while (count >= 16) {
+        RGB_565_to_8888_n<16>(kSwapRB, dst, src);
+        dst += 16; src += 16; count -= 16;
+    }
+    while (count --> 0) {
+        RGB_565_to_8888_n<1>(kSwapRB, dst++, src++);
+    }
+}
+
+/*not static*/ inline void RGB_565_to_RGB1(uint32_t dst[], const uint16_t* src, int count) {
+    RGB_565_to_8888(false, dst, src, count);
+}
+/*not static*/ inline void RGB_565_to_BGR1(uint32_t dst[], const uint16_t* src, int count) {
+    RGB_565_to_8888(true, dst, src, count);
+}
+
+template <int N>
+static void RGBA_1010102_to_8888_n(bool kSwapRB, uint32_t dst[], const uint32_t* src) {
+    using U32 = skvx::Vec<N,uint32_t>;
+
+    // v*255/1023 is never within 1/2046 of a tie, so this rounds the same way the pipeline's
+    // round-to-nearest-even does.
+    auto to_8888 = [](const U32& v) {
+        return skvx::cast<uint32_t>(skvx::cast<int32_t>(skvx::cast<float>(v) * (255/1023.0f)
+                                                        + 0.5f));
+    };
+
+    U32 px = U32::Load(src);
+    pack_8888(kSwapRB, to_8888((px >>  0) & 0x3ff),
+                       to_8888((px >> 10) & 0x3ff),
+                       to_8888((px >> 20) & 0x3ff),
+                       (px >> 30) * 85).store(dst);
+}
+
+static void RGBA_1010102_to_8888(bool kSwapRB, uint32_t dst[], const uint32_t* src, int count) {
+    while (count >= 8) {
+        RGBA_1010102_to_8888_n<8>(kSwapRB, dst, src);
+        dst += 8; src += 8; count -= 8;
+    }
+    while (count --> 0) {
+        RGBA_1010102_to_8888_n<1>(kSwapRB, dst++, src++);
+    }
+}
+
+/*not static*/ inline void RGBA_1010102_to_RGBA(uint32_t dst[], const uint32_t* src, int count) {
+    RGBA_1010102_to_8888(false, dst, src, count);
+}
+/*not static*/ inline void RGBA_1010102_to_BGRA(uint32_t dst[], const uint32_t* src, int count) {
+    RGBA_1010102_to_8888(true, dst, src, count);
+}
+
+// F16 values are clamped to [0,1], and when premultiplied, color to [0,a], like clamp_gamut.
+template <int N>
+static void RGBA_F16_to_8888_n(bool kSwapRB, bool kPremul, uint32_t dst[], const uint64_t* src) {
+    using U64 = skvx::Vec<N,uint64_t>;
+    using F   = skvx::Vec<N,float>;
+
+    U64 px = U64::Load(src);
+    auto channel = [&](int shift) {
+        F v = skvx::from_half(skvx::cast<uint16_t>(px >> shift));
+        // Written as max(0,v) so that NaN becomes 0.
+        return skvx::min(skvx::max(0.0f, v), 1.0f);
+    };
+    F r = channel( 0),
+      g = channel(16),
+      b = channel(32),
+      a = channel(48);
+    if (kPremul) {
+        r = skvx::min(r, a);
+        g = skvx::min(g, a);
+        b = skvx::min(b, a);
+    }
+
+    // A half times 255 is exact in float, and the only tie in [0,1] is 0.5 -> 127.5, which
+    // rounds to 128 here just as it does to even in the pipeline.
+    auto to_8888 = [](const F& v) {
+        return skvx::cast<uint32_t>(skvx::cast<int32_t>(v * 255.0f + 0.5f));
+    };
+    pack_8888(kSwapRB, to_8888(r), to_8888(g), to_8888(b), to_8888(a)).store(dst);
+}
+
+static void RGBA_F16_to_8888(bool kSwapRB, bool kPremul,
+                             uint32_t dst[], const uint64_t* src, int count) {
+    while (count >= 8) {
+        RGBA_F16_to_8888_n<8>(kSwapRB, kPremul, dst, src);
+        dst += 8; src += 8; count -= 8;
+    }
+    while (count --> 0) {
+        RGBA_F16_to_8888_n<1>(kSwapRB, kPremul, dst++, src++);
+    }
+}
+
+/*not static*/ inline void RGBA_F16_to_RGBA(uint32_t dst[], const uint64_t* src, int count) {
+    RGBA_F16_to_8888(false, false, dst, src, count);
+}
+/*not static*/ inline void RGBA_F16_to_BGRA(uint32_t dst[], const uint64_t* src, int count) {
+    RGBA_F16_to_8888(true, false, dst, src, count);
+}
+/*not static*/ inline void rgbA_F16_to_rgbA(uint32_t dst[], const uint64_t* src, int count) {
+    RGBA_F16_to_8888(false, true, dst, src, count);
+}
+/*not static*/ inline void rgbA_F16_to_bgrA(uint32_t dst[], const uint64_t* src, int count) {
+    RGBA_F16_to_8888(true, true, dst, src, count);
+}
+
 }  // namespace SK_OPTS_NS
 
 #endif // SkSwizzler_opts_DEFINED
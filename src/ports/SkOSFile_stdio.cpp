@@ -11,6 +11,7 @@
 #include <errno.h>
 #include <stdio.h>
 #include <sys/stat.h>
+#include <time.h>
 
 #ifdef SK_BUILD_FOR_UNIX
 #include <unistd.h>
@@ -170,6 +171,15 @@ bool sk_isdir(const char *path) {
     return SkToBool(status.st_mode & S_IFDIR);
 }
 
+bool sk_file_age(const char* path, double* seconds) {
+    struct stat status;
+    if (0 != stat(path, &status)) {
+        return false;
+    }
+    *seconds = difftime(time(nullptr), status.st_mtime);
+    return true;
+}
+
 bool sk_mkdir(const char* path) {
     if (sk_isdir(path)) {
         return true;
@@ -10,6 +10,7 @@
 #include <memory>
 #include <unordered_set>
 
+#include "include/private/SkMutex.h"
 #include "src/core/SkScopeExit.h"
 #include "src/core/SkTraceEvent.h"
 #include "src/sksl/SkSLAnalysis.h"
@@ -102,8 +103,128 @@ public:
     Context* fContext;
 };
 
-Compiler::Compiler(const ShaderCapsClass* caps)
-        : fContext(std::make_shared<Context>(/*errors=*/*this, *caps))
+#if !defined(SKSL_STANDALONE)
+
+/**
+ * Holds the built-in modules that were rehydrated for one set of module-relevant caps. The modules
+ * are loaded (lazily, under fMutex) by a private Compiler, and are never modified afterwards, so
+ * any number of Compilers whose caps produce the same key can read them concurrently. Caches live
+ * for the lifetime of the process, so Programs never outlive the modules they point into.
+ */
+class ModuleCache {
+public:
+    static ModuleCache* Find(const ShaderCapsClass& caps) {
+        static SkMutex& sMutex = *(new SkMutex);
+        static auto& sCaches = *(new std::unordered_map<uint32_t, std::unique_ptr<ModuleCache>>);
+
+        uint32_t key = CapsKey(caps);
+        SkAutoMutexExclusive lock(sMutex);
+        std::unique_ptr<ModuleCache>& cache = sCaches[key];
+        if (!cache) {
+            cache.reset(new ModuleCache(caps));
+        }
+        return cache.get();
+    }
+
+    std::shared_ptr<const BuiltinTypes> types() const {
+        return fCompiler->fContext->fSharedTypes;
+    }
+
+    const ParsedModule& moduleForProgramKind(ProgramKind kind) {
+        SkAutoMutexExclusive lock(fMutex);
+        return fCompiler->moduleForProgramKind(kind);
+    }
+
+private:
+    // Rehydration bakes the value of every sk_Caps setting into the modules, so these are exactly
+    // the caps that are exposed through sk_Caps (see SkSLSetting.cpp).
+    static uint32_t CapsKey(const ShaderCapsClass& caps) {
+        const bool bits[] = {
+            caps.fbFetchSupport(),
+            caps.fbFetchNeedsCustomOutput(),
+            caps.flatInterpolationSupport(),
+            caps.noperspectiveInterpolationSupport(),
+            caps.externalTextureSupport(),
+            caps.mustEnableAdvBlendEqs(),
+            caps.mustDeclareFragmentShaderOutput(),
+            caps.mustDoOpBetweenFloorAndAbs(),
+            caps.mustGuardDivisionEvenAfterExplicitZeroCheck(),
+            caps.inBlendModesFailRandomlyForAllZeroVec(),
+            caps.atan2ImplementedAsAtanYOverX(),
+            caps.canUseAnyFunctionInShader(),
+            caps.floatIs32Bits(),
+            caps.integerSupport(),
+            caps.builtinFMASupport(),
+            caps.builtinDeterminantSupport(),
+        };
+        uint32_t key = 0;
+        for (size_t i = 0; i < SK_ARRAY_COUNT(bits); ++i) {
+            key |= (uint32_t)bits[i] << i;
+        }
+        return key;
+    }
+
+    explicit ModuleCache(const ShaderCapsClass& caps) {
+        // The caller's caps may not outlive us, so the module compiler gets its own copy of the
+        // values that affect the modules.
+#if SK_SUPPORT_GPU
+        fCaps = ShaderCapsFactory::Standalone();
+        fCaps->fGLSLGeneration = caps.fGLSLGeneration;
+        fCaps->fAdvBlendEqInteraction = caps.fAdvBlendEqInteraction;
+        fCaps->fFBFetchSupport = caps.fFBFetchSupport;
+        fCaps->fFBFetchNeedsCustomOutput = caps.fFBFetchNeedsCustomOutput;
+        fCaps->fFlatInterpolationSupport = caps.fFlatInterpolationSupport;
+        fCaps->fNoPerspectiveInterpolationSupport = caps.fNoPerspectiveInterpolationSupport;
+        fCaps->fExternalTextureSupport = caps.fExternalTextureSupport;
+        fCaps->fMustDoOpBetweenFloorAndAbs = caps.fMustDoOpBetweenFloorAndAbs;
+        fCaps->fMustGuardDivisionEvenAfterExplicitZeroCheck =
+                caps.fMustGuardDivisionEvenAfterExplicitZeroCheck;
+        fCaps->fInBlendModesFailRandomlyForAllZeroVec = caps.fInBlendModesFailRandomlyForAllZeroVec;
+        fCaps->fAtan2ImplementedAsAtanYOverX = caps.fAtan2ImplementedAsAtanYOverX;
+        fCaps->fCanUseAnyFunctionInShader = caps.fCanUseAnyFunctionInShader;
+        fCaps->fFloatIs32Bits = caps.fFloatIs32Bits;
+        fCaps->fIntegerSupport = caps.fIntegerSupport;
+        fCaps->fBuiltinFMASupport = caps.fBuiltinFMASupport;
+        fCaps->fBuiltinDeterminantSupport = caps.fBuiltinDeterminantSupport;
+#else
+        fCaps = std::make_shared<StandaloneShaderCaps>(caps);
+#endif
+        SkASSERT(CapsKey(*fCaps) == CapsKey(caps));
+        fCompiler = std::make_unique<Compiler>(fCaps.get(), Compiler::ModuleSharing::kPrivate);
+    }
+
+    ShaderCapsPointer         fCaps;
+    std::unique_ptr<Compiler> fCompiler;
+    SkMutex                   fMutex;
+};
+
+#endif  // !defined(SKSL_STANDALONE)
+
+static ModuleCache* find_module_cache(const ShaderCapsClass* caps,
+                                      Compiler::ModuleSharing sharing) {
+#if defined(SKSL_STANDALONE)
+    // skslc parses the modules from source with its own caps, so it never shares them.
+    return nullptr;
+#else
+    return sharing == Compiler::ModuleSharing::kShared ? ModuleCache::Find(*caps) : nullptr;
+#endif
+}
+
+static std::shared_ptr<const BuiltinTypes> shared_types(ModuleCache* moduleCache) {
+#if defined(SKSL_STANDALONE)
+    SkASSERT(!moduleCache);
+    return nullptr;
+#else
+    return moduleCache ? moduleCache->types() : nullptr;
+#endif
+}
+
+Compiler::Compiler(const ShaderCapsClass* caps, ModuleSharing sharing)
+        : Compiler(caps, find_module_cache(caps, sharing)) {}
+
+Compiler::Compiler(const ShaderCapsClass* caps, ModuleCache* moduleCache)
+        : fContext(std::make_shared<Context>(/*errors=*/*this, *caps, shared_types(moduleCache)))
+        , fModuleCache(moduleCache)
         , fInliner(fContext.get())
         , fErrorCount(0) {
     SkASSERT(caps);
@@ -258,6 +379,11 @@ const ParsedModule& Compiler::loadRuntimeEffectModule() {
 }
 
 const ParsedModule& Compiler::moduleForProgramKind(ProgramKind kind) {
+#if !defined(SKSL_STANDALONE)
+    if (fModuleCache) {
+        return fModuleCache->moduleForProgramKind(kind);
+    }
+#endif
     switch (kind) {
         case ProgramKind::kVertex:            return this->loadVertexModule();        break;
         case ProgramKind::kFragment:          return this->loadFragmentModule();      break;
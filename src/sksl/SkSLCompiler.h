@@ -52,6 +52,7 @@ class ExternalFunction;
 class FunctionDeclaration;
 class IRGenerator;
 class IRIntrinsicMap;
+class ModuleCache;
 class ProgramUsage;
 
 struct LoadedModule {
@@ -91,7 +92,17 @@ public:
         StatementArray fOwnedStatements;
     };
 
-    Compiler(const ShaderCapsClass* caps);
+    /**
+     * By default, the built-in modules (sksl_gpu, sksl_frag, sksl_public, ...) are rehydrated once
+     * per distinct set of caps that they depend on, and shared read-only by every Compiler in the
+     * process. kPrivate gives this Compiler its own copy of the modules instead.
+     */
+    enum class ModuleSharing {
+        kShared,
+        kPrivate,
+    };
+
+    Compiler(const ShaderCapsClass* caps, ModuleSharing sharing = ModuleSharing::kShared);
 
     ~Compiler() override;
 
@@ -171,6 +182,8 @@ public:
     const ParsedModule& moduleForProgramKind(ProgramKind kind);
 
 private:
+    Compiler(const ShaderCapsClass* caps, ModuleCache* moduleCache);
+
     const ParsedModule& loadGPUModule();
     const ParsedModule& loadFragmentModule();
     const ParsedModule& loadVertexModule();
@@ -219,6 +232,10 @@ private:
 
     std::shared_ptr<Context> fContext;
 
+    // If set, the built-in modules come from this (shared) cache, and the module members below
+    // are never loaded.
+    ModuleCache* fModuleCache;
+
     std::shared_ptr<SymbolTable> fRootSymbolTable;
     std::shared_ptr<SymbolTable> fPrivateSymbolTable;
 
@@ -246,6 +263,7 @@ private:
     std::vector<size_t> fErrorTextLength;
 
     friend class AutoSource;
+    friend class ModuleCache;
     friend class ::SkSLCompileBench;
     friend class dsl::DSLWriter;
 };
@@ -35,8 +35,11 @@ public:
     using INHERITED = Expression;
 };
 
-Context::Context(ErrorReporter& errors, const ShaderCapsClass& caps)
-        : fErrors(errors)
+Context::Context(ErrorReporter& errors, const ShaderCapsClass& caps,
+                 std::shared_ptr<const BuiltinTypes> types)
+        : fSharedTypes(types ? std::move(types) : std::make_shared<const BuiltinTypes>())
+        , fTypes(*fSharedTypes)
+        , fErrors(errors)
         , fCaps(caps)
         , fDefined_Expression(std::make_unique<DefinedExpression>(fTypes.fInvalid.get())) {}
 
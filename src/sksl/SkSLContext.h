@@ -25,10 +25,16 @@ struct ProgramConfig;
  */
 class Context {
 public:
-    Context(ErrorReporter& errors, const ShaderCapsClass& caps);
+    // If 'types' is null, the Context creates its own set of built-in types.
+    Context(ErrorReporter& errors, const ShaderCapsClass& caps,
+            std::shared_ptr<const BuiltinTypes> types = nullptr);
+
+    // The built-in types are immutable once created, so Contexts whose programs share built-in
+    // modules also share the types those modules were built with.
+    const std::shared_ptr<const BuiltinTypes> fSharedTypes;
 
     // The Context holds all of the built-in types.
-    BuiltinTypes fTypes;
+    const BuiltinTypes& fTypes;
 
     // The Context holds a reference to our error reporter.
     ErrorReporter& fErrors;
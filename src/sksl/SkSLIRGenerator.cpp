@@ -84,10 +84,21 @@ IRGenerator::IRGenerator(const Context* context)
         , fModifiers(new ModifiersPool()) {}
 
 void IRGenerator::pushSymbolTable() {
-    auto childSymTable = std::make_shared<SymbolTable>(std::move(fSymbolTable), fIsBuiltinCode);
+    // Report errors to our own Context, even when the parent is a built-in module table that was
+    // created by (and is shared with) another compiler.
+    auto childSymTable = std::make_shared<SymbolTable>(std::move(fSymbolTable),
+                                                       &this->errorReporter(), fIsBuiltinCode);
     fSymbolTable = std::move(childSymTable);
 }
 
+const ProgramElement* IRGenerator::findAndIncludeIntrinsic(const String& key) {
+    const ProgramElement* intrinsic = fIntrinsics->find(key);
+    if (!intrinsic || !fIncludedIntrinsics.insert(intrinsic).second) {
+        return nullptr;
+    }
+    return intrinsic;
+}
+
 void IRGenerator::popSymbolTable() {
     fSymbolTable = fSymbolTable->fParent;
 }
@@ -1208,6 +1219,14 @@ void IRGenerator::convertFunction(const ASTNode& f) {
                                 f.fOffset, "duplicate definition of " + other->description());
                         return;
                     }
+                    // Built-in declarations live in modules that are shared between compilers,
+                    // so user code may not attach a definition to them.
+                    if (other->isBuiltin() && !fIsBuiltinCode && iter != f.end()) {
+                        this->errorReporter().error(
+                                f.fOffset, "duplicate definition of built-in function " +
+                                           other->description());
+                        return;
+                    }
                     break;
                 }
             }
@@ -1654,7 +1673,7 @@ std::unique_ptr<Expression> IRGenerator::convertTernaryExpression(const ASTNode&
 }
 
 void IRGenerator::copyIntrinsicIfNeeded(const FunctionDeclaration& function) {
-    if (const ProgramElement* found = fIntrinsics->findAndInclude(function.description())) {
+    if (const ProgramElement* found = this->findAndIncludeIntrinsic(function.description())) {
         const FunctionDefinition& original = found->as<FunctionDefinition>();
 
         // Sort the referenced intrinsics into a consistent order; otherwise our output will become
@@ -1960,7 +1979,7 @@ std::unique_ptr<Expression> IRGenerator::convertTypeField(int offset, const Type
     }
     // ... and if that fails, check the intrinsics, add it to our shared elements
     if (!enumElement && !fIsBuiltinCode && fIntrinsics) {
-        if (const ProgramElement* found = fIntrinsics->findAndInclude(type.name())) {
+        if (const ProgramElement* found = this->findAndIncludeIntrinsic(type.name())) {
             fSharedElements->push_back(found);
             enumElement = found;
         }
@@ -2146,9 +2165,9 @@ void IRGenerator::findAndDeclareBuiltinVariables() {
         BuiltinVariableScanner(IRGenerator* generator) : fGenerator(generator) {}
 
         void addDeclaringElement(const String& name) {
-            // If this is the *first* time we've seen this builtin, findAndInclude will return
+            // If this is the *first* time we've seen this builtin, findAndIncludeIntrinsic will return
             // the corresponding ProgramElement.
-            if (const ProgramElement* decl = fGenerator->fIntrinsics->findAndInclude(name)) {
+            if (const ProgramElement* decl = fGenerator->findAndIncludeIntrinsic(name)) {
                 SkASSERT(decl->is<GlobalVarDeclaration>() || decl->is<InterfaceBlock>());
                 fNewElements.push_back(decl);
             }
@@ -2215,9 +2234,7 @@ IRGenerator::IRBundle IRGenerator::convertProgram(
         const std::vector<std::unique_ptr<ExternalFunction>>* externalFunctions) {
     fSymbolTable = base.fSymbols;
     fIntrinsics = base.fIntrinsics.get();
-    if (fIntrinsics) {
-        fIntrinsics->resetAlreadyIncluded();
-    }
+    fIncludedIntrinsics.clear();
     fIsBuiltinCode = isBuiltinCode;
 
     std::vector<std::unique_ptr<ProgramElement>> elements;
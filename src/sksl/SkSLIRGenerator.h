@@ -48,55 +48,30 @@ struct ParsedModule;
 struct Swizzle;
 
 /**
- * Intrinsics are passed between the Compiler and the IRGenerator using IRIntrinsicMaps.
+ * Intrinsics are passed between the Compiler and the IRGenerator using IRIntrinsicMaps. Once built,
+ * a map is never modified, so maps belonging to shared built-in modules can be read by several
+ * IRGenerators at once. Each IRGenerator tracks which intrinsics its current program has included.
  */
 class IRIntrinsicMap {
 public:
-    IRIntrinsicMap(IRIntrinsicMap* parent) : fParent(parent) {}
+    IRIntrinsicMap(const IRIntrinsicMap* parent) : fParent(parent) {}
 
     void insertOrDie(String key, std::unique_ptr<ProgramElement> element) {
         SkASSERT(fIntrinsics.find(key) == fIntrinsics.end());
-        fIntrinsics[key] = Intrinsic{std::move(element), false};
+        fIntrinsics[key] = std::move(element);
     }
 
-    const ProgramElement* find(const String& key) {
+    const ProgramElement* find(const String& key) const {
         auto iter = fIntrinsics.find(key);
         if (iter == fIntrinsics.end()) {
             return fParent ? fParent->find(key) : nullptr;
         }
-        return iter->second.fIntrinsic.get();
-    }
-
-    // Only returns an intrinsic that isn't already marked as included, and then marks it.
-    const ProgramElement* findAndInclude(const String& key) {
-        auto iter = fIntrinsics.find(key);
-        if (iter == fIntrinsics.end()) {
-            return fParent ? fParent->findAndInclude(key) : nullptr;
-        }
-        if (iter->second.fAlreadyIncluded) {
-            return nullptr;
-        }
-        iter->second.fAlreadyIncluded = true;
-        return iter->second.fIntrinsic.get();
-    }
-
-    void resetAlreadyIncluded() {
-        for (auto& pair : fIntrinsics) {
-            pair.second.fAlreadyIncluded = false;
-        }
-        if (fParent) {
-            fParent->resetAlreadyIncluded();
-        }
+        return iter->second.get();
     }
 
 private:
-    struct Intrinsic {
-        std::unique_ptr<ProgramElement> fIntrinsic;
-        bool fAlreadyIncluded = false;
-    };
-
-    std::unordered_map<String, Intrinsic> fIntrinsics;
-    IRIntrinsicMap* fParent = nullptr;
+    std::unordered_map<String, std::unique_ptr<ProgramElement>> fIntrinsics;
+    const IRIntrinsicMap* fParent = nullptr;
 };
 
 /**
@@ -237,6 +212,9 @@ private:
     bool typeContainsPrivateFields(const Type& type);
     bool setRefKind(Expression& expr, VariableReference::RefKind kind);
     void copyIntrinsicIfNeeded(const FunctionDeclaration& function);
+    // Only returns an intrinsic that isn't already included in the current program, and then
+    // marks it as included.
+    const ProgramElement* findAndIncludeIntrinsic(const String& key);
     void findAndDeclareBuiltinVariables();
     bool detectVarDeclarationWithoutScope(const Statement& stmt);
     // Coerces returns to correct type and detects invalid break / continue placement
@@ -261,7 +239,9 @@ private:
     // currently working on
     StatementArray fExtraStatements;
     // Symbols which have definitions in the include files.
-    IRIntrinsicMap* fIntrinsics = nullptr;
+    const IRIntrinsicMap* fIntrinsics = nullptr;
+    // Intrinsics which have already been added to the current program.
+    std::unordered_set<const ProgramElement*> fIncludedIntrinsics;
     std::unordered_set<const FunctionDeclaration*> fReferencedIntrinsics;
     int fInvocations;
     std::unordered_set<const Type*> fDefinedStructs;
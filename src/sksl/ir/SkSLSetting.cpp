@@ -76,6 +76,7 @@ private:
 
 static const CapsLookupTable& caps_lookup_table() {
     // Create a lookup table that converts strings into the equivalent ShaderCapsClass methods.
+    // Built-in modules bake these values in, so ModuleCache::CapsKey must list the same caps.
     static CapsLookupTable* sCapsLookupTable = new CapsLookupTable({
     #define CAP(T, name) CapsLookupTable::Pair{#name, new T##CapsLookup{&ShaderCapsClass::name}}
         CAP(Bool, fbFetchSupport),
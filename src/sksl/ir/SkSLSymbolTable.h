@@ -36,6 +36,11 @@ public:
     , fBuiltin(builtin)
     , fErrorReporter(parent->fErrorReporter) {}
 
+    SymbolTable(std::shared_ptr<SymbolTable> parent, ErrorReporter* errorReporter, bool builtin)
+    : fParent(parent)
+    , fBuiltin(builtin)
+    , fErrorReporter(*errorReporter) {}
+
     /**
      * If the input is a built-in symbol table, returns a new empty symbol table as a child of the
      * input table. If the input is not a built-in symbol table, returns it as-is. Built-in symbol
@@ -8,11 +8,14 @@
 #include "include/codec/SkCodec.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImage.h"
 #include "include/utils/SkAnimCodecPlayer.h"
 #include "src/codec/SkCodecImageGenerator.h"
 #include "src/core/SkPixmapPriv.h"
+#include "src/core/SkTaskGroup.h"
 #include <algorithm>
+#include <atomic>
 
 SkAnimCodecPlayer::SkAnimCodecPlayer(std::unique_ptr<SkCodec> codec) : fCodec(std::move(codec)) {
     fImageInfo = fCodec->getInfo();
@@ -49,35 +52,34 @@ SkISize SkAnimCodecPlayer::dimensions() const {
     return { fImageInfo.width(), fImageInfo.height() };
 }
 
-sk_sp<SkImage> SkAnimCodecPlayer::getFrameAt(int index) {
-    SkASSERT((unsigned)index < fFrameInfos.size());
-
-    if (fImages[index]) {
-        return fImages[index];
-    }
-
-    size_t rb = fImageInfo.minRowBytes();
-    size_t size = fImageInfo.computeByteSize(rb);
+// Decodes frame index of codec. If requiredImage is not null, it is the frame's (already decoded)
+// fRequiredFrame, which the frame is decoded on top of; otherwise the codec decodes that itself.
+// Frames, including requiredImage, are oriented according to the codec's origin.
+static sk_sp<SkImage> decode_frame(SkCodec* codec, const SkCodec::FrameInfo& frameInfo, int index,
+                                   sk_sp<SkImage> requiredImage) {
+    auto imageInfo = codec->getInfo();
+    size_t rb = imageInfo.minRowBytes();
+    size_t size = imageInfo.computeByteSize(rb);
     auto data = SkData::MakeUninitialized(size);
 
     SkCodec::Options opts;
     opts.fFrameIndex = index;
 
-    const auto origin = fCodec->getOrigin();
-    const auto orientedDims = this->dimensions();
+    const auto origin = codec->getOrigin();
+    const auto orientedDims = SkEncodedOriginSwapsWidthHeight(origin)
+                                      ? SkISize{imageInfo.height(), imageInfo.width()}
+                                      : imageInfo.dimensions();
     const auto originMatrix = SkEncodedOriginToMatrix(origin, orientedDims.width(),
                                                               orientedDims.height());
 
     SkPaint paint;
     paint.setBlendMode(SkBlendMode::kSrc);
 
-    auto imageInfo = fImageInfo;
-    if (fFrameInfos[index].fAlphaType != kOpaque_SkAlphaType && imageInfo.isOpaque()) {
+    if (frameInfo.fAlphaType != kOpaque_SkAlphaType && imageInfo.isOpaque()) {
         imageInfo = imageInfo.makeAlphaType(kPremul_SkAlphaType);
     }
-    const int requiredFrame = fFrameInfos[index].fRequiredFrame;
-    if (requiredFrame != SkCodec::kNoFrame && fImages[requiredFrame]) {
-        auto requiredImage = fImages[requiredFrame];
+    const int requiredFrame = frameInfo.fRequiredFrame;
+    if (requiredFrame != SkCodec::kNoFrame && requiredImage) {
         auto canvas = SkCanvas::MakeRasterDirect(imageInfo, data->writable_data(), rb);
         if (origin != kDefault_SkEncodedOrigin) {
             // The required frame is stored after applying the origin. Undo that,
@@ -95,7 +97,7 @@ sk_sp<SkImage> SkAnimCodecPlayer::getFrameAt(int index) {
         opts.fPriorFrame = requiredFrame;
     }
 
-    if (SkCodec::kSuccess != fCodec->getPixels(imageInfo, data->writable_data(), rb, &opts)) {
+    if (SkCodec::kSuccess != codec->getPixels(imageInfo, data->writable_data(), rb, &opts)) {
         return nullptr;
     }
 
@@ -110,7 +112,20 @@ sk_sp<SkImage> SkAnimCodecPlayer::getFrameAt(int index) {
         canvas->drawImage(image, 0, 0, SkSamplingOptions(), &paint);
         image = SkImage::MakeRasterData(imageInfo, std::move(data), rb);
     }
-    return fImages[index] = image;
+    return image;
+}
+
+sk_sp<SkImage> SkAnimCodecPlayer::getFrameAt(int index) {
+    SkASSERT((unsigned)index < fFrameInfos.size());
+
+    if (fImages[index]) {
+        return fImages[index];
+    }
+
+    const int requiredFrame = fFrameInfos[index].fRequiredFrame;
+    return fImages[index] = decode_frame(fCodec.get(), fFrameInfos[index], index,
+                                         requiredFrame != SkCodec::kNoFrame
+                                                 ? fImages[requiredFrame] : nullptr);
 }
 
 sk_sp<SkImage> SkAnimCodecPlayer::getFrame() {
@@ -137,4 +152,87 @@ bool SkAnimCodecPlayer::seek(uint32_t msec) {
     return fCurrIndex != prevIndex;
 }
 
+bool SkAnimCodecPlayer::DecodeFrames(sk_sp<SkData> data, const FrameProc& proc,
+                                     SkExecutor* executor) {
+    std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(data);
+    if (!codec) {
+        return false;
+    }
+    const std::vector<SkCodec::FrameInfo> frameInfos = codec->getFrameInfo();
+    if (frameInfos.empty()) {
+        // Static image.
+        sk_sp<SkImage> image = SkImage::MakeFromGenerator(
+                SkCodecImageGenerator::MakeFromCodec(std::move(codec)));
+        image = image ? image->makeRasterImage() : nullptr;
+        if (!image) {
+            return false;
+        }
+        proc(0, std::move(image));
+        return true;
+    }
 
+    // Runs of frames starting at an independent frame are decoded in parallel. A run can only
+    // start at frame i if no frame from i on requires a frame before i: a frame may require one
+    // from before the closest preceding independent frame, when that one is disposed with
+    // kRestorePrevious (see SkFrameHolder::setAlphaAndRequiredFrame).
+    const int frameCount = SkToInt(frameInfos.size());
+    std::vector<int> lastRequiredBy(frameCount, -1);
+    for (int i = 0; i < frameCount; ++i) {
+        const int required = frameInfos[i].fRequiredFrame;
+        if (required != SkCodec::kNoFrame) {
+            lastRequiredBy[required] = i;
+        }
+    }
+    std::vector<int> runStarts;
+    int minRequired = frameCount;   // Earliest frame required by any frame from i on.
+    for (int i = frameCount - 1; i >= 0; --i) {
+        const int required = frameInfos[i].fRequiredFrame;
+        if (required != SkCodec::kNoFrame) {
+            minRequired = std::min(minRequired, required);
+        } else if (minRequired >= i) {
+            runStarts.push_back(i);
+        }
+    }
+    std::reverse(runStarts.begin(), runStarts.end());
+    SkASSERT(!runStarts.empty() && runStarts.front() == 0);
+    const int runCount = SkToInt(runStarts.size());
+
+    std::atomic<bool> success{true};
+    SkTaskGroup tasks(executor ? *executor : SkExecutor::GetDefault());
+    tasks.batch(runCount, [&](int run) {
+        // The first run can use the codec we already have; each other run needs its own.
+        std::unique_ptr<SkCodec> runCodec = run == 0 ? std::move(codec)
+                                                     : SkCodec::MakeFromData(data);
+        if (!runCodec) {
+            success = false;
+            return;
+        }
+
+        const int start = runStarts[run],
+                  end   = run + 1 < runCount ? runStarts[run + 1] : frameCount;
+        std::vector<sk_sp<SkImage>> required(end - start);
+        for (int i = start; i < end && success; ++i) {
+            const int requiredFrame = frameInfos[i].fRequiredFrame;
+            const bool inRun = requiredFrame != SkCodec::kNoFrame;
+            SkASSERT(!inRun || (requiredFrame >= start && requiredFrame < i));
+
+            sk_sp<SkImage> frame = decode_frame(runCodec.get(), frameInfos[i], i,
+                                                inRun ? required[requiredFrame - start]
+                                                      : nullptr);
+            if (!frame) {
+                success = false;
+                return;
+            }
+            // Only hold on to frames that later frames still need.
+            if (lastRequiredBy[i] > i) {
+                required[i - start] = frame;
+            }
+            if (inRun && lastRequiredBy[requiredFrame] == i) {
+                required[requiredFrame - start].reset();
+            }
+            proc(i, std::move(frame));
+        }
+    });
+    tasks.wait();
+    return success;
+}
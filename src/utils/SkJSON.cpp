@@ -10,6 +10,7 @@
 #include "include/core/SkStream.h"
 #include "include/core/SkString.h"
 #include "include/private/SkMalloc.h"
+#include "include/private/SkVx.h"
 #include "include/utils/SkParse.h"
 #include "src/utils/SkUTF.h"
 
@@ -269,6 +270,29 @@ static inline const char* skip_ws(const char* p) {
     return p;
 }
 
+static inline bool is_number_start(char c) { return is_digit(c) || c == '-'; }
+
+// Skips 16-byte blocks of plain string chars, stopping at the first block which may contain
+// a string terminator (see is_eostring) -- the caller is responsible for the final scalar scan.
+// Never reads at or past p_stop.
+static inline const char* skip_string_chars(const char* p, const char* p_stop) {
+    using U8x16 = skvx::Vec<16, uint8_t>;
+
+    while (p_stop - p >= 16) {
+        const auto c = U8x16::Load(p);
+        const auto terminators = (c == '"') | (c == '\\') | (c < 0x20) | (c == '}') | (c == ']');
+
+        const auto t64 = skvx::bit_pun<skvx::Vec<2, uint64_t>>(terminators);
+        if (t64[0] | t64[1]) {
+            break;
+        }
+
+        p += 16;
+    }
+
+    return p;
+}
+
 static inline float pow10(int32_t exp) {
     static constexpr float g_pow10_table[63] =
     {
@@ -291,17 +315,240 @@ static inline float pow10(int32_t exp) {
                                   : std::pow(10.0f, static_cast<float>(exp));
 }
 
-class DOMParser {
+// Materializes parsed values as a DOM tree, allocated in the given arena.
+class DOMSink {
 public:
-    explicit DOMParser(SkArenaAlloc& alloc)
+    explicit DOMSink(SkArenaAlloc& alloc)
         : fAlloc(alloc) {
         fValueStack.reserve(kValueStackReserve);
+    }
+
+    const Value& root() const {
+        SkASSERT(this->inTopLevelScope());
+        SkASSERT(fValueStack.size() == 1);
+        return fValueStack.front();
+    }
+
+protected:
+    bool inTopLevelScope() const { return fScopeIndex == 0; }
+    bool inObjectScope()   const { return fScopeIndex >  0; }
+    bool inArrayScope()    const { return fScopeIndex <  0; }
+
+    void pushObjectScope() {
+        // Save a scope index now, and then later we'll overwrite this value as the Object itself.
+        fValueStack.push_back(RawValue<intptr_t>(fScopeIndex));
+
+        // New object scope.
+        fScopeIndex = SkTo<intptr_t>(fValueStack.size());
+    }
+
+    void popObjectScope() {
+        SkASSERT(this->inObjectScope());
+        this->popScopeAsVec<ObjectValue>(SkTo<size_t>(fScopeIndex));
+
+        SkDEBUGCODE(
+            const auto& obj = fValueStack.back().as<ObjectValue>();
+            SkASSERT(obj.is<ObjectValue>());
+            for (const auto& member : obj) {
+                SkASSERT(member.fKey.is<StringValue>());
+            }
+        )
+    }
+
+    void pushArrayScope() {
+        // Save a scope index now, and then later we'll overwrite this value as the Array itself.
+        fValueStack.push_back(RawValue<intptr_t>(fScopeIndex));
+
+        // New array scope.
+        fScopeIndex = -SkTo<intptr_t>(fValueStack.size());
+    }
+
+    void popArrayScope() {
+        SkASSERT(this->inArrayScope());
+        this->popScopeAsVec<ArrayValue>(SkTo<size_t>(-fScopeIndex));
+
+        SkDEBUGCODE(
+            const auto& arr = fValueStack.back().as<ArrayValue>();
+            SkASSERT(arr.is<ArrayValue>());
+        )
+    }
+
+    void pushObjectKey(const char* key, size_t size, const char* eos) {
+        SkASSERT(this->inObjectScope());
+        SkASSERT(fValueStack.size() >= SkTo<size_t>(fScopeIndex));
+        SkASSERT(!((fValueStack.size() - SkTo<size_t>(fScopeIndex)) & 1));
+        this->pushString(key, size, eos);
+    }
+
+    void pushTrue() {
+        fValueStack.push_back(BoolValue(true));
+    }
+
+    void pushFalse() {
+        fValueStack.push_back(BoolValue(false));
+    }
+
+    void pushNull() {
+        fValueStack.push_back(NullValue());
+    }
+
+    void pushString(const char* s, size_t size, const char* eos) {
+        fValueStack.push_back(FastString(s, size, eos, fAlloc));
+    }
+
+    void pushInt32(int32_t i) {
+        fValueStack.push_back(NumberValue(i));
+    }
+
+    void pushFloat(float f) {
+        fValueStack.push_back(NumberValue(f));
+    }
+
+private:
+    SkArenaAlloc&         fAlloc;
+
+    // Pending values stack.
+    static constexpr size_t kValueStackReserve = 256;
+    std::vector<Value>    fValueStack;
+
+    // Tracks the current object/array scope, as an index into fStack:
+    //
+    //   - for objects: fScopeIndex =  (index of first value in scope)
+    //   - for arrays : fScopeIndex = -(index of first value in scope)
+    //
+    // fScopeIndex == 0 IFF we are at the top level (no current/active scope).
+    intptr_t              fScopeIndex = 0;
+
+    // Helper for masquerading raw primitive types as Values (bypassing tagging, etc).
+    template <typename T>
+    class RawValue final : public Value {
+    public:
+        explicit RawValue(T v) {
+            static_assert(sizeof(T) <= sizeof(Value), "");
+            *this->cast<T>() = v;
+        }
+
+        T operator *() const { return *this->cast<T>(); }
+    };
+
+    template <typename VectorT>
+    void popScopeAsVec(size_t scope_start) {
+        SkASSERT(scope_start > 0);
+        SkASSERT(scope_start <= fValueStack.size());
+
+        using T = typename VectorT::ValueT;
+        static_assert( sizeof(T) >=  sizeof(Value), "");
+        static_assert( sizeof(T)  %  sizeof(Value) == 0, "");
+        static_assert(alignof(T) == alignof(Value), "");
+
+        const auto scope_count = fValueStack.size() - scope_start,
+                         count = scope_count / (sizeof(T) / sizeof(Value));
+        SkASSERT(scope_count % (sizeof(T) / sizeof(Value)) == 0);
+
+        const auto* begin = reinterpret_cast<const T*>(fValueStack.data() + scope_start);
+
+        // Restore the previous scope index from saved placeholder value,
+        // and instantiate as a vector of values in scope.
+        auto& placeholder = fValueStack[scope_start - 1];
+        fScopeIndex = *static_cast<RawValue<intptr_t>&>(placeholder);
+        placeholder = VectorT(begin, count, fAlloc);
+
+        // Drop the (consumed) values in scope.
+        fValueStack.resize(scope_start);
+    }
+};
+
+// Forwards parsed values to a client Visitor, without retaining them.
+class VisitorSink {
+public:
+    explicit VisitorSink(Visitor* visitor)
+        : fVisitor(visitor) {
+        fScopeStack.reserve(kScopeStackReserve);
+    }
+
+protected:
+    bool inTopLevelScope() const { return fScopeStack.empty(); }
+    bool inObjectScope()   const { return !fScopeStack.empty() &&  fScopeStack.back(); }
+    bool inArrayScope()    const { return !fScopeStack.empty() && !fScopeStack.back(); }
+
+    void pushObjectScope() {
+        fScopeStack.push_back(true);
+        fVisitor->onBeginObject();
+    }
+
+    void popObjectScope() {
+        SkASSERT(this->inObjectScope());
+        fScopeStack.pop_back();
+        fVisitor->onEndObject();
+    }
+
+    void pushArrayScope() {
+        fScopeStack.push_back(false);
+        fVisitor->onBeginArray();
+    }
+
+    void popArrayScope() {
+        SkASSERT(this->inArrayScope());
+        fScopeStack.pop_back();
+        fVisitor->onEndArray();
+    }
+
+    void pushObjectKey(const char* key, size_t size, const char*) {
+        SkASSERT(this->inObjectScope());
+        fVisitor->onKey(key, size);
+    }
+
+    void pushString(const char* s, size_t size, const char*) {
+        fVisitor->onString(s, size);
+    }
+
+    void pushTrue()  { fVisitor->onBool(true);  }
+    void pushFalse() { fVisitor->onBool(false); }
+    void pushNull()  { fVisitor->onNull();      }
+
+    void pushInt32(int32_t i) { fVisitor->onInt32(i); }
+    void pushFloat(float f)   { fVisitor->onFloat(f); }
+
+private:
+    Visitor* fVisitor;
+
+    // Currently open scopes (true: object, false: array).
+    static constexpr size_t kScopeStackReserve = 64;
+    std::vector<bool>       fScopeStack;
+};
+
+// The parser drives a Sink through a sequence of scope/value push operations.
+// Sinks provide the following (protected) interface:
+//
+//   bool inTopLevelScope() const;
+//   bool inObjectScope() const;
+//   bool inArrayScope() const;
+//
+//   void pushObjectScope();
+//   void popObjectScope();
+//   void pushArrayScope();
+//   void popArrayScope();
+//
+//   void pushObjectKey(const char* key, size_t size, const char* eos);
+//   void pushString(const char* s, size_t size, const char* eos);
+//   void pushTrue();
+//   void pushFalse();
+//   void pushNull();
+//   void pushInt32(int32_t);
+//   void pushFloat(float);
+//
+// (|eos| marks the end of the readable input, which may extend past the string payload).
+template <typename Sink>
+class Parser final : public Sink {
+public:
+    template <typename... Args>
+    explicit Parser(Args&&... args) : Sink(std::forward<Args>(args)...) {
         fUnescapeBuffer.reserve(kUnescapeBufferReserve);
     }
 
-    Value parse(const char* p, size_t size) {
+    bool parse(const char* p, size_t size) {
         if (!size) {
-            return this->error(NullValue(), p, "invalid empty input");
+            return this->error(false, p, "invalid empty input");
         }
 
         const char* p_stop = p + size - 1;
@@ -312,7 +559,7 @@ public:
 
         SkASSERT(p_stop >= p && p_stop < p + size);
         if (!is_eoscope(*p_stop)) {
-            return this->error(NullValue(), p_stop, "invalid top-level value");
+            return this->error(false, p_stop, "invalid top-level value");
         }
 
         p = skip_ws(p);
@@ -323,7 +570,7 @@ public:
         case '[':
             goto match_array;
         default:
-            return this->error(NullValue(), p, "invalid top-level value");
+            return this->error(false, p, "invalid top-level value");
         }
 
     match_object:
@@ -337,15 +584,15 @@ public:
         // goto match_object_key;
     match_object_key:
         p = skip_ws(p);
-        if (*p != '"') return this->error(NullValue(), p, "expected object key");
+        if (*p != '"') return this->error(false, p, "expected object key");
 
         p = this->matchString(p, p_stop, [this](const char* key, size_t size, const char* eos) {
             this->pushObjectKey(key, size, eos);
         });
-        if (!p) return NullValue();
+        if (!p) return false;
 
         p = skip_ws(p);
-        if (*p != ':') return this->error(NullValue(), p, "expected ':' separator");
+        if (*p != ':') return this->error(false, p, "expected ':' separator");
 
         ++p;
 
@@ -355,7 +602,7 @@ public:
 
         switch (*p) {
         case '\0':
-            return this->error(NullValue(), p, "unexpected input end");
+            return this->error(false, p, "unexpected input end");
         case '"':
             p = this->matchString(p, p_stop, [this](const char* str, size_t size, const char* eos) {
                 this->pushString(str, size, eos);
@@ -379,7 +626,7 @@ public:
             break;
         }
 
-        if (!p) return NullValue();
+        if (!p) return false;
 
         // goto match_post_value;
     match_post_value:
@@ -400,7 +647,7 @@ public:
         case '}':
             goto pop_object;
         default:
-            return this->error(NullValue(), p - 1, "unexpected value-trailing token");
+            return this->error(false, p - 1, "unexpected value-trailing token");
         }
 
         // unreachable
@@ -410,7 +657,7 @@ public:
         SkASSERT(*p == '}');
 
         if (this->inArrayScope()) {
-            return this->error(NullValue(), p, "unexpected object terminator");
+            return this->error(false, p, "unexpected object terminator");
         }
 
         this->popObjectScope();
@@ -420,16 +667,14 @@ public:
         SkASSERT(is_eoscope(*p));
 
         if (this->inTopLevelScope()) {
-            SkASSERT(fValueStack.size() == 1);
-
             // Success condition: parsed the top level element and reached the stop token.
             return p == p_stop
-                ? fValueStack.front()
-                : this->error(NullValue(), p + 1, "trailing root garbage");
+                ? true
+                : this->error(false, p + 1, "trailing root garbage");
         }
 
         if (p == p_stop) {
-            return this->error(NullValue(), p, "unexpected end-of-input");
+            return this->error(false, p, "unexpected end-of-input");
         }
 
         ++p;
@@ -442,14 +687,27 @@ public:
 
         this->pushArrayScope();
 
-        if (*p != ']') goto match_value;
+        if (*p == ']') goto pop_array;
+        if (!is_number_start(*p)) goto match_value;
+
+        // Numeric array fast path (the bulk of Lottie payloads): stay in a tight loop for as
+        // long as we're matching numbers, bypassing the generic value dispatch.
+        for (;;) {
+            p = this->matchNumber(p);
+            if (!p) return false;
+
+            p = skip_ws(p);
+            if (*p != ',') goto match_post_value;
+
+            p = skip_ws(p + 1);
+            if (!is_number_start(*p)) goto match_value;
+        }
 
-        // goto pop_array;
     pop_array:
         SkASSERT(*p == ']');
 
         if (this->inObjectScope()) {
-            return this->error(NullValue(), p, "unexpected array terminator");
+            return this->error(false, p, "unexpected array terminator");
         }
 
         this->popArrayScope();
@@ -457,7 +715,7 @@ public:
         goto pop_common;
 
         SkASSERT(false);
-        return NullValue();
+        return false;
     }
 
     std::tuple<const char*, const SkString> getError() const {
@@ -465,140 +723,14 @@ public:
     }
 
 private:
-    SkArenaAlloc&         fAlloc;
-
-    // Pending values stack.
-    static constexpr size_t kValueStackReserve = 256;
-    std::vector<Value>    fValueStack;
-
     // String unescape buffer.
     static constexpr size_t kUnescapeBufferReserve = 512;
     std::vector<char>     fUnescapeBuffer;
 
-    // Tracks the current object/array scope, as an index into fStack:
-    //
-    //   - for objects: fScopeIndex =  (index of first value in scope)
-    //   - for arrays : fScopeIndex = -(index of first value in scope)
-    //
-    // fScopeIndex == 0 IFF we are at the top level (no current/active scope).
-    intptr_t              fScopeIndex = 0;
-
     // Error reporting.
     const char*           fErrorToken = nullptr;
     SkString              fErrorMessage;
 
-    bool inTopLevelScope() const { return fScopeIndex == 0; }
-    bool inObjectScope()   const { return fScopeIndex >  0; }
-    bool inArrayScope()    const { return fScopeIndex <  0; }
-
-    // Helper for masquerading raw primitive types as Values (bypassing tagging, etc).
-    template <typename T>
-    class RawValue final : public Value {
-    public:
-        explicit RawValue(T v) {
-            static_assert(sizeof(T) <= sizeof(Value), "");
-            *this->cast<T>() = v;
-        }
-
-        T operator *() const { return *this->cast<T>(); }
-    };
-
-    template <typename VectorT>
-    void popScopeAsVec(size_t scope_start) {
-        SkASSERT(scope_start > 0);
-        SkASSERT(scope_start <= fValueStack.size());
-
-        using T = typename VectorT::ValueT;
-        static_assert( sizeof(T) >=  sizeof(Value), "");
-        static_assert( sizeof(T)  %  sizeof(Value) == 0, "");
-        static_assert(alignof(T) == alignof(Value), "");
-
-        const auto scope_count = fValueStack.size() - scope_start,
-                         count = scope_count / (sizeof(T) / sizeof(Value));
-        SkASSERT(scope_count % (sizeof(T) / sizeof(Value)) == 0);
-
-        const auto* begin = reinterpret_cast<const T*>(fValueStack.data() + scope_start);
-
-        // Restore the previous scope index from saved placeholder value,
-        // and instantiate as a vector of values in scope.
-        auto& placeholder = fValueStack[scope_start - 1];
-        fScopeIndex = *static_cast<RawValue<intptr_t>&>(placeholder);
-        placeholder = VectorT(begin, count, fAlloc);
-
-        // Drop the (consumed) values in scope.
-        fValueStack.resize(scope_start);
-    }
-
-    void pushObjectScope() {
-        // Save a scope index now, and then later we'll overwrite this value as the Object itself.
-        fValueStack.push_back(RawValue<intptr_t>(fScopeIndex));
-
-        // New object scope.
-        fScopeIndex = SkTo<intptr_t>(fValueStack.size());
-    }
-
-    void popObjectScope() {
-        SkASSERT(this->inObjectScope());
-        this->popScopeAsVec<ObjectValue>(SkTo<size_t>(fScopeIndex));
-
-        SkDEBUGCODE(
-            const auto& obj = fValueStack.back().as<ObjectValue>();
-            SkASSERT(obj.is<ObjectValue>());
-            for (const auto& member : obj) {
-                SkASSERT(member.fKey.is<StringValue>());
-            }
-        )
-    }
-
-    void pushArrayScope() {
-        // Save a scope index now, and then later we'll overwrite this value as the Array itself.
-        fValueStack.push_back(RawValue<intptr_t>(fScopeIndex));
-
-        // New array scope.
-        fScopeIndex = -SkTo<intptr_t>(fValueStack.size());
-    }
-
-    void popArrayScope() {
-        SkASSERT(this->inArrayScope());
-        this->popScopeAsVec<ArrayValue>(SkTo<size_t>(-fScopeIndex));
-
-        SkDEBUGCODE(
-            const auto& arr = fValueStack.back().as<ArrayValue>();
-            SkASSERT(arr.is<ArrayValue>());
-        )
-    }
-
-    void pushObjectKey(const char* key, size_t size, const char* eos) {
-        SkASSERT(this->inObjectScope());
-        SkASSERT(fValueStack.size() >= SkTo<size_t>(fScopeIndex));
-        SkASSERT(!((fValueStack.size() - SkTo<size_t>(fScopeIndex)) & 1));
-        this->pushString(key, size, eos);
-    }
-
-    void pushTrue() {
-        fValueStack.push_back(BoolValue(true));
-    }
-
-    void pushFalse() {
-        fValueStack.push_back(BoolValue(false));
-    }
-
-    void pushNull() {
-        fValueStack.push_back(NullValue());
-    }
-
-    void pushString(const char* s, size_t size, const char* eos) {
-        fValueStack.push_back(FastString(s, size, eos, fAlloc));
-    }
-
-    void pushInt32(int32_t i) {
-        fValueStack.push_back(NumberValue(i));
-    }
-
-    void pushFloat(float f) {
-        fValueStack.push_back(NumberValue(f));
-    }
-
     template <typename T>
     T error(T&& ret_val, const char* p, const char* msg) {
 #if defined(SK_JSON_REPORT_ERRORS)
@@ -696,7 +828,7 @@ private:
         do {
             // Consume string chars.
             // This is the fast path, and hopefully we only hit it once then quick-exit below.
-            for (p = p + 1; !is_eostring(*p); ++p);
+            for (p = skip_string_chars(p + 1, p_stop); !is_eostring(*p); ++p);
 
             if (*p == '"') {
                 // Valid string found.
@@ -913,13 +1045,21 @@ static constexpr size_t kMinChunkSize = 4096;
 
 DOM::DOM(const char* data, size_t size)
     : fAlloc(kMinChunkSize) {
-    DOMParser parser(fAlloc);
+    Parser<DOMSink> parser(fAlloc);
 
-    fRoot = parser.parse(data, size);
+    fRoot = parser.parse(data, size) ? parser.root() : NullValue();
 }
 
 void DOM::write(SkWStream* stream) const {
     Write(fRoot, stream);
 }
 
+bool Parse(const char* data, size_t size, Visitor* visitor) {
+    SkASSERT(visitor);
+
+    Parser<VisitorSink> parser(visitor);
+
+    return parser.parse(data, size);
+}
+
 } // namespace skjson
@@ -345,6 +345,40 @@ private:
     Value        fRoot;
 };
 
+/**
+ *  Streaming (SAX-style) interface.
+ *
+ *  Instead of materializing a DOM, Parse() reports values to a Visitor as they are encountered.
+ *  Nothing is retained by the parser, so memory usage is independent of the input size -- which
+ *  makes this mode suitable for scanning large documents or for building custom object models.
+ *
+ *  Key and string payloads are unescaped but NOT null-terminated, and are only valid for the
+ *  duration of the callback.
+ *
+ *  The input is validated on the fly: on malformed input, Parse() returns false -- possibly after
+ *  having already dispatched some events for the well-formed prefix.
+ */
+class Visitor {
+public:
+    virtual ~Visitor() = default;
+
+    virtual void onBeginObject() {}
+    virtual void onEndObject()   {}
+    virtual void onBeginArray()  {}
+    virtual void onEndArray()    {}
+
+    // Object member keys, always followed by the corresponding member value events.
+    virtual void onKey(const char[], size_t) {}
+
+    virtual void onString(const char[], size_t) {}
+    virtual void onInt32(int32_t)               {}
+    virtual void onFloat(float)                 {}
+    virtual void onBool(bool)                   {}
+    virtual void onNull()                       {}
+};
+
+bool Parse(const char data[], size_t size, Visitor*);
+
 inline Value::Type Value::getType() const {
     switch (this->getTag()) {
     case Tag::kNull:        return Type::kNull;
@@ -210,13 +210,21 @@ struct SpotVerticesFactory {
 /**
  * This manages a set of tessellations for a given shape in the cache. Because SkResourceCache
  * records are immutable this is not itself a Rec. When we need to update it we return this on
- * the FindVisitor and let the cache destroy the Rec. We'll update the tessellations and then add
- * a new Rec with an adjusted size for any deletions/additions.
+ * the FindVisitor and let the cache destroy the Rec. We'll update a copy of the tessellations
+ * (lookups may run concurrently, so other threads can be handed the same one) and then add a new
+ * Rec with an adjusted size for any deletions/additions.
  */
 class CachedTessellations : public SkRefCnt {
 public:
     size_t size() const { return fAmbientSet.size() + fSpotSet.size(); }
 
+    sk_sp<CachedTessellations> makeCopy() const {
+        auto copy = sk_make_sp<CachedTessellations>();
+        copy->fAmbientSet = fAmbientSet;
+        copy->fSpotSet = fSpotSet;
+        return copy;
+    }
+
     sk_sp<SkVertices> find(const AmbientVerticesFactory& ambient, const SkMatrix& matrix,
                            SkVector* translate) const {
         return fAmbientSet.find(ambient, matrix, translate);
@@ -371,8 +379,8 @@ bool FindVisitor(const SkResourceCache::Rec& baseRec, void* ctx) {
     if (findContext->fVertices) {
         return true;
     }
-    // We ref the tessellations and let the cache destroy the Rec. Once the tessellations have been
-    // manipulated we will add a new Rec.
+    // We ref the tessellations and let the cache destroy the Rec. Once a copy of the tessellations
+    // has been manipulated we will add a new Rec.
     findContext->fTessellationsOnFailure = rec.refTessellations();
     return false;
 }
@@ -469,7 +477,7 @@ bool draw_shadow(const FACTORY& factory,
             // Update or initialize a tessellation set and add it to the cache.
             sk_sp<CachedTessellations> tessellations;
             if (context.fTessellationsOnFailure) {
-                tessellations = std::move(context.fTessellationsOnFailure);
+                tessellations = context.fTessellationsOnFailure->makeCopy();
             } else {
                 tessellations.reset(new CachedTessellations());
             }
@@ -8,17 +8,23 @@
 #include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkImageGenerator.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkTypes.h"
 #include "include/private/SkColorData.h"
+#include "include/private/SkSemaphore.h"
 #include "src/core/SkUtils.h"
+#include "src/image/SkImage_Lazy.h"
 #include "tests/Test.h"
 #include "tools/ToolUtils.h"
 
+#include <atomic>
+#include <functional>
 #include <utility>
+#include <vector>
 
 class TestImageGenerator : public SkImageGenerator {
 public:
@@ -125,3 +131,305 @@ DEF_TEST(Image_NewFromGenerator, r) {
         }
     }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+// Fills with a solid color, but holds getPixels() calls until the test opens the gate, so
+// that overlapping decode requests are guaranteed to see each other. Once open, the gate stays
+// open for any later decode.
+class GatedImageGenerator : public SkImageGenerator {
+public:
+    GatedImageGenerator(SkSemaphore* gate, std::atomic<int>* decodeCount)
+        : INHERITED(SkImageInfo::MakeN32Premul(16, 16)), fGate(gate), fDecodeCount(decodeCount) {}
+
+protected:
+    bool onGetPixels(const SkImageInfo& info, void* pixels, size_t rowBytes,
+                     const Options&) override {
+        fGate->wait();
+        fGate->signal();
+        fDecodeCount->fetch_add(1);
+        for (int y = 0; y < info.height(); ++y) {
+            sk_memset32((uint32_t*)((char*)pixels + y * rowBytes), SK_ColorRED, info.width());
+        }
+        return true;
+    }
+
+private:
+    SkSemaphore*      fGate;
+    std::atomic<int>* fDecodeCount;
+
+    using INHERITED = SkImageGenerator;
+};
+}  // namespace
+
+DEF_TEST(Image_LazyDecodeAsync, r) {
+    SkSemaphore gate;
+    std::atomic<int> decodeCount{0};
+    sk_sp<SkImage> image = SkImage::MakeFromGenerator(
+            std::make_unique<GatedImageGenerator>(&gate, &decodeCount));
+    REPORTER_ASSERT(r, image && image->isLazyGenerated());
+    auto lazy = static_cast<const SkImage_Lazy*>(image.get());
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(2);
+
+    // The generator is gated, so the first decode cannot finish before the second request.
+    sk_sp<SkImage_Lazy::PendingDecode> first = lazy->decodeAsync(executor.get());
+    sk_sp<SkImage_Lazy::PendingDecode> second = lazy->decodeAsync(executor.get());
+    REPORTER_ASSERT(r, first.get() == second.get());
+    REPORTER_ASSERT(r, !first->isDone());
+
+    gate.signal(1);
+    SkBitmap bitmap;
+    REPORTER_ASSERT(r, second->wait(&bitmap));
+    REPORTER_ASSERT(r, first->isDone());
+    REPORTER_ASSERT(r, bitmap.getColor(0, 0) == SK_ColorRED);
+    REPORTER_ASSERT(r, decodeCount.load() == 1);
+
+    // Later requests either find the pixels cached or decode them again (if the cache was
+    // purged meanwhile); either way they get the same pixels.
+    sk_sp<SkImage_Lazy::PendingDecode> later = lazy->decodeAsync(executor.get());
+    SkBitmap readback;
+    REPORTER_ASSERT(r, later->wait(&readback));
+    REPORTER_ASSERT(r, readback.getColor(15, 15) == SK_ColorRED);
+    REPORTER_ASSERT(r, as_IB(image)->getROPixels(nullptr, &readback));
+    REPORTER_ASSERT(r, readback.getColor(15, 15) == SK_ColorRED);
+}
+
+DEF_TEST(Image_LazyDecodeAsync_WaitOnWorker, r) {
+    SkSemaphore gate;
+    gate.signal(1);
+    std::atomic<int> decodeCount{0};
+    sk_sp<SkImage> image = SkImage::MakeFromGenerator(
+            std::make_unique<GatedImageGenerator>(&gate, &decodeCount));
+    auto lazy = static_cast<const SkImage_Lazy*>(image.get());
+
+    // The only worker queues a decode behind itself and then needs the pixels: the decode
+    // cannot start on the executor, so the worker has to run it inline rather than block.
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(1);
+    SkSemaphore done;
+    bool decoded = false;
+    SkColor color = 0;
+    executor->add([&] {
+        sk_sp<SkImage_Lazy::PendingDecode> pending = lazy->decodeAsync(executor.get());
+        SkBitmap bitmap;
+        decoded = as_IB(image)->getROPixels(nullptr, &bitmap) && pending->isDone();
+        if (decoded) {
+            color = bitmap.getColor(0, 0);
+        }
+        done.signal();
+    });
+    done.wait();
+    REPORTER_ASSERT(r, decoded);
+    REPORTER_ASSERT(r, color == SK_ColorRED);
+}
+
+namespace {
+// Queues work but never runs it; destroying it drops whatever is still queued, like some
+// executors do on shutdown.
+class DroppingExecutor final : public SkExecutor {
+public:
+    void add(std::function<void(void)> work) override { fWork.push_back(std::move(work)); }
+
+private:
+    std::vector<std::function<void(void)>> fWork;
+};
+}  // namespace
+
+DEF_TEST(Image_LazyDecodeAsync_DroppedTask, r) {
+    SkSemaphore gate;
+    gate.signal(1);
+    std::atomic<int> decodeCount{0};
+    sk_sp<SkImage> image = SkImage::MakeFromGenerator(
+            std::make_unique<GatedImageGenerator>(&gate, &decodeCount));
+    auto lazy = static_cast<const SkImage_Lazy*>(image.get());
+
+    // Drop the handle, then the executor with the decode still queued.
+    {
+        DroppingExecutor executor;
+        sk_sp<SkImage_Lazy::PendingDecode> pending = lazy->decodeAsync(&executor);
+        REPORTER_ASSERT(r, !pending->isDone());
+    }
+    REPORTER_ASSERT(r, decodeCount.load() == 0);
+
+    // A handle that outlives its dropped task can still run the decode itself.
+    sk_sp<SkImage_Lazy::PendingDecode> survivor;
+    {
+        DroppingExecutor executor;
+        survivor = lazy->decodeAsync(&executor);
+    }
+    SkBitmap bitmap;
+    REPORTER_ASSERT(r, survivor->wait(&bitmap));
+    REPORTER_ASSERT(r, bitmap.getColor(0, 0) == SK_ColorRED);
+
+    // Later requests start (or find) a live decode rather than the dropped one.
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(1);
+    sk_sp<SkImage_Lazy::PendingDecode> later = lazy->decodeAsync(executor.get());
+    REPORTER_ASSERT(r, later->wait(&bitmap));
+    REPORTER_ASSERT(r, bitmap.getColor(15, 15) == SK_ColorRED);
+    REPORTER_ASSERT(r, as_IB(image)->getROPixels(nullptr, &bitmap));
+    REPORTER_ASSERT(r, bitmap.getColor(15, 15) == SK_ColorRED);
+}
+
+namespace {
+// Decodes natively at power-of-two fractions of its size, and records what it was asked for.
+class ScalingImageGenerator : public SkImageGenerator {
+public:
+    explicit ScalingImageGenerator(SkISize* lastDecode)
+        : INHERITED(SkImageInfo::MakeN32Premul(64, 64)), fLastDecode(lastDecode) {}
+
+protected:
+    SkISize onGetScaledDimensions(float desiredScale) const override {
+        int div = 1;
+        while (div < 8 && 1.0f / (div * 2) >= desiredScale) {
+            div *= 2;
+        }
+        return {this->getInfo().width() / div, this->getInfo().height() / div};
+    }
+
+    bool onGetPixels(const SkImageInfo& info, void* pixels, size_t rowBytes,
+                     const Options&) override {
+        *fLastDecode = info.dimensions();
+        for (int y = 0; y < info.height(); ++y) {
+            sk_memset32((uint32_t*)((char*)pixels + y * rowBytes), SK_ColorBLUE, info.width());
+        }
+        return true;
+    }
+
+private:
+    SkISize* fLastDecode;
+
+    using INHERITED = SkImageGenerator;
+};
+}  // namespace
+
+DEF_TEST(Image_LazyScaledDecode, r) {
+    // Each draw uses a fresh image, so it can't be served by pixels cached by an earlier one.
+    auto decoded_size = [](int drawSize, SkColor* drawn) {
+        SkISize lastDecode = {0, 0};
+        sk_sp<SkImage> image = SkImage::MakeFromGenerator(
+                std::make_unique<ScalingImageGenerator>(&lastDecode));
+        SkBitmap dst;
+        dst.allocN32Pixels(32, 32);
+        SkCanvas canvas(dst);
+        canvas.drawImageRect(image, SkRect::MakeIWH(drawSize, drawSize),
+                             SkSamplingOptions(SkFilterMode::kLinear));
+        *drawn = dst.getColor(drawSize / 2, drawSize / 2);
+        return lastDecode;
+    };
+
+    // A 1/4 scale draw decodes at 16x16 rather than the full 64x64.
+    SkColor drawn;
+    REPORTER_ASSERT(r, decoded_size(16, &drawn) == SkISize::Make(16, 16));
+    REPORTER_ASSERT(r, drawn == SK_ColorBLUE);
+
+    // Scales between native sizes round up, so the decode still covers the draw.
+    REPORTER_ASSERT(r, decoded_size(12, &drawn) == SkISize::Make(16, 16));
+    REPORTER_ASSERT(r, drawn == SK_ColorBLUE);
+    REPORTER_ASSERT(r, decoded_size(20, &drawn) == SkISize::Make(32, 32));
+    REPORTER_ASSERT(r, drawn == SK_ColorBLUE);
+
+    // Full-size readback still decodes at full size.
+    SkISize lastDecode = {0, 0};
+    sk_sp<SkImage> image = SkImage::MakeFromGenerator(
+            std::make_unique<ScalingImageGenerator>(&lastDecode));
+    SkBitmap full;
+    REPORTER_ASSERT(r, as_IB(image)->getROPixels(nullptr, &full));
+    REPORTER_ASSERT(r, full.dimensions() == image->dimensions());
+    REPORTER_ASSERT(r, lastDecode == SkISize::Make(64, 64));
+}
+
+namespace {
+// Every pixel of RegionImageGenerator's image has a distinct color.
+SkColor region_pattern(int x, int y) {
+    return SkColorSetARGB(0xFF, x & 0xFF, y & 0xFF, ((x >> 8) << 4) | (y >> 8));
+}
+
+// A large image that can decode any region on its own, counting full and region decodes.
+class RegionImageGenerator : public SkImageGenerator {
+public:
+    RegionImageGenerator(int* fullDecodes, int* subsetDecodes)
+        : INHERITED(SkImageInfo::MakeN32Premul(4096, 4096))
+        , fFullDecodes(fullDecodes)
+        , fSubsetDecodes(subsetDecodes) {}
+
+protected:
+    bool onGetPixels(const SkImageInfo& info, void* pixels, size_t rowBytes,
+                     const Options&) override {
+        *fFullDecodes += 1;
+        return this->fill(SkPixmap(info, pixels, rowBytes), {0, 0});
+    }
+
+    bool onGetSubsetPixels(const SkIRect& subset, const SkPixmap& dst) override {
+        *fSubsetDecodes += 1;
+        return this->fill(dst, subset.topLeft());
+    }
+
+private:
+    bool fill(const SkPixmap& dst, SkIPoint origin) {
+        for (int y = 0; y < dst.height(); ++y) {
+            for (int x = 0; x < dst.width(); ++x) {
+                *dst.writable_addr32(x, y) =
+                        SkPreMultiplyColor(region_pattern(origin.x() + x, origin.y() + y));
+            }
+        }
+        return true;
+    }
+
+    int* fFullDecodes;
+    int* fSubsetDecodes;
+
+    using INHERITED = SkImageGenerator;
+};
+}  // namespace
+
+DEF_TEST(Image_LazySubsetDecode, r) {
+    int fullDecodes = 0,
+        subsetDecodes = 0;
+    sk_sp<SkImage> image = SkImage::MakeFromGenerator(
+            std::make_unique<RegionImageGenerator>(&fullDecodes, &subsetDecodes));
+
+    SkBitmap dst;
+    dst.allocN32Pixels(100, 100);
+    SkCanvas canvas(dst);
+
+    // Draws src 1:1, and checks that every pixel came from the right place in the image.
+    auto draw_and_check = [&](int srcX, int srcY) {
+        canvas.drawImageRect(image, SkRect::Make(SkIRect::MakeXYWH(srcX, srcY, 100, 100)),
+                             SkRect::MakeWH(100, 100), SkSamplingOptions(), nullptr,
+                             SkCanvas::kFast_SrcRectConstraint);
+        for (int y = 0; y < 100; ++y) {
+            for (int x = 0; x < 100; ++x) {
+                if (dst.getColor(x, y) != region_pattern(srcX + x, srcY + y)) {
+                    ERRORF(r, "(%d, %d) does not match the image at (%d, %d)",
+                           x, y, srcX + x, srcY + y);
+                    return;
+                }
+            }
+        }
+    };
+
+    // A small src decodes only the tile under it.
+    draw_and_check(2700, 2700);
+    REPORTER_ASSERT(r, fullDecodes == 0);
+    REPORTER_ASSERT(r, subsetDecodes > 0);
+
+    // Across a tile corner, the tiles are stitched together (twice, to also read the stitched
+    // pixels back from the cache).
+    draw_and_check(3000, 3000);
+    draw_and_check(3000, 3000);
+    REPORTER_ASSERT(r, fullDecodes == 0);
+
+    // Tiles side by side that aren't cached yet are decoded as one band: for generators that
+    // decode whole rows, one region decode per row of tiles instead of one per tile.
+    const int subsetDecodesBefore = subsetDecodes;
+    draw_and_check(3000, 1100);
+    REPORTER_ASSERT(r, subsetDecodes == subsetDecodesBefore + 1);
+    REPORTER_ASSERT(r, fullDecodes == 0);
+
+    // Drawing most of the image decodes all of it.
+    canvas.drawImageRect(image, SkRect::MakeWH(4000, 4000), SkRect::MakeWH(100, 100),
+                         SkSamplingOptions(SkFilterMode::kLinear), nullptr,
+                         SkCanvas::kFast_SrcRectConstraint);
+    REPORTER_ASSERT(r, fullDecodes == 1);
+}
@@ -10,6 +10,7 @@
 #include "include/codec/SkCodecAnimation.h"
 #include "include/core/SkBitmap.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkRect.h"
@@ -17,6 +18,7 @@
 #include "include/core/SkSize.h"
 #include "include/core/SkString.h"
 #include "include/core/SkTypes.h"
+#include "include/private/SkMutex.h"
 #include "include/utils/SkAnimCodecPlayer.h"
 #include "tests/CodecPriv.h"
 #include "tests/Test.h"
@@ -609,3 +611,75 @@ DEF_TEST(AnimCodecPlayer, r) {
                         "Mismatched size for frame at 500 ms of %s", test.fFile);
     }
 }
+
+static void check_decode_frames(skiatest::Reporter* r, const char* file, SkExecutor* executor) {
+    sk_sp<SkData> data = GetResourceAsData(file);
+    if (!data) {
+        return;
+    }
+
+    SkMutex mutex;
+    std::vector<sk_sp<SkImage>> frames;
+    bool success = SkAnimCodecPlayer::DecodeFrames(data, [&](int index, sk_sp<SkImage> frame) {
+        SkAutoMutexExclusive lock(mutex);
+        if (frames.size() <= (size_t)index) {
+            frames.resize(index + 1);
+        }
+        REPORTER_ASSERT(r, !frames[index], "%s: frame %d delivered twice", file, index);
+        frames[index] = std::move(frame);
+    }, executor);
+    REPORTER_ASSERT(r, success, "%s", file);
+
+    // Each frame must match decoding it on its own, letting the codec decode whatever frames
+    // it requires.
+    auto codec = SkCodec::MakeFromData(data);
+    const int frameCount = codec->getFrameCount();
+    REPORTER_ASSERT(r, frames.size() == (size_t)frameCount, "%s", file);
+    for (int i = 0; i < std::min(frameCount, (int)frames.size()); ++i) {
+        SkCodec::FrameInfo frameInfo;
+        SkImageInfo info = codec->getInfo();
+        if (codec->getFrameInfo(i, &frameInfo) &&
+            frameInfo.fAlphaType != kOpaque_SkAlphaType && info.isOpaque()) {
+            info = info.makeAlphaType(kPremul_SkAlphaType);
+        }
+        SkBitmap expected;
+        expected.allocPixels(info);
+        SkCodec::Options options;
+        options.fFrameIndex = i;
+        REPORTER_ASSERT(r, codec->getPixels(expected.pixmap(), &options) == SkCodec::kSuccess);
+
+        SkBitmap actual;
+        REPORTER_ASSERT(r, frames[i] && frames[i]->asLegacyBitmap(&actual));
+        REPORTER_ASSERT(r, ToolUtils::equal_pixels(expected, actual),
+                        "%s: frame %d differs", file, i);
+    }
+}
+
+DEF_TEST(AnimCodecPlayer_DecodeFrames, r) {
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    for (const char* file : { "images/alphabetAnim.gif",
+                              "images/randPixelsAnim.gif",
+                              "images/required.gif",
+                              "images/required.webp",
+                              "images/stoplight.webp" }) {
+        check_decode_frames(r, file, executor.get());
+    }
+}
+
+DEF_TEST(AnimCodecPlayer_DecodeFrames_RestorePrevious, r) {
+    // Frame 1 is independent, but disposed with kRestorePrevious, so frames 2-5 skip it and
+    // require frame 0 instead. They can't be decoded in a separate run starting at frame 1.
+    auto codec = SkCodec::MakeFromData(GetResourceAsData("images/alphabetAnim.gif"));
+    if (!codec) {
+        return;
+    }
+    SkCodec::FrameInfo frameInfo;
+    REPORTER_ASSERT(r, codec->getFrameInfo(1, &frameInfo) &&
+                       frameInfo.fRequiredFrame == SkCodec::kNoFrame &&
+                       frameInfo.fDisposalMethod ==
+                               SkCodecAnimation::DisposalMethod::kRestorePrevious);
+    REPORTER_ASSERT(r, codec->getFrameInfo(2, &frameInfo) && frameInfo.fRequiredFrame == 0);
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    check_decode_frames(r, "images/alphabetAnim.gif", executor.get());
+}
@@ -19,6 +19,7 @@
 #include "include/core/SkColorSpace.h"
 #include "include/core/SkData.h"
 #include "include/core/SkEncodedImageFormat.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkImageEncoder.h"
 #include "include/core/SkImageGenerator.h"
@@ -1839,3 +1840,41 @@ DEF_TEST(Codec_noConversion, r) {
         REPORTER_ASSERT(r, bm.getColor(0, 0) == rec.color);
     }
 }
+
+// Color transforming on an executor, while the codec decodes further rows, must give the same
+// pixels as transforming each row as it is decoded.
+DEF_TEST(Codec_ColorXformExecutor, r) {
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(2);
+    for (const char* path : { "images/webp-color-profile-lossy.webp",
+                              "images/webp-color-profile-lossless.webp",
+                              "images/webp-color-profile-lossy-alpha.webp",
+                              "images/icc-v2-gbr.jpg",
+                              "images/wide_gamut_yellow_224_224_64.jpeg" }) {
+        auto data = GetResourceAsData(path);
+        if (!data) {
+            continue;
+        }
+        for (SkColorType ct : { kN32_SkColorType, kRGBA_F16_SkColorType }) {
+            SkBitmap expected, actual;
+            for (SkBitmap* bm : { &expected, &actual }) {
+                auto codec = SkCodec::MakeFromData(data);
+                if (!codec) {
+                    ERRORF(r, "Failed to create a codec from %s", path);
+                    return;
+                }
+                SkImageInfo info = codec->getInfo().makeColorType(ct)
+                                                   .makeAlphaType(kPremul_SkAlphaType)
+                                                   .makeColorSpace(SkColorSpace::MakeSRGB());
+                bm->allocPixels(info);
+                SkCodec::Options options;
+                if (bm == &actual) {
+                    options.fColorXformExecutor = executor.get();
+                }
+                auto result = codec->getPixels(info, bm->getPixels(), bm->rowBytes(), &options);
+                REPORTER_ASSERT(r, result == SkCodec::kSuccess, "%s: %s", path,
+                                SkCodec::ResultToString(result));
+            }
+            REPORTER_ASSERT(r, ToolUtils::equal_pixels(expected, actual), "%s", path);
+        }
+    }
+}
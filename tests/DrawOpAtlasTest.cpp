@@ -187,6 +187,80 @@ DEF_GPUTEST_FOR_RENDERING_CONTEXTS(BasicDrawOpAtlas, reporter, ctxInfo) {
     check(reporter, atlas.get(), 1, 4, 1);
 }
 
+// Verifies that when compaction moves a plot that is still in use off of the last page, atlases
+// without eviction callbacks relocate its contents rather than evicting them.
+DEF_GPUTEST_FOR_RENDERING_CONTEXTS(DrawOpAtlasRelocation, reporter, ctxInfo) {
+    auto context = ctxInfo.directContext();
+    auto proxyProvider = context->priv().proxyProvider();
+    auto resourceProvider = context->priv().resourceProvider();
+    auto drawingManager = context->priv().drawingManager();
+    const GrCaps* caps = context->priv().caps();
+
+    GrOnFlushResourceProvider onFlushResourceProvider(drawingManager);
+    TestingUploadTarget uploadTarget;
+
+    GrBackendFormat format = caps->getDefaultBackendFormat(GrColorType::kAlpha_8,
+                                                           GrRenderable::kNo);
+
+    GrDrawOpAtlas::GenerationCounter counter;
+
+    std::unique_ptr<GrDrawOpAtlas> atlas = GrDrawOpAtlas::Make(
+                                                proxyProvider,
+                                                format,
+                                                GrColorType::kAlpha_8,
+                                                kAtlasSize, kAtlasSize,
+                                                kAtlasSize/kNumPlots, kAtlasSize/kNumPlots,
+                                                &counter,
+                                                GrDrawOpAtlas::AllowMultitexturing::kYes,
+                                                nullptr);
+
+    // Fill up the first page, then put one plot on the second page.
+    GrDrawOpAtlas::AtlasLocator atlasLocators[kNumPlots * kNumPlots];
+    for (int i = 0; i < kNumPlots * kNumPlots; ++i) {
+        bool result = fill_plot(
+                atlas.get(), resourceProvider, &uploadTarget, &atlasLocators[i], i * 32);
+        REPORTER_ASSERT(reporter, result);
+    }
+    atlas->instantiate(&onFlushResourceProvider);
+
+    GrDrawOpAtlas::AtlasLocator atlasLocator;
+    bool result = fill_plot(atlas.get(), resourceProvider, &uploadTarget, &atlasLocator, 4 * 32);
+    REPORTER_ASSERT(reporter, result);
+    check(reporter, atlas.get(), 2, 4, 2);
+    REPORTER_ASSERT(reporter, atlasLocator.pageIndex() == 1);
+
+    // Only use the plot on the second page. Once the first page has aged out, that plot gets
+    // moved to the first page and the second page is released.
+    int relocations = 0;
+    for (int i = 0; i < 512; ++i) {
+        if (!atlas->hasID(atlasLocator.plotLocator())) {
+            REPORTER_ASSERT(reporter, atlas->relocate(&uploadTarget, &atlasLocator));
+            REPORTER_ASSERT(reporter, atlas->hasID(atlasLocator.plotLocator()));
+            REPORTER_ASSERT(reporter, atlasLocator.pageIndex() == 0);
+            REPORTER_ASSERT(reporter, atlasLocator.width() == kPlotSize);
+            ++relocations;
+        }
+        atlas->setLastUseToken(atlasLocator, uploadTarget.tokenTracker()->nextDrawToken());
+        uploadTarget.issueDrawToken();
+        uploadTarget.flushToken();
+        atlas->compact(uploadTarget.tokenTracker()->nextTokenToFlush());
+    }
+
+    REPORTER_ASSERT(reporter, relocations == 1);
+    check(reporter, atlas.get(), 1, 4, 1);
+#if GR_GPU_STATS
+    REPORTER_ASSERT(reporter, atlas->stats().plotRelocations() == 1);
+    REPORTER_ASSERT(reporter, atlas->stats().pageDeactivations() == 1);
+#endif
+
+    // Locators for evicted plots are not relocated.
+    for (GrDrawOpAtlas::AtlasLocator& evicted : atlasLocators) {
+        if (!atlas->hasID(evicted.plotLocator())) {
+            REPORTER_ASSERT(reporter, !atlas->relocate(&uploadTarget, &evicted));
+        }
+    }
+}
+
 // This test verifies that the GrAtlasTextOp::onPrepare method correctly handles a failure
 // when allocating an atlas page.
 DEF_GPUTEST_FOR_RENDERING_CONTEXTS(GrAtlasTextOpPreparation, reporter, ctxInfo) {
@@ -0,0 +1,172 @@
+/*
+ * Copyright 2021 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkSurface.h"
+#include "include/gpu/GrDirectContext.h"
+#include "src/gpu/GrDirectContextPriv.h"
+#include "src/gpu/GrGpu.h"
+#include "src/gpu/GrPersistentCacheUtils.h"
+#include "src/gpu/GrThreadSafePipelineBuilder.h"
+#include "tests/Test.h"
+#include "tools/gpu/GrContextFactory.h"
+#include "tools/gpu/MemoryCache.h"
+
+#include <atomic>
+#include <thread>
+
+using namespace sk_gpu_test;
+
+// Garbage blobs should be counted as failures, never crash, and never stay pending.
+DEF_GPUTEST(GrShaderPrecompiler_invalidData, reporter, options) {
+    std::unique_ptr<SkExecutor> threadPool = SkExecutor::MakeFIFOThreadPool(2);
+    GrContextOptions contextOptions = options;
+    contextOptions.fExecutor = threadPool.get();
+    GrContextFactory factory(contextOptions);
+
+    auto dContext = factory.get(GrContextFactory::kMock_ContextType);
+    if (!dContext) {
+        return;
+    }
+
+    static constexpr int kCount = 8;
+    for (int i = 0; i < kCount; ++i) {
+        dContext->precompileShaderAsync(SkData::MakeWithCopy(&i, sizeof(i)),
+                                        SkData::MakeWithCString("not a cached shader"));
+    }
+    REPORTER_ASSERT(reporter, dContext->finishPrecompiledShaders(/*waitForAll=*/true) == 0);
+
+    GrDirectContext::PrecompileStats stats = dContext->precompileStats();
+    REPORTER_ASSERT(reporter, stats.fPending == 0);
+    REPORTER_ASSERT(reporter, stats.fSucceeded == 0);
+    REPORTER_ASSERT(reporter, stats.fFailed == kCount);
+}
+
+static bool draw_content(GrDirectContext* dContext) {
+    auto surface = SkSurface::MakeRenderTarget(dContext, SkBudgeted::kNo,
+                                               SkImageInfo::MakeN32Premul(16, 16));
+    if (!surface) {
+        return false;
+    }
+    SkPaint paint;
+    paint.setColor(SK_ColorRED);
+    surface->getCanvas()->drawRect(SkRect::MakeWH(8, 8), paint);
+    paint.setAntiAlias(true);
+    surface->getCanvas()->drawCircle(8, 8, 4, paint);
+    surface->flushAndSubmit();
+    return true;
+}
+
+// Capture SkSL from one GL context, precompile it asynchronously into a fresh one, and check that
+// drawing the same content there uses the precompiled programs instead of compiling new ones.
+DEF_GPUTEST(GrShaderPrecompiler_roundTrip, reporter, options) {
+    MemoryCache memoryCache;
+    GrContextOptions captureOptions = options;
+    captureOptions.fPersistentCache = &memoryCache;
+    captureOptions.fShaderCacheStrategy = GrContextOptions::ShaderCacheStrategy::kSkSL;
+    GrContextFactory captureFactory(captureOptions);
+
+    auto captureContext = captureFactory.get(GrContextFactory::kGL_ContextType);
+    if (!captureContext) {
+        return;
+    }
+    if (!draw_content(captureContext)) {
+        return;
+    }
+
+    std::unique_ptr<SkExecutor> threadPool = SkExecutor::MakeFIFOThreadPool(2);
+    GrContextOptions precompileOptions = captureOptions;
+    precompileOptions.fPersistentCache = nullptr;
+    precompileOptions.fExecutor = threadPool.get();
+    GrContextFactory precompileFactory(precompileOptions);
+
+    auto dContext = precompileFactory.get(GrContextFactory::kGL_ContextType);
+    if (!dContext) {
+        return;
+    }
+
+    int submitted = 0;
+    memoryCache.foreach([&](sk_sp<const SkData> key, sk_sp<SkData> data, const SkString&, int) {
+        dContext->precompileShaderAsync(SkData::MakeWithCopy(key->data(), key->size()),
+                                        std::move(data));
+        ++submitted;
+    });
+    REPORTER_ASSERT(reporter, submitted > 0);
+
+    int succeeded = dContext->finishPrecompiledShaders(/*waitForAll=*/true);
+    REPORTER_ASSERT(reporter, succeeded == submitted, "%d of %d", succeeded, submitted);
+
+    GrDirectContext::PrecompileStats stats = dContext->precompileStats();
+    REPORTER_ASSERT(reporter, stats.fPending == 0);
+    REPORTER_ASSERT(reporter, stats.fSucceeded == submitted);
+    REPORTER_ASSERT(reporter, stats.fFailed == 0);
+
+#if GR_GPU_STATS
+    using CacheResult = GrThreadSafePipelineBuilder::Stats::ProgramCacheResult;
+    GrThreadSafePipelineBuilder::Stats* pipelineStats =
+            dContext->priv().getGpu()->pipelineBuilder()->stats();
+    const int missesBefore   = pipelineStats->numInlineProgramCacheResult(CacheResult::kMiss),
+              partialsBefore = pipelineStats->numInlineProgramCacheResult(CacheResult::kPartial);
+
+    REPORTER_ASSERT(reporter, draw_content(dContext));
+
+    // Every program the draws needed was found precompiled; none was compiled from scratch.
+    REPORTER_ASSERT(reporter,
+                    pipelineStats->numInlineProgramCacheResult(CacheResult::kMiss) == missesBefore);
+    REPORTER_ASSERT(reporter, pipelineStats->numInlineProgramCacheResult(CacheResult::kPartial) >
+                              partialsBefore);
+#endif
+}
+
+namespace {
+// Counts shader errors, and how many were reported off the thread that created it.
+class ThreadCheckingErrorHandler : public GrContextOptions::ShaderErrorHandler {
+public:
+    void compileError(const char*, const char*) override {
+        fErrors++;
+        if (std::this_thread::get_id() != fThread) {
+            fOffThreadErrors++;
+        }
+    }
+
+    const std::thread::id fThread = std::this_thread::get_id();
+    std::atomic<int>      fErrors{0};
+    std::atomic<int>      fOffThreadErrors{0};
+};
+}  // namespace
+
+// SkSL that fails to translate on a worker thread is reported on the context's thread.
+DEF_GPUTEST(GrShaderPrecompiler_errorsOnContextThread, reporter, options) {
+    ThreadCheckingErrorHandler errorHandler;
+    std::unique_ptr<SkExecutor> threadPool = SkExecutor::MakeFIFOThreadPool(2);
+    GrContextOptions contextOptions = options;
+    contextOptions.fExecutor = threadPool.get();
+    contextOptions.fShaderErrorHandler = &errorHandler;
+    GrContextFactory factory(contextOptions);
+
+    auto dContext = factory.get(GrContextFactory::kGL_ContextType);
+    if (!dContext) {
+        return;
+    }
+
+    SkSL::String shaders[kGrShaderTypeCount];
+    shaders[kFragment_GrShaderType] = "void main() { sk_FragColor = undeclared; }";
+    shaders[kVertex_GrShaderType] = "void main() {}";
+    SkSL::Program::Inputs inputs;
+    SkSL::Program::Settings settings;
+    GrPersistentCacheUtils::ShaderMetadata meta;
+    meta.fSettings = &settings;
+    sk_sp<SkData> data = GrPersistentCacheUtils::PackCachedShaders(
+            SkSetFourByteTag('S', 'K', 'S', 'L'), shaders, &inputs, 1, &meta);
+
+    dContext->precompileShaderAsync(SkData::MakeWithCString("key"), std::move(data));
+    REPORTER_ASSERT(reporter, dContext->finishPrecompiledShaders(/*waitForAll=*/true) == 0);
+    REPORTER_ASSERT(reporter, dContext->precompileStats().fFailed == 1);
+    REPORTER_ASSERT(reporter, errorHandler.fErrors.load() == 1);
+    REPORTER_ASSERT(reporter, errorHandler.fOffThreadErrors.load() == 0);
+}
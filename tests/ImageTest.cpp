@@ -22,6 +22,7 @@
 #include "include/core/SkSurface.h"
 #include "include/gpu/GrContextThreadSafeProxy.h"
 #include "include/gpu/GrDirectContext.h"
+#include "include/utils/SkRandom.h"
 #include "src/core/SkAutoPixmapStorage.h"
 #include "src/core/SkColorSpacePriv.h"
 #include "src/core/SkImagePriv.h"
@@ -1340,6 +1341,59 @@ DEF_TEST(ImageScalePixels, reporter) {
     test_scale_pixels(reporter, codecImage.get(), pmRed);
 }
 
+// Cubic scalePixels() between 8888 pixmaps is done with separable filters instead of by drawing.
+// It should agree with drawing through an image shader to within rounding.
+DEF_TEST(ImageScalePixels_Cubic, reporter) {
+    SkBitmap src;
+    src.allocPixels(SkImageInfo::MakeN32Premul(301, 211));
+    SkRandom rand;
+    for (int y = 0; y < src.height(); ++y) {
+        for (int x = 0; x < src.width(); ++x) {
+            // Noise in the corner, gradients elsewhere, so the cubic both overshoots and doesn't.
+            SkColor c = x < 40 && y < 40 ? rand.nextU() | 0x20000000
+                                         : SkColorSetARGB(255 - y, x, 2*x + y, 255 - x/2);
+            *src.getAddr32(x, y) = SkPreMultiplyColor(c);
+        }
+    }
+    src.setImmutable();
+    sk_sp<SkImage> image = src.asImage();
+
+    for (SkCubicResampler cubic : {SkCubicResampler::Mitchell(), SkCubicResampler::CatmullRom()})
+    for (SkColorType ct : {kRGBA_8888_SkColorType, kBGRA_8888_SkColorType})
+    for (SkISize size : {SkISize{100, 70}, SkISize{41, 29}, SkISize{299, 211}, SkISize{640, 480}}) {
+        SkSamplingOptions sampling(cubic);
+        SkImageInfo info = SkImageInfo::Make(size, ct, kPremul_SkAlphaType);
+
+        SkBitmap expected, actual;
+        expected.allocPixels(info);
+        actual.allocPixels(info);
+
+        SkMatrix scale = SkMatrix::RectToRect(SkRect::Make(src.bounds()),
+                                              SkRect::Make(info.bounds()));
+        SkPaint paint;
+        paint.setBlendMode(SkBlendMode::kSrc);
+        paint.setShader(image->makeShader(SkTileMode::kClamp, SkTileMode::kClamp,
+                                          sampling, &scale));
+        SkCanvas(expected).drawPaint(paint);
+
+        REPORTER_ASSERT(reporter, src.pixmap().scalePixels(actual.pixmap(), sampling));
+
+        int maxDiff = 0;
+        for (int y = 0; y < info.height(); ++y) {
+            for (int x = 0; x < info.width(); ++x) {
+                uint32_t e = *expected.getAddr32(x, y),
+                         a = *  actual.getAddr32(x, y);
+                for (int shift = 0; shift < 32; shift += 8) {
+                    maxDiff = std::max(maxDiff, std::abs((int)((e >> shift) & 0xff) -
+                                                         (int)((a >> shift) & 0xff)));
+                }
+            }
+        }
+        REPORTER_ASSERT(reporter, maxDiff <= 1, "B=%g C=%g %dx%d: off by %d",
+                        cubic.B, cubic.C, size.width(), size.height(), maxDiff);
+    }
+}
+
 DEF_GPUTEST_FOR_RENDERING_CONTEXTS(ImageScalePixels_Gpu, reporter, ctxInfo) {
     const SkPMColor pmRed = SkPackARGB32(0xFF, 0xFF, 0, 0);
     const SkColor red = SK_ColorRED;
@@ -12,6 +12,8 @@
 #include "src/core/SkArenaAlloc.h"
 #include "src/utils/SkJSON.h"
 
+#include <vector>
+
 using namespace skjson;
 
 DEF_TEST(JSON_Parse, reporter) {
@@ -50,6 +52,14 @@ DEF_TEST(JSON_Parse, reporter) {
 
         { "[ \"foo"       , nullptr },
         { "[ \"fo\0o\" ]" , nullptr },
+        { "[ \"0123456789abcdef0123456789abcdef" , nullptr },
+        { "[ \"0123456789abcdef0123456789abcdef]", nullptr },
+        { "[ \"0123456789abcdef\x01" "123456789abcdef\" ]", nullptr },
+
+        { "[ 1, 2 }"        , nullptr },
+        { "[ 1, 2 3 ]"      , nullptr },
+        { "[ 1, -, 2 ]"     , nullptr },
+        { "[ 1, 2.5e ]"     , nullptr },
 
         { "{\"\":{}"                  , nullptr },
         { "{ null }"                  , nullptr },
@@ -85,6 +95,13 @@ DEF_TEST(JSON_Parse, reporter) {
         { "[ \"12345678\" ]"             , "[\"12345678\"]" },
         { "[ \"123456789\" ]"            , "[\"123456789\"]" },
         { "[ null , true, false,0,12.8 ]", "[null,true,false,0,12.8]" },
+        { "[ 1,2 , -3.5,\n4 ]"           , "[1,2,-3.5,4]" },
+        { "[ 1, \"a\", -2, null, [3, 4], 5 ]", "[1,\"a\",-2,null,[3,4],5]" },
+        { "[ [1, 2], [-3, 4], [] ]"      , "[[1,2],[-3,4],[]]" },
+        { "[ \"0123456789abcdef0123456789abcdef\" ]",
+          "[\"0123456789abcdef0123456789abcdef\"]" },
+        { "[ \"0123456789abcdef}0123456789[abcdef]\" ]",
+          "[\"0123456789abcdef}0123456789[abcdef]\"]" },
 
         { "{}"                          , "{}" },
         { " \n\r\t { \n\r\t } \n\r\t "  , "{}" },
@@ -128,6 +145,8 @@ DEF_TEST(JSON_Parse, reporter) {
         {R"zzz(["foo\rbar"])zzz"    , "[\"foo\rbar\"]"},
         {R"zzz(["foo\tbar"])zzz"    , "[\"foo\tbar\"]"},
         {R"zzz(["foo\u1234bar"])zzz", "[\"foo\u1234bar\"]"},
+        {R"zzz(["0123456789abcdef0123456789\nabcdef"])zzz",
+            "[\"0123456789abcdef0123456789\nabcdef\"]"},
     };
 
     for (const auto& tst : g_tests) {
@@ -146,6 +165,114 @@ DEF_TEST(JSON_Parse, reporter) {
 
 }
 
+DEF_TEST(JSON_Visitor, reporter) {
+    // Re-serializes the event stream using the DOM writer conventions.
+    class WriterVisitor final : public Visitor {
+    public:
+        explicit WriterVisitor(SkWStream* stream) : fStream(stream) {}
+
+    private:
+        void onBeginObject() override { this->beginValue(); this->beginScope("{"); }
+        void onEndObject()   override { this->endScope("}"); }
+        void onBeginArray()  override { this->beginValue(); this->beginScope("["); }
+        void onEndArray()    override { this->endScope("]"); }
+
+        void onKey(const char key[], size_t size) override {
+            this->beginValue();
+            this->writeString(key, size);
+            fStream->writeText(":");
+            fPendingMember = true;
+        }
+
+        void onString(const char s[], size_t size) override {
+            this->beginValue();
+            this->writeString(s, size);
+        }
+        void onInt32(int32_t i) override {
+            this->beginValue();
+            fStream->writeScalarAsText(i);
+        }
+        void onFloat(float f) override {
+            this->beginValue();
+            fStream->writeScalarAsText(f);
+        }
+        void onBool(bool b) override {
+            this->beginValue();
+            fStream->writeText(b ? "true" : "false");
+        }
+        void onNull() override {
+            this->beginValue();
+            fStream->writeText("null");
+        }
+
+        void beginValue() {
+            if (fPendingMember) {
+                // Member values follow their key, with no separator.
+                fPendingMember = false;
+                return;
+            }
+            if (!fFirstInScope.empty()) {
+                if (!fFirstInScope.back()) {
+                    fStream->writeText(",");
+                }
+                fFirstInScope.back() = false;
+            }
+        }
+
+        void beginScope(const char token[]) {
+            fStream->writeText(token);
+            fFirstInScope.push_back(true);
+        }
+
+        void endScope(const char token[]) {
+            fStream->writeText(token);
+            fFirstInScope.pop_back();
+        }
+
+        void writeString(const char s[], size_t size) {
+            fStream->writeText("\"");
+            fStream->write(s, size);
+            fStream->writeText("\"");
+        }
+
+        SkWStream*        fStream;
+        std::vector<bool> fFirstInScope;
+        bool              fPendingMember = false;
+    };
+
+    static constexpr const char* g_tests[] = {
+        "",
+        "[",
+        "[1,,2]",
+        "{ \"k\" : null \"k\" : 1 }",
+        "{}",
+        "[[]]",
+        "[ null , true, false,0,12.8, -7, \"foo\" ]",
+        "{ \"k1\" : null, \"k1\":0 }",
+        "{ \"a\": { \"b\": [ 1, { \"c\": [] } ], \"d\": \"123456789\" }, \"e\": [[], {}] }",
+        R"zzz(["foo\"bar", "foo\u1234bar", { "k\n": "\t" }])zzz",
+    };
+
+    for (const auto* tst : g_tests) {
+        const auto size = strlen(tst);
+        const DOM dom(tst, size);
+
+        SkDynamicMemoryWStream visitor_stream;
+        WriterVisitor visitor(&visitor_stream);
+        const auto success = Parse(tst, size, &visitor);
+
+        REPORTER_ASSERT(reporter, success == !dom.root().is<NullValue>(), "%s", tst);
+        if (!success) continue;
+
+        SkDynamicMemoryWStream dom_stream;
+        dom.write(&dom_stream);
+
+        const auto dom_data     = dom_stream.detachAsData(),
+                   visitor_data = visitor_stream.detachAsData();
+        REPORTER_ASSERT(reporter, dom_data->equals(visitor_data.get()), "%s", tst);
+    }
+}
+
 template <typename T, typename VT>
 static void check_primitive(skiatest::Reporter* reporter, const Value& v, T pv,
                             bool is_type) {
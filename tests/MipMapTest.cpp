@@ -6,6 +6,8 @@
  */
 
 #include "include/core/SkBitmap.h"
+#include "include/core/SkExecutor.h"
+#include "include/private/SkHalf.h"
 #include "include/utils/SkRandom.h"
 #include "src/core/SkMipmap.h"
 #include "tests/Test.h"
@@ -211,6 +213,133 @@ DEF_TEST(MipMap_F16, reporter) {
     sk_sp<SkMipmap> mipmap(SkMipmap::Build(bmp, nullptr));
 }
 
+// The 2x2 kernels and banded (multi-threaded) filtering must match a straightforward box filter.
+DEF_TEST(MipMap_BoxFilter_Threaded, reporter) {
+    auto executor = SkExecutor::MakeFIFOThreadPool(4);
+    SkRandom rand;
+
+    for (SkColorType ct : { kRGBA_8888_SkColorType, kAlpha_8_SkColorType }) {
+        // Even dimensions, so the first level uses the 2x2 filter, and large enough to be banded.
+        // 1062 isn't a multiple of any vector width, to exercise the tails too.
+        SkBitmap bmp;
+        bmp.allocPixels(SkImageInfo::Make(1062, 640, ct, kPremul_SkAlphaType));
+        const SkPixmap& src = bmp.pixmap();
+        for (int y = 0; y < src.height(); ++y) {
+            auto row = static_cast<uint8_t*>(src.writable_addr(0, y));
+            for (size_t x = 0; x < src.info().minRowBytes(); ++x) {
+                row[x] = rand.nextU() & 0xff;
+            }
+        }
+
+        sk_sp<SkMipmap> threaded(SkMipmap::Build(src, nullptr, true, executor.get()));
+        sk_sp<SkMipmap> serial(SkMipmap::Build(bmp, nullptr));
+        REPORTER_ASSERT(reporter, threaded && serial);
+        if (!threaded || !serial) {
+            continue;
+        }
+
+        for (int i = 0; i < threaded->countLevels(); ++i) {
+            SkMipmap::Level a, b;
+            threaded->getLevel(i, &a);
+            serial->getLevel(i, &b);
+            for (int y = 0; y < a.fPixmap.height(); ++y) {
+                REPORTER_ASSERT(reporter, !memcmp(a.fPixmap.addr(0, y), b.fPixmap.addr(0, y),
+                                                  a.fPixmap.info().minRowBytes()),
+                                "level %d row %d", i, y);
+            }
+        }
+
+        SkMipmap::Level level;
+        threaded->getLevel(0, &level);
+        const int bpp = src.info().bytesPerPixel();
+        for (int y = 0; y < level.fPixmap.height(); ++y) {
+            auto d  = static_cast<const uint8_t*>(level.fPixmap.addr(0, y));
+            auto s0 = static_cast<const uint8_t*>(src.addr(0, 2 * y));
+            auto s1 = static_cast<const uint8_t*>(src.addr(0, 2 * y + 1));
+            for (int x = 0; x < level.fPixmap.width() * bpp; ++x) {
+                int c = x % bpp,
+                    p = 2 * (x - c) + c;
+                int expected = (s0[p] + s0[p + bpp] + s1[p] + s1[p + bpp]) >> 2;
+                if (d[x] != expected) {
+                    ERRORF(reporter, "ct %d (%d, %d): %d != %d", ct, x / bpp, y, d[x], expected);
+                    return;
+                }
+            }
+        }
+    }
+}
+
+// Same for F16, which must match the serial SkHalfToFloat_finite_ftz() / SkFloatToHalf_finite_ftz()
+// box filter bit for bit, including the sign of zeros and flushed denormals.
+DEF_TEST(MipMap_BoxFilter_F16_Threaded, reporter) {
+    auto executor = SkExecutor::MakeFIFOThreadPool(4);
+    SkRandom rand;
+
+    SkBitmap bmp;
+    bmp.allocPixels(SkImageInfo::Make(1062, 640, kRGBA_F16_SkColorType, kPremul_SkAlphaType));
+    const SkPixmap& src = bmp.pixmap();
+    for (int y = 0; y < src.height(); ++y) {
+        auto row = static_cast<uint16_t*>(src.writable_addr(0, y));
+        for (int x = 0; x < 4 * src.width(); ++x) {
+            uint16_t h = rand.nextU() & 0xffff;
+            if ((h & 0x7c00) == 0x7c00) {
+                h &= ~0x4000;  // Keep it finite.
+            }
+            row[x] = h;
+        }
+    }
+    // Every few 2x2 blocks is all -0 and negative denormals, which should average to -0.
+    for (int y = 0; y + 1 < src.height(); y += 2) {
+        for (int x = 2 * ((y / 2) % 5); x + 1 < src.width(); x += 10) {
+            for (int j = 0; j < 2; ++j) {
+                auto px = static_cast<uint16_t*>(src.writable_addr(x, y + j));
+                for (int i = 0; i < 8; ++i) {
+                    px[i] = 0x8000 | (rand.nextU() & 1 ? 0 : rand.nextU() & 0x3ff);
+                }
+            }
+        }
+    }
+
+    sk_sp<SkMipmap> threaded(SkMipmap::Build(src, nullptr, true, executor.get()));
+    sk_sp<SkMipmap> serial(SkMipmap::Build(bmp, nullptr));
+    REPORTER_ASSERT(reporter, threaded && serial);
+    if (!threaded || !serial) {
+        return;
+    }
+
+    for (int i = 0; i < threaded->countLevels(); ++i) {
+        SkMipmap::Level a, b;
+        threaded->getLevel(i, &a);
+        serial->getLevel(i, &b);
+        for (int y = 0; y < a.fPixmap.height(); ++y) {
+            REPORTER_ASSERT(reporter, !memcmp(a.fPixmap.addr(0, y), b.fPixmap.addr(0, y),
+                                              a.fPixmap.info().minRowBytes()),
+                            "level %d row %d", i, y);
+        }
+    }
+
+    SkMipmap::Level level;
+    threaded->getLevel(0, &level);
+    for (int y = 0; y < level.fPixmap.height(); ++y) {
+        auto d  = level.fPixmap.addr64(0, y);
+        auto s0 = src.addr64(0, 2 * y);
+        auto s1 = src.addr64(0, 2 * y + 1);
+        for (int x = 0; x < level.fPixmap.width(); ++x) {
+            Sk4f c = SkHalfToFloat_finite_ftz(s0[2 * x    ]) +
+                     SkHalfToFloat_finite_ftz(s1[2 * x    ]) +
+                     SkHalfToFloat_finite_ftz(s0[2 * x + 1]) +
+                     SkHalfToFloat_finite_ftz(s1[2 * x + 1]);
+            uint64_t expected;
+            SkFloatToHalf_finite_ftz(c * 0.25f).store(&expected);
+            if (d[x] != expected) {
+                ERRORF(reporter, "(%d, %d): %016llx != %016llx", x, y,
+                       (unsigned long long)d[x], (unsigned long long)expected);
+                return;
+            }
+        }
+    }
+}
+
 #include "include/core/SkCanvas.h"
 #include "include/core/SkSurface.h"
 #include "src/core/SkMipmapBuilder.h"
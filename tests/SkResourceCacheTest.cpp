@@ -6,16 +6,23 @@
  */
 
 #include "include/core/SkCanvas.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkGraphics.h"
+#include "include/core/SkImageGenerator.h"
 #include "include/core/SkPicture.h"
 #include "include/core/SkPictureRecorder.h"
 #include "include/core/SkSurface.h"
 #include "src/core/SkBitmapCache.h"
 #include "src/core/SkMipmap.h"
+#include "src/core/SkOSFile.h"
 #include "src/core/SkResourceCache.h"
+#include "src/core/SkResourceDiskCache.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/image/SkImage_Base.h"
 #include "src/lazy/SkDiscardableMemoryPool.h"
+#include "src/utils/SkOSPath.h"
 #include "tests/Test.h"
+#include "tools/ToolUtils.h"
 
 ////////////////////////////////////////////////////////////////////////////////////////
 
@@ -289,3 +296,298 @@ DEF_TEST(ResourceCache_purge, reporter) {
         }
     }
 }
+
+namespace {
+struct ValueRec : SkResourceCache::Rec {
+    TestKey fKey;
+
+    ValueRec(int sharedID, int32_t value) : fKey(sharedID, value) {}
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override { return sizeof(*this); }
+    const char* getCategory() const override { return "test-category"; }
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* context) {
+        *static_cast<int32_t*>(context) = static_cast<const ValueRec&>(baseRec).fKey.fData;
+        return true;
+    }
+    static bool StaleVisitor(const SkResourceCache::Rec&, void*) {
+        return false;
+    }
+};
+}  // namespace
+
+DEF_TEST(ResourceCache_Sharded, reporter) {
+    // Lookups in the global cache run concurrently. Add and find from several threads at once,
+    // each with its own keys; whatever is found (other tests may purge) must be the right rec.
+    static constexpr int kSharedID = 0x5ad;
+    static constexpr int kThreads = 4, kKeysPerThread = 1000;
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(kThreads);
+    std::atomic<int> hits{0}, wrongValues{0};
+    SkTaskGroup(*executor).batch(kThreads, [&](int thread) {
+        for (int i = 0; i < kKeysPerThread; ++i) {
+            SkResourceCache::Add(new ValueRec(kSharedID, thread * kKeysPerThread + i));
+            for (int j = i; j >= 0; j -= 37) {
+                const int32_t expected = thread * kKeysPerThread + j;
+                int32_t found = -1;
+                if (SkResourceCache::Find(TestKey(kSharedID, expected), ValueRec::Visitor,
+                                          &found)) {
+                    hits++;
+                    wrongValues += found != expected;
+                }
+            }
+        }
+    });
+    REPORTER_ASSERT(reporter, hits > 0);
+    REPORTER_ASSERT(reporter, wrongValues == 0);
+
+    // A rec its visitor calls stale is removed.
+    SkResourceCache::Add(new ValueRec(kSharedID, -1));
+    int32_t found;
+    REPORTER_ASSERT(reporter, SkResourceCache::Find(TestKey(kSharedID, -1), ValueRec::Visitor,
+                                                    &found));
+    REPORTER_ASSERT(reporter, !SkResourceCache::Find(TestKey(kSharedID, -1),
+                                                     ValueRec::StaleVisitor, &found));
+    REPORTER_ASSERT(reporter, !SkResourceCache::Find(TestKey(kSharedID, -1), ValueRec::Visitor,
+                                                     &found));
+
+    SkResourceCache::PostPurgeSharedID(kSharedID);
+}
+
+DEF_TEST(ResourceCache_ShardedBudget, reporter) {
+    using Shards = SkResourceCache::Shards;
+    static constexpr int kSharedID = 0x5ad;
+    static constexpr size_t kRecsInBudget = 8 * Shards::kCount;
+    const size_t limit = kRecsInBudget * sizeof(ValueRec);
+
+    // Adds a rec whose key is (or isn't) in shard 0.
+    int32_t nextValue = 0;
+    auto add = [&](Shards* shards, bool inShard0) {
+        while ((Shards::IndexFor(TestKey(kSharedID, nextValue)) == 0) != inShard0) {
+            nextValue++;
+        }
+        shards->add(new ValueRec(kSharedID, nextValue++), nullptr);
+    };
+
+    {
+        // While the others are empty, one shard can grow to the whole budget...
+        Shards shards(limit);
+        for (size_t i = 0; i < kRecsInBudget; ++i) {
+            add(&shards, true);
+        }
+        REPORTER_ASSERT(reporter, shards.getTotalBytesUsed() > limit / 2);
+        REPORTER_ASSERT(reporter, shards.getTotalBytesUsed() <= limit);
+
+        // ... but as they fill up, it's trimmed, keeping the total within the budget.
+        for (size_t i = 0; i < 4 * kRecsInBudget; ++i) {
+            add(&shards, false);
+            REPORTER_ASSERT(reporter, shards.getTotalBytesUsed() <= limit);
+        }
+    }
+    {
+        // A rec that's hit between adds survives any number of them, while older unused recs
+        // are purged.
+        Shards shards(limit);
+        shards.add(new ValueRec(kSharedID, -1), nullptr);
+        for (size_t i = 0; i < 4 * kRecsInBudget; ++i) {
+            add(&shards, i % 2 == 0);
+            int32_t found;
+            REPORTER_ASSERT(reporter, shards.find(TestKey(kSharedID, -1), ValueRec::Visitor,
+                                                  &found) && found == -1);
+        }
+        REPORTER_ASSERT(reporter, shards.getTotalBytesUsed() <= limit);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+static bool find_in_disk_cache(SkResourceDiskCache* cache, const SkData& key,
+                               const SkData& expectedMeta, const SkData& expectedContents) {
+    sk_sp<SkData> meta, contents;
+    return cache->find(key, &meta, &contents) &&
+           meta->equals(&expectedMeta) && contents->equals(&expectedContents);
+}
+
+static sk_sp<SkData> make_contents(uint8_t value) {
+    sk_sp<SkData> data = SkData::MakeUninitialized(1000);
+    memset(data->writable_data(), value, data->size());
+    return data;
+}
+
+DEF_TEST(ResourceDiskCache, reporter) {
+    SkString tmpDir = skiatest::GetTmpDir();
+    if (tmpDir.isEmpty()) {
+        return;
+    }
+    SkString dir = SkOSPath::Join(tmpDir.c_str(), "resource_disk_cache");
+    // Start empty, whatever an earlier run left behind.
+    if (auto cache = SkResourceDiskCache::Make(dir.c_str(), 1 << 20)) {
+        cache->purgeAll();
+    }
+
+    sk_sp<SkData> key1 = SkData::MakeWithCString("key1"),
+                  key2 = SkData::MakeWithCString("key2"),
+                  key3 = SkData::MakeWithCString("key3"),
+                  meta = SkData::MakeWithCString("meta"),
+                  contents1 = make_contents(0xAB),
+                  contents2 = make_contents(0xCD),
+                  contents3 = make_contents(0xEF);
+    {
+        auto cache = SkResourceDiskCache::Make(dir.c_str(), 1 << 20);
+        REPORTER_ASSERT(reporter, cache);
+        cache->add(*key1, meta, contents1);
+        // Pending writes are visible right away...
+        REPORTER_ASSERT(reporter, find_in_disk_cache(cache.get(), *key1, *meta, *contents1));
+        cache->flush();
+        // ... and once written, come back from the file.
+        REPORTER_ASSERT(reporter, find_in_disk_cache(cache.get(), *key1, *meta, *contents1));
+        REPORTER_ASSERT(reporter, !find_in_disk_cache(cache.get(), *key2, *meta, *contents1));
+        REPORTER_ASSERT(reporter, cache->count() == 1);
+    }
+    {
+        // Entries outlive the cache object that wrote them.
+        auto cache = SkResourceDiskCache::Make(dir.c_str(), 1 << 20);
+        REPORTER_ASSERT(reporter, cache->count() == 1);
+        REPORTER_ASSERT(reporter, find_in_disk_cache(cache.get(), *key1, *meta, *contents1));
+        cache->purgeAll();
+        REPORTER_ASSERT(reporter, cache->count() == 0);
+        REPORTER_ASSERT(reporter, cache->getTotalBytesUsed() == 0);
+        REPORTER_ASSERT(reporter, !find_in_disk_cache(cache.get(), *key1, *meta, *contents1));
+    }
+    {
+        // Room for two entries, but not three: the least recently used one goes.
+        auto cache = SkResourceDiskCache::Make(dir.c_str(), 2500);
+        cache->add(*key1, meta, contents1);
+        cache->add(*key2, meta, contents2);
+        cache->flush();
+        REPORTER_ASSERT(reporter, find_in_disk_cache(cache.get(), *key1, *meta, *contents1));
+        cache->add(*key3, meta, contents3);
+        cache->flush();
+        REPORTER_ASSERT(reporter, cache->count() == 2);
+        REPORTER_ASSERT(reporter, cache->getTotalBytesUsed() <= cache->getTotalByteLimit());
+        REPORTER_ASSERT(reporter, !find_in_disk_cache(cache.get(), *key2, *meta, *contents2));
+        REPORTER_ASSERT(reporter, find_in_disk_cache(cache.get(), *key3, *meta, *contents3));
+        REPORTER_ASSERT(reporter, find_in_disk_cache(cache.get(), *key1, *meta, *contents1));
+    }
+    {
+        // The recency order is restored too: key3 is now the oldest.
+        auto cache = SkResourceDiskCache::Make(dir.c_str(), 2500);
+        REPORTER_ASSERT(reporter, cache->count() == 2);
+        cache->add(*key2, meta, contents2);
+        cache->flush();
+        REPORTER_ASSERT(reporter, find_in_disk_cache(cache.get(), *key1, *meta, *contents1));
+        REPORTER_ASSERT(reporter, find_in_disk_cache(cache.get(), *key2, *meta, *contents2));
+        REPORTER_ASSERT(reporter, !find_in_disk_cache(cache.get(), *key3, *meta, *contents3));
+        cache->purgeAll();
+    }
+    {
+        // A recent temporary file may be another process's write in progress, so it's kept.
+        SkString temp = SkOSPath::Join(dir.c_str(), "0123456789abcdef.skrc.other.0.tmp");
+        if (FILE* file = sk_fopen(temp.c_str(), kWrite_SkFILE_Flag)) {
+            sk_fclose(file);
+            auto cache = SkResourceDiskCache::Make(dir.c_str(), 2500);
+            REPORTER_ASSERT(reporter, cache && cache->count() == 0);
+            REPORTER_ASSERT(reporter, sk_exists(temp.c_str()));
+            remove(temp.c_str());
+        }
+    }
+}
+
+namespace {
+// Stands in for a codec: has encoded data, and counts its decodes.
+class EncodedImageGenerator : public SkImageGenerator {
+public:
+    EncodedImageGenerator(sk_sp<SkData> encoded, int* decodeCount)
+        : INHERITED(SkImageInfo::MakeN32Premul(32, 32))
+        , fEncoded(std::move(encoded))
+        , fDecodeCount(decodeCount) {}
+
+protected:
+    sk_sp<SkData> onRefEncodedData() override { return fEncoded; }
+
+    bool onGetPixels(const SkImageInfo& info, void* pixels, size_t rowBytes,
+                     const Options&) override {
+        *fDecodeCount += 1;
+        for (int y = 0; y < info.height(); ++y) {
+            uint32_t* row = (uint32_t*)((char*)pixels + y * rowBytes);
+            for (int x = 0; x < info.width(); ++x) {
+                row[x] = SkPackARGB32(0xFF, x * 8, y * 8, fEncoded->bytes()[0]);
+            }
+        }
+        return true;
+    }
+
+private:
+    sk_sp<SkData> fEncoded;
+    int*          fDecodeCount;
+
+    using INHERITED = SkImageGenerator;
+};
+}  // namespace
+
+DEF_TEST(ResourceDiskCache_LazyImage, reporter) {
+    SkString tmpDir = skiatest::GetTmpDir();
+    if (tmpDir.isEmpty()) {
+        return;
+    }
+    // The disk cache backs a local resource cache, so that other tests (which use the global
+    // one) neither see it nor get purged.
+    SkString dir = SkOSPath::Join(tmpDir.c_str(), "resource_disk_cache_images");
+    std::unique_ptr<SkResourceDiskCache> diskCache =
+            SkResourceDiskCache::Make(dir.c_str(), 16 << 20);
+    if (!diskCache) {
+        return;
+    }
+    diskCache->purgeAll();
+
+    sk_sp<SkData> encoded = SkData::MakeWithCString("some encoded image");
+    int expectedLevels;
+    SkBitmap expectedLevel0;
+    {
+        SkResourceCache cache(1 << 20);
+        cache.setDiskCache(diskCache.get());
+        int decodes = 0;
+        sk_sp<SkImage> image = SkImage::MakeFromGenerator(
+                std::make_unique<EncodedImageGenerator>(encoded, &decodes));
+        sk_sp<const SkMipmap> mipmap(SkMipmapCache::AddAndRef(as_IB(image), &cache));
+        REPORTER_ASSERT(reporter, mipmap);
+        REPORTER_ASSERT(reporter, decodes == 1);
+        expectedLevels = mipmap->countLevels();
+        SkMipmap::Level level;
+        REPORTER_ASSERT(reporter, mipmap->getLevel(0, &level));
+        REPORTER_ASSERT(reporter, expectedLevel0.tryAllocPixels(level.fPixmap.info()) &&
+                                  expectedLevel0.writePixels(level.fPixmap));
+    }
+    diskCache->flush();
+    REPORTER_ASSERT(reporter, diskCache->count() == 1);
+
+    // A new image of the same encoded data, in a new memory cache (as if in a new process),
+    // finds the levels on disk without decoding.
+    {
+        SkResourceCache cache(1 << 20);
+        cache.setDiskCache(diskCache.get());
+        int decodes = 0;
+        sk_sp<SkImage> image = SkImage::MakeFromGenerator(
+                std::make_unique<EncodedImageGenerator>(encoded, &decodes));
+        sk_sp<const SkMipmap> mipmap(SkMipmapCache::AddAndRef(as_IB(image), &cache));
+        REPORTER_ASSERT(reporter, mipmap && mipmap->countLevels() == expectedLevels);
+        SkMipmap::Level level;
+        REPORTER_ASSERT(reporter, mipmap && mipmap->getLevel(0, &level) &&
+                                  ToolUtils::equal_pixels(level.fPixmap, expectedLevel0.pixmap()));
+        REPORTER_ASSERT(reporter, decodes == 0);
+    }
+
+    // Different encoded data doesn't.
+    {
+        SkResourceCache cache(1 << 20);
+        cache.setDiskCache(diskCache.get());
+        int decodes = 0;
+        sk_sp<SkImage> image = SkImage::MakeFromGenerator(std::make_unique<EncodedImageGenerator>(
+                SkData::MakeWithCString("other encoded image"), &decodes));
+        sk_sp<const SkMipmap> mipmap(SkMipmapCache::AddAndRef(as_IB(image), &cache));
+        REPORTER_ASSERT(reporter, mipmap);
+        REPORTER_ASSERT(reporter, decodes == 1);
+    }
+
+    diskCache->purgeAll();
+}
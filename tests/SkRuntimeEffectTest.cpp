@@ -10,9 +10,11 @@
 #include "include/core/SkColorFilter.h"
 #include "include/core/SkData.h"
 #include "include/core/SkPaint.h"
+#include "include/core/SkString.h"
 #include "include/core/SkSurface.h"
 #include "include/effects/SkRuntimeEffect.h"
 #include "include/gpu/GrDirectContext.h"
+#include "src/core/SkRuntimeEffectCache.h"
 #include "src/core/SkTLazy.h"
 #include "src/gpu/GrColor.h"
 #include "tests/Test.h"
@@ -356,8 +358,8 @@ DEF_TEST(SkRuntimeShaderBuilderSetUniforms, r) {
 }
 
 DEF_TEST(SkRuntimeEffectThreaded, r) {
-    // SkRuntimeEffect uses a single compiler instance, but it's mutex locked.
-    // This tests that we can safely use it from more than one thread, and also
+    // SkRuntimeEffect hands out pooled compiler instances, one per concurrent Make().
+    // This tests that we can safely use them from more than one thread, and also
     // that programs don't refer to shared structures owned by the compiler.
     // skbug.com/10589
     static constexpr char kSource[] = "half4 main() { return sk_FragCoord.xyxy; }";
@@ -375,6 +377,71 @@ DEF_TEST(SkRuntimeEffectThreaded, r) {
     }
 }
 
+DEF_TEST(SkRuntimeEffectCache, r) {
+    // Make() goes through the global cache, which other tests share, so only check what can't
+    // depend on what else is in it.
+    static constexpr char kSourceA[] = "half4 main() { return half4(0.125, 0, 0, 1); }";
+    SkRuntimeEffect::Options options;
+    options.inlineThreshold = 1;
+    auto a1 = SkRuntimeEffect::Make(SkString(kSourceA)).effect;
+    auto a2 = SkRuntimeEffect::Make(SkString(kSourceA), options).effect;
+    REPORTER_ASSERT(r, a1 && a2 && a1 != a2);
+
+    // The rest uses a private, single-shard cache, so the budget applies exactly.
+    auto make = [&](float red) {
+        SkString sksl = SkStringPrintf("half4 main() { return half4(%g, 0, 0, 1); }", red);
+        auto effect = SkRuntimeEffect::Make(sksl).effect;
+        REPORTER_ASSERT(r, effect);
+        return std::make_pair(SkRuntimeEffectCache::Key(sksl, SkRuntimeEffect::Options()),
+                              effect);
+    };
+    auto [keyA, effectA] = make(0.25f);
+    auto [keyB, effectB] = make(0.375f);
+    auto [keyC, effectC] = make(0.5f);
+    const size_t sizeA = SkRuntimeEffectCache::ApproximateSize(*effectA),
+                 sizeB = SkRuntimeEffectCache::ApproximateSize(*effectB),
+                 sizeC = SkRuntimeEffectCache::ApproximateSize(*effectC);
+
+    // Room for any two of them, but not all three.
+    SkRuntimeEffectCache cache(std::max({sizeA + sizeB, sizeA + sizeC, sizeB + sizeC}), 1);
+    REPORTER_ASSERT(r, cache.byteLimit() < sizeA + sizeB + sizeC);
+
+    cache.insert(keyA, effectA);
+    cache.insert(keyB, effectB);
+    REPORTER_ASSERT(r, cache.find(keyA) == effectA);  // A is now more recent than B.
+    REPORTER_ASSERT(r, cache.find(keyB) == effectB);  // ... and now B than A.
+    REPORTER_ASSERT(r, cache.find(keyA) == effectA);
+    REPORTER_ASSERT(r, cache.bytesUsed() == sizeA + sizeB);
+
+    // Adding C evicts the least recently used entry, B.
+    cache.insert(keyC, effectC);
+    REPORTER_ASSERT(r, cache.count() == 2);
+    REPORTER_ASSERT(r, !cache.find(keyB));
+    REPORTER_ASSERT(r, cache.find(keyA) == effectA);
+    REPORTER_ASSERT(r, cache.find(keyC) == effectC);
+    REPORTER_ASSERT(r, cache.bytesUsed() == sizeA + sizeC);
+
+    // Re-inserting the same key replaces the entry rather than double-counting it.
+    cache.insert(keyC, effectC);
+    REPORTER_ASSERT(r, cache.count() == 2);
+    REPORTER_ASSERT(r, cache.bytesUsed() == sizeA + sizeC);
+
+    // Lowering the limit purges immediately, and nothing is retained while it is zero.
+    size_t prevLimit = cache.setByteLimit(0);
+    REPORTER_ASSERT(r, cache.byteLimit() == 0);
+    REPORTER_ASSERT(r, cache.bytesUsed() == 0 && cache.count() == 0);
+    cache.insert(keyA, effectA);
+    REPORTER_ASSERT(r, !cache.find(keyA));
+    REPORTER_ASSERT(r, cache.bytesUsed() == 0);
+
+    REPORTER_ASSERT(r, cache.setByteLimit(prevLimit) == 0);
+    cache.insert(keyA, effectA);
+    REPORTER_ASSERT(r, cache.find(keyA) == effectA);
+
+    cache.purgeAll();
+    REPORTER_ASSERT(r, cache.bytesUsed() == 0 && cache.count() == 0);
+}
+
 DEF_TEST(SkRuntimeColorFilterSingleColor, r) {
     // Test runtime colorfilters support filterColor4f().
     auto [effect, err] = SkRuntimeEffect::Make(SkString{
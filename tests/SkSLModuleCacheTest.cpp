@@ -0,0 +1,118 @@
+/*
+ * Copyright 2021 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkTaskGroup.h"
+#include "src/sksl/SkSLCompiler.h"
+
+#include "tests/Test.h"
+
+using ModuleSharing = SkSL::Compiler::ModuleSharing;
+
+DEF_TEST(SkSLModuleCacheSharing, r) {
+    SkSL::ShaderCapsPointer caps = SkSL::ShaderCapsFactory::Default();
+    SkSL::ShaderCapsPointer sameCaps = SkSL::ShaderCapsFactory::Default();
+    // Unlike Default(), Standalone() has no builtin determinant support.
+    SkSL::ShaderCapsPointer otherCaps = SkSL::ShaderCapsFactory::Standalone();
+
+    SkSL::Compiler a(caps.get());
+    SkSL::Compiler b(sameCaps.get());
+    SkSL::Compiler c(otherCaps.get());
+    SkSL::Compiler d(caps.get(), ModuleSharing::kPrivate);
+
+    auto fragSymbols = [](SkSL::Compiler& compiler) {
+        return compiler.moduleForProgramKind(SkSL::ProgramKind::kFragment).fSymbols.get();
+    };
+    // Equal caps share modules and built-in types; caps baked into the modules (via sk_Caps)
+    // select a different set.
+    REPORTER_ASSERT(r, fragSymbols(a) == fragSymbols(b));
+    REPORTER_ASSERT(r, a.context().fTypes.fFloat.get() == b.context().fTypes.fFloat.get());
+    REPORTER_ASSERT(r, fragSymbols(a) != fragSymbols(c));
+    REPORTER_ASSERT(r, fragSymbols(a) != fragSymbols(d));
+}
+
+DEF_TEST(SkSLModuleCacheErrors, r) {
+    SkSL::ShaderCapsPointer caps = SkSL::ShaderCapsFactory::Default();
+    SkSL::Compiler a(caps.get());
+    SkSL::Compiler b(caps.get());
+    SkSL::Program::Settings settings;
+
+    REPORTER_ASSERT(r, a.convertProgram(SkSL::ProgramKind::kFragment,
+                                        "void main() { sk_FragColor = half4(1); }", settings));
+
+    // Errors found while compiling with 'b' must be reported by 'b', even though its modules were
+    // loaded by another compiler.
+    REPORTER_ASSERT(r, !b.convertProgram(SkSL::ProgramKind::kFragment,
+                                         "half x; half x; void main() {}", settings));
+    REPORTER_ASSERT(r, b.errorCount() > 0);
+    REPORTER_ASSERT(r, a.errorCount() == 0);
+}
+
+DEF_TEST(SkSLModuleCacheThreaded, r) {
+    static constexpr int kThreads = 4;
+    static constexpr char kSrc[] =
+            "uniform half4 color;"
+            "void main() { sk_FragColor = saturate(color) * half4(length(color.xy)); }";
+
+    SkSL::ShaderCapsPointer caps = SkSL::ShaderCapsFactory::Default();
+    SkSL::String expected;
+    {
+        SkSL::Compiler compiler(caps.get(), ModuleSharing::kPrivate);
+        auto program = compiler.convertProgram(SkSL::ProgramKind::kFragment, kSrc,
+                                               SkSL::Program::Settings());
+        REPORTER_ASSERT(r, program && compiler.toGLSL(*program, &expected));
+    }
+
+    SkSL::String results[kThreads];
+    SkTaskGroup().batch(kThreads, [&](int i) {
+        SkSL::Compiler compiler(caps.get());
+        auto program = compiler.convertProgram(SkSL::ProgramKind::kFragment, kSrc,
+                                               SkSL::Program::Settings());
+        if (program) {
+            compiler.toGLSL(*program, &results[i]);
+        }
+    });
+    for (const SkSL::String& result : results) {
+        REPORTER_ASSERT(r, result == expected);
+    }
+}
+
+DEF_TEST(SkSLModuleCacheBuiltinRedefinition, r) {
+    static constexpr int kThreads = 4;
+    // unpremul is defined by a shared module; user code must not replace it.
+    static constexpr char kRedefine[] =
+            "half4 unpremul(half4 color) { return color; }"
+            "void main() { sk_FragColor = unpremul(half4(0.5)); }";
+    static constexpr char kCall[] = "void main() { sk_FragColor = unpremul(half4(0.5)); }";
+
+    SkSL::ShaderCapsPointer caps = SkSL::ShaderCapsFactory::Default();
+    SkSL::String expected;
+    {
+        SkSL::Compiler compiler(caps.get(), ModuleSharing::kPrivate);
+        auto program = compiler.convertProgram(SkSL::ProgramKind::kFragment, kCall,
+                                               SkSL::Program::Settings());
+        REPORTER_ASSERT(r, program && compiler.toGLSL(*program, &expected));
+    }
+
+    bool rejected[kThreads] = {};
+    SkTaskGroup().batch(kThreads, [&](int i) {
+        SkSL::Compiler compiler(caps.get());
+        rejected[i] = !compiler.convertProgram(SkSL::ProgramKind::kFragment, kRedefine,
+                                               SkSL::Program::Settings()) &&
+                      compiler.errorCount() > 0;
+    });
+    for (bool wasRejected : rejected) {
+        REPORTER_ASSERT(r, wasRejected);
+    }
+
+    // The shared declaration still refers to the module's own definition.
+    SkSL::Compiler compiler(caps.get());
+    SkSL::String result;
+    auto program = compiler.convertProgram(SkSL::ProgramKind::kFragment, kCall,
+                                           SkSL::Program::Settings());
+    REPORTER_ASSERT(r, program && compiler.toGLSL(*program, &result));
+    REPORTER_ASSERT(r, result == expected);
+}
@@ -6,10 +6,15 @@
  */
 
 #include "include/core/SkSwizzle.h"
+#include "include/private/SkHalf.h"
 #include "include/private/SkImageInfoPriv.h"
+#include "include/private/SkTemplates.h"
 #include "src/codec/SkSwizzler.h"
+#include "src/core/SkConvertPixels.h"
 #include "src/core/SkOpts.h"
+#include "src/core/SkRasterPipeline.h"
 #include "tests/Test.h"
+#include "tools/ToolUtils.h"
 
 static void check_fill(skiatest::Reporter* r,
                        const SkImageInfo& imageInfo,
@@ -152,3 +157,71 @@ DEF_TEST(PublicSwizzleOpts, r) {
     SkSwapRB(&dst, &src, 1);
     REPORTER_ASSERT(r, dst == 0xFA04B0CE);
 }
+
+DEF_TEST(ConvertPixelsTo8888Opts, r) {
+    // Tall enough that SkConvertPixels() splits the conversion into bands, if DM has set up a
+    // default executor.
+    const int W = 515, H = 2049;
+
+    for (SkColorType srcCT : {kRGB_565_SkColorType,
+                              kRGBA_1010102_SkColorType,
+                              kBGRA_1010102_SkColorType,
+                              kRGBA_F16Norm_SkColorType,
+                              kRGBA_F16_SkColorType}) {
+    for (SkColorType dstCT : {kRGBA_8888_SkColorType, kBGRA_8888_SkColorType}) {
+    for (SkAlphaType at : {kPremul_SkAlphaType, kUnpremul_SkAlphaType}) {
+        SkImageInfo srcInfo = SkImageInfo::Make(W, H, srcCT, at),
+                    dstInfo = SkImageInfo::Make(W, H, dstCT, at);
+
+        SkAutoTMalloc<uint8_t> src(srcInfo.computeMinByteSize());
+        uint32_t seed = 1;
+        for (size_t i = 0; i < srcInfo.computeMinByteSize(); i++) {
+            seed = seed * 1664525 + 1013904223;
+            src[i] = seed >> 24;
+        }
+        if (at == kPremul_SkAlphaType && (srcCT == kRGBA_1010102_SkColorType ||
+                                          srcCT == kBGRA_1010102_SkColorType)) {
+            // Opaque, so that random colors are valid premul.
+            auto px = (uint32_t*)src.get();
+            for (int i = 0; i < W*H; i++) {
+                px[i] |= 0xc0000000;
+            }
+        }
+        if (srcCT == kRGBA_F16Norm_SkColorType || srcCT == kRGBA_F16_SkColorType) {
+            // Keep the halfs finite, mostly in range, and premul when they need to be.
+            auto px = (uint64_t*)src.get();
+            for (int i = 0; i < W*H; i++) {
+                float a = (px[i] & 0xffff) / 65535.0f,
+                      c = (px[i] >> 16 & 0xffff) / 65535.0f * 1.25f - 0.125f;
+                float rgb = at == kPremul_SkAlphaType ? c * a : c;
+                uint64_t h = SkFloatToHalf(rgb);
+                px[i] = h | (uint64_t)SkFloatToHalf(rgb * 0.5f) << 16
+                          | h << 32 | (uint64_t)SkFloatToHalf(a) << 48;
+            }
+        }
+
+        // The reference is the pipeline SkConvertPixels() ran before it had these fast paths.
+        // The color space and alpha type don't change, so there are no steps in between.
+        SkAutoTMalloc<uint32_t> expected(W*H), actual(W*H);
+        SkRasterPipeline_MemoryCtx srcCtx = { src.get(), W },
+                                   dstCtx = { expected.get(), W };
+        SkRasterPipeline_<256> pipeline;
+        pipeline.append_load(srcCT, &srcCtx);
+        pipeline.append_gamut_clamp_if_normalized(dstInfo);
+        pipeline.append_store(dstCT, &dstCtx);
+        pipeline.run(0,0, W,H);
+
+        REPORTER_ASSERT(r, SkConvertPixels(dstInfo, actual.get(), dstInfo.minRowBytes(),
+                                           srcInfo, src.get(), srcInfo.minRowBytes()));
+
+        int mismatches = 0;
+        for (int i = 0; i < W*H; i++) {
+            mismatches += expected[i] != actual[i];
+        }
+        REPORTER_ASSERT(r, mismatches == 0, "%s -> %s: %d mismatched pixels",
+                        ToolUtils::colortype_name(srcCT), ToolUtils::colortype_name(dstCT),
+                        mismatches);
+    }
+    }
+    }
+}
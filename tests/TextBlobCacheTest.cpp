@@ -220,7 +220,7 @@ static bool compare_bitmaps(const SkBitmap& expected, const SkBitmap& actual) {
     return true;
 }
 
-static sk_sp<SkTextBlob> make_blob() {
+static sk_sp<SkTextBlob> make_blob(SkScalar x = 0) {
     auto tf = SkTypeface::MakeFromName("Roboto2-Regular", SkFontStyle());
     SkFont font;
     font.setTypeface(tf);
@@ -235,13 +235,58 @@ static sk_sp<SkTextBlob> make_blob() {
             font.textToGlyphs(text, sizeof(text), SkTextEncoding::kUTF8, glyphs, maxGlyphLen);
 
     SkTextBlobBuilder builder;
-    const auto& runBuffer = builder.allocRun(font, glyphCount, 0, 0);
+    const auto& runBuffer = builder.allocRun(font, glyphCount, x, 0);
     for (int i = 0; i < glyphCount; i++) {
         runBuffer.glyphs[i] = glyphs[i];
     }
     return builder.make();
 }
 
+DEF_GPUTEST(TextBlobCacheContentKeys, reporter, options) {
+    GrContextOptions contentKeyOptions = options;
+    contentKeyOptions.fTextBlobCacheUsesContentKeys = true;
+    sk_sp<GrDirectContext> dContext = GrDirectContext::MakeMock(nullptr, contentKeyOptions);
+    if (!dContext) {
+        return;
+    }
+
+    const SkImageInfo info =
+            SkImageInfo::Make(kScreenDim, kScreenDim, kN32_SkColorType, kPremul_SkAlphaType);
+    auto surface = SkSurface::MakeRenderTarget(dContext.get(), SkBudgeted::kNo, info);
+    REPORTER_ASSERT(reporter, surface);
+    if (!surface) {
+        return;
+    }
+    SkCanvas* canvas = surface->getCanvas();
+    GrTextBlobCache* cache = dContext->priv().getTextBlobCache();
+    REPORTER_ASSERT(reporter, cache->usesContentKeys());
+
+    SkPaint paint;
+    sk_sp<SkTextBlob> first = make_blob();
+    canvas->drawTextBlob(first, 0, 0, paint);
+    size_t usedAfterFirst = cache->usedBytes();
+    REPORTER_ASSERT(reporter, usedAfterFirst > 0);
+
+    // A different blob with the same text reuses the cached entry.
+    sk_sp<SkTextBlob> second = make_blob();
+    REPORTER_ASSERT(reporter, first->uniqueID() != second->uniqueID());
+    canvas->drawTextBlob(second, 0, 0, paint);
+    REPORTER_ASSERT(reporter, cache->usedBytes() == usedAfterFirst);
+
+    // Destroying the blobs does not purge content keyed entries.
+    first.reset();
+    second.reset();
+    cache->purgeStaleBlobs();
+    REPORTER_ASSERT(reporter, cache->usedBytes() == usedAfterFirst);
+
+    // The same glyphs at different positions are different content.
+    canvas->drawTextBlob(make_blob(5), 0, 0, paint);
+    REPORTER_ASSERT(reporter, cache->usedBytes() > usedAfterFirst);
+
+    cache->freeAll();
+    REPORTER_ASSERT(reporter, cache->usedBytes() == 0);
+}
+
 // Turned off to pass on android and ios devices, which were running out of memory..
 #if 0
 static sk_sp<SkTextBlob> make_large_blob() {
@@ -0,0 +1,4 @@
+### Compilation failed:
+
+error: 1: duplicate definition of built-in function half4 unpremul(half4 color)
+1 error
@@ -38,6 +38,9 @@ static DEFINE_int(internalSamples, 4,
 static DEFINE_bool(disableDriverCorrectnessWorkarounds, false,
                    "Disables all GPU driver correctness workarounds");
 
+static DEFINE_bool(textBlobContentKeys, false,
+                   "Key the GPU text blob cache by text content instead of SkTextBlob identity.");
+
 static DEFINE_bool(reduceOpsTaskSplitting, false, "Improve opsTask sorting");
 static DEFINE_bool(dontReduceOpsTaskSplitting, false, "Allow more opsTask splitting");
 
@@ -103,6 +106,7 @@ void SetCtxOptionsFromCommonFlags(GrContextOptions* ctxOptions) {
     ctxOptions->fGpuPathRenderers                    = collect_gpu_path_renderers_from_flags();
     ctxOptions->fInternalMultisampleCount            = FLAGS_internalSamples;
     ctxOptions->fDisableDriverCorrectnessWorkarounds = FLAGS_disableDriverCorrectnessWorkarounds;
+    ctxOptions->fTextBlobCacheUsesContentKeys        = FLAGS_textBlobContentKeys;
 
     if (FLAGS_reduceOpsTaskSplitting) {
         SkASSERT(!FLAGS_dontReduceOpsTaskSplitting);